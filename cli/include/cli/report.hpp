@@ -0,0 +1,28 @@
+// report.hpp
+// Human and machine-readable output of a digitwin-cli run.
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "renodeInterface.h"
+#include "scenarioRunner.hpp"
+
+struct RunReport {
+  std::string mode;           // "launch", "connect" or "pool"
+  uint64_t renodeReadyNs = 0; // process start until Renode accepted commands; 0 if it never did
+  bool launched = false;      // startup holds the launched process' phases
+  renode::RenodeStartupTimings startup;
+  std::vector<ScenarioReport> scenarios;
+  uint64_t totalNs = 0;
+  int exitCode = 0;
+};
+
+// One line per scenario, plus the failing step's location and message
+void writeSummary(std::ostream &out, const RunReport &report);
+
+// A single JSON document: run timings, per-scenario and per-step results,
+// and the renodeAPI telemetry snapshot
+void writeJson(std::ostream &out, const RunReport &report);
@@ -0,0 +1,64 @@
+// scenario.hpp
+// Line-based test scenarios for digitwin-cli.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+
+// One step per line, '#' starts a comment. Durations take an us, ms or s
+// suffix (ms when omitted); integers may be hex (0x...).
+//
+//   load <file.repl|file.elf>
+//   monitor <command line>                        run with the machine selected
+//   bus <node>                                    node for mem steps (default sysbus.cpu)
+//   run <duration>
+//   wait gpio <peripheral> <pin> <rising|falling|edge|high|low> [within <duration>]
+//   wait mem <address> <width> == <value> [within <duration>]
+//   assert gpio <peripheral> <pin> <==|!=> <high|low|z>
+//   assert adc <peripheral> <channel> <op> <value>
+//   assert mem <address> <width> <op> <value>
+//   assert time <op> <duration>
+//   inject gpio <peripheral> <pin> <high|low|z>
+//   inject adc <peripheral> <channel> <value>
+//   inject mem <address> <width> <value>
+//
+// <width> is byte, word, dword or qword; <op> is ==, !=, <, <=, > or >=.
+// A wait without `within` gives up after one second of virtual time.
+// A gpio wait always runs its whole window (the edge time is still exact);
+// a mem wait stops within a millisecond of the match.
+struct ScenarioStep {
+  enum class Kind : uint8_t { Load, Monitor, Bus, Run, Wait, Assert, Inject };
+  enum class Target : uint8_t { None, Gpio, Adc, Mem, Time };
+  enum class Op : uint8_t { Eq, Ne, Lt, Le, Gt, Ge };
+  enum class Edge : uint8_t { Rising, Falling, Any, High, Low };
+
+  static constexpr uint64_t kDefaultWaitUs = 1000000;
+
+  Kind kind = Kind::Run;
+  Target target = Target::None;
+  int line = 0;
+  std::string text;      // the source line, for reports
+  std::string argument;  // file, monitor command, peripheral path or bus node
+  int index = 0;         // GPIO pin or ADC channel
+  uint64_t address = 0;
+  renode::AccessWidth width = renode::AccessWidth::AW_DWord;
+  Op op = Op::Eq;
+  Edge edge = Edge::Any;
+  double value = 0.0;       // ADC value
+  uint64_t raw = 0;         // GPIO state or memory value
+  uint64_t durationUs = 0;  // run length, wait timeout or asserted time
+};
+
+struct Scenario {
+  std::string path;
+  std::vector<ScenarioStep> steps;
+};
+
+// Parse scenario text. The error message is "path:line: problem".
+renode::Result<Scenario> parseScenario(const std::string &text, const std::string &path);
+renode::Result<Scenario> loadScenario(const std::string &path);
+
+const char *opName(ScenarioStep::Op op);
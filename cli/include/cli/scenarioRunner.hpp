@@ -0,0 +1,72 @@
+// scenarioRunner.hpp
+// Executes a Scenario against one machine and records what happened.
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "renodeInterface.h"
+#include "renodeMachine.h"
+#include "scenario.hpp"
+
+enum class Outcome : uint8_t {
+  Pass,
+  Fail,   // an assertion or wait did not hold
+  Error,  // Renode or the scenario could not be executed
+};
+
+const char *outcomeName(Outcome outcome);
+
+struct StepReport {
+  int line = 0;
+  std::string text;
+  Outcome outcome = Outcome::Pass;
+  uint64_t wallNs = 0;
+  uint64_t simTimeUs = 0;  // virtual time after the step
+  std::string message;
+};
+
+// Timings are wall-clock nanoseconds
+struct ScenarioReport {
+  std::string path;
+  std::string machine;
+  Outcome outcome = Outcome::Pass;
+  std::string message;     // first failure or error
+  uint64_t setupNs = 0;    // machine creation and platform/firmware load
+  uint64_t firstRunNs = 0; // process start to the first run or wait (0: none)
+  uint64_t stepsNs = 0;
+  uint64_t teardownNs = 0;
+  std::string loadCache;   // "hit", "miss" or empty when not used
+  std::vector<StepReport> steps;
+};
+
+// Steps run in order and stop at the first failure or error. Peripheral
+// handles are resolved on first use and kept for the whole scenario.
+class ScenarioRunner {
+public:
+  ScenarioRunner(std::shared_ptr<renode::AMachine> machine, renode::ExternalControlClient &client,
+                 uint64_t processStartNs);
+
+  void run(const Scenario &scenario, ScenarioReport &report);
+
+private:
+  Outcome runStep(const ScenarioStep &step, ScenarioReport &report, std::string &message);
+  Outcome wait(const ScenarioStep &step, std::string &message);
+  Outcome check(const ScenarioStep &step, std::string &message);
+  Outcome inject(const ScenarioStep &step, std::string &message);
+
+  std::shared_ptr<renode::Gpio> gpio(const std::string &path, renode::Error &err);
+  std::shared_ptr<renode::Adc> adc(const std::string &path, renode::Error &err);
+  std::shared_ptr<renode::BusContext> bus(renode::Error &err);
+
+  std::shared_ptr<renode::AMachine> m_machine;
+  renode::ExternalControlClient &m_client;
+  uint64_t m_processStartNs;
+  std::string m_busNode = "sysbus.cpu";
+  std::map<std::string, std::shared_ptr<renode::Gpio>> m_gpios;
+  std::map<std::string, std::shared_ptr<renode::Adc>> m_adcs;
+  std::shared_ptr<renode::BusContext> m_bus;
+};
@@ -0,0 +1,349 @@
+// main.cpp
+// digitwin-cli: run scenario files against Renode without the GUI.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "renodeInterface.h"
+#include "renodeLoadCache.h"
+#include "renodeMachine.h"
+#include "renodePool.h"
+#include "renodeServer.h"
+#include "renodeTelemetry.h"
+#include "report.hpp"
+#include "scenario.hpp"
+#include "scenarioRunner.hpp"
+
+using namespace renode;
+
+namespace {
+
+enum ExitCode {
+  kExitPass = 0,
+  kExitFail = 1,   // a wait or assertion did not hold
+  kExitUsage = 2,  // bad options or scenario syntax
+  kExitError = 3,  // Renode could not be started, reached or driven
+};
+
+constexpr const char *kUsage =
+    "Usage: digitwin-cli [options] <scenario>...\n"
+    "\n"
+    "Renode:\n"
+    "  --renode <path>         executable to launch (default $RENODE_PATH, else \"renode\")\n"
+    "  --port <n>              control port of a launched Renode (default 5555; pool: first port)\n"
+    "  --connect <host:port>   use a running Renode; monitor on port + 1 unless host:port/monitor\n"
+    "  --jobs <n>              run scenarios in parallel on a pool of n launched instances\n"
+    "  --startup-timeout <ms>  how long a launch may take (default 10000)\n"
+    "\n"
+    "Machine (created for each scenario, removed after it):\n"
+    "  --machine <name>        machine name (default \"cli\")\n"
+    "  --platform <file.repl>  load before the steps; repeatable, in order with --elf\n"
+    "  --elf <file.elf>        load before the steps; repeatable\n"
+    "  --load-cache            restore --platform/--elf from the content-addressed snapshot cache\n"
+    "\n"
+    "Output:\n"
+    "  --json <file|->         write a JSON report with per-step timings\n"
+    "  -q, --quiet             no summary on stderr\n"
+    "\n"
+    "Exit status: 0 all scenarios passed, 1 a step failed, 2 usage or scenario\n"
+    "syntax error, 3 Renode error.\n";
+
+struct Options {
+  std::string renodePath;
+  uint16_t port = 5555;
+  bool portSet = false;
+  std::string connectHost;
+  uint16_t connectPort = 0;
+  uint16_t connectMonitorPort = 0;
+  size_t jobs = 1;
+  int startupTimeoutMs = 10000;
+  std::string machine = "cli";
+  std::vector<std::string> loadFiles;
+  bool loadCache = false;
+  std::string jsonPath;
+  bool quiet = false;
+  std::vector<std::string> scenarios;
+};
+
+bool parsePort(const std::string &text, uint16_t &out) {
+  char *end = nullptr;
+  unsigned long value = std::strtoul(text.c_str(), &end, 10);
+  if (text.empty() || *end != '\0' || value == 0 || value > 65535) return false;
+  out = static_cast<uint16_t>(value);
+  return true;
+}
+
+// Returns an error message, empty on success
+std::string parseOptions(int argc, char **argv, Options &options, bool &help) {
+  const char *env = std::getenv("RENODE_PATH");
+  options.renodePath = env && *env ? env : "renode";
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&](std::string &out) {
+      if (i + 1 >= argc) return false;
+      out = argv[++i];
+      return true;
+    };
+    std::string v;
+    if (arg == "-h" || arg == "--help") {
+      help = true;
+    } else if (arg == "-q" || arg == "--quiet") {
+      options.quiet = true;
+    } else if (arg == "--load-cache") {
+      options.loadCache = true;
+    } else if (arg == "--renode") {
+      if (!value(options.renodePath)) return "--renode needs a path";
+    } else if (arg == "--port") {
+      if (!value(v) || !parsePort(v, options.port)) return "--port needs a port number";
+      options.portSet = true;
+    } else if (arg == "--connect") {
+      if (!value(v)) return "--connect needs host:port";
+      std::string monitor;
+      size_t slash = v.find('/');
+      if (slash != std::string::npos) {
+        monitor = v.substr(slash + 1);
+        v.resize(slash);
+      }
+      size_t colon = v.rfind(':');
+      if (colon == std::string::npos || colon == 0 || !parsePort(v.substr(colon + 1), options.connectPort)) {
+        return "--connect needs host:port";
+      }
+      options.connectHost = v.substr(0, colon);
+      if (monitor.empty()) {
+        if (options.connectPort == 65535) return "--connect: no room for the monitor port";
+        options.connectMonitorPort = static_cast<uint16_t>(options.connectPort + 1);
+      } else if (!parsePort(monitor, options.connectMonitorPort)) {
+        return "--connect: bad monitor port";
+      }
+    } else if (arg == "--jobs") {
+      if (!value(v)) return "--jobs needs a count";
+      options.jobs = std::strtoul(v.c_str(), nullptr, 10);
+      if (options.jobs < 1 || options.jobs > 64) return "--jobs must be 1..64";
+    } else if (arg == "--startup-timeout") {
+      if (!value(v)) return "--startup-timeout needs milliseconds";
+      options.startupTimeoutMs = std::atoi(v.c_str());
+      if (options.startupTimeoutMs <= 0) return "--startup-timeout must be positive";
+    } else if (arg == "--machine") {
+      if (!value(options.machine) || options.machine.empty()) return "--machine needs a name";
+    } else if (arg == "--platform" || arg == "--elf") {
+      if (!value(v)) return arg + " needs a file";
+      options.loadFiles.push_back(v);
+    } else if (arg == "--json") {
+      if (!value(options.jsonPath)) return "--json needs a file or -";
+    } else if (!arg.empty() && arg[0] == '-') {
+      return "unknown option " + arg;
+    } else {
+      options.scenarios.push_back(arg);
+    }
+  }
+  if (!help && options.scenarios.empty()) return "no scenario given";
+  if (!options.connectHost.empty() && options.jobs > 1) return "--jobs launches its own instances; drop --connect";
+  return {};
+}
+
+RenodeConfig launchConfig(const Options &options) {
+  RenodeConfig config;
+  config.renode_path = options.renodePath;
+  config.port = options.port;
+  config.monitor_port = static_cast<uint16_t>(options.port + 1);
+  config.disable_gui = true;
+  config.start_control_server = true;  // no .resc needed
+  config.startup_timeout_ms = options.startupTimeoutMs;
+  if (!options.connectHost.empty()) {
+    config.host = options.connectHost;
+    config.port = options.connectPort;
+    config.monitor_port = options.connectMonitorPort;
+  }
+  return config;
+}
+
+// Same dispatch as AMachine::loadConfiguration, as one pipelined batch
+std::vector<std::string> loadCommands(const std::vector<std::string> &files) {
+  std::vector<std::string> commands;
+  for (const std::string &file : files) commands.push_back(AMachine::loadCommand(file));
+  return commands;
+}
+
+// Finish setup (cache restore), run the steps and tear the machine down.
+// `machine` and `err` are the result of creating it, started at setupStartNs.
+void runOne(ExternalControlClient &client, std::shared_ptr<AMachine> machine, Error err, uint64_t setupStartNs,
+            const std::function<Error()> &teardown, const Options &options, const Scenario &scenario,
+            LoadCache *cache, uint64_t processStartNs, ScenarioReport &report) {
+  report.path = scenario.path;
+  report.machine = options.machine;
+  if (machine && !err && cache && !options.loadFiles.empty()) {
+    auto loaded = cache->load(*machine, options.loadFiles);
+    err = loaded.error;
+    report.loadCache = loaded.error ? "" : loaded.value ? "hit" : "miss";
+  }
+  report.setupNs = Telemetry::nowNs() - setupStartNs;
+
+  if (!machine || err) {
+    report.outcome = Outcome::Error;
+    report.message = scenario.path + ": setup failed: " + err.message;
+  } else {
+    ScenarioRunner(std::move(machine), client, processStartNs).run(scenario, report);
+  }
+
+  uint64_t teardownStartNs = Telemetry::nowNs();
+  if (Error removed = teardown(); removed && report.outcome == Outcome::Pass) {
+    report.outcome = Outcome::Error;
+    report.message = scenario.path + ": teardown failed: " + removed.message;
+  }
+  report.teardownNs = Telemetry::nowNs() - teardownStartNs;
+}
+
+// One Renode (launched or attached), scenarios one after another
+bool runSequential(const Options &options, const std::vector<Scenario> &scenarios, uint64_t processStartNs,
+                   RunReport &run) {
+  RenodeServerConfig config;
+  config.renode = launchConfig(options);
+  config.attach = !options.connectHost.empty();
+  run.mode = config.attach ? "connect" : "launch";
+
+  Error err;
+  auto server = RenodeServer::start(config, err);
+  if (!server) {
+    std::cerr << "digitwin-cli: " << err.message << "\n";
+    return false;
+  }
+  run.renodeReadyNs = Telemetry::nowNs() - processStartNs;
+  if (const RenodeProcess *process = server->client()->process()) {
+    run.launched = true;
+    run.startup = process->startupTimings();
+  }
+
+  std::unique_ptr<LoadCache> cache = options.loadCache ? std::make_unique<LoadCache>() : nullptr;
+  std::vector<std::string> setup = cache ? std::vector<std::string>{} : loadCommands(options.loadFiles);
+  for (const Scenario &scenario : scenarios) {
+    uint64_t setupStartNs = Telemetry::nowNs();
+    auto session = server->beginSession(options.machine, setup, err);
+    run.scenarios.emplace_back();
+    runOne(*server->client(), session.machine(), err, setupStartNs, [&] { return session ? session.end() : Error{}; },
+           options, scenario, cache.get(), processStartNs, run.scenarios.back());
+  }
+  return true;
+}
+
+// Scenarios spread over a warm pool of launched instances
+bool runPooled(const Options &options, const std::vector<Scenario> &scenarios, uint64_t processStartNs,
+               RunReport &run) {
+  run.mode = "pool";
+  RenodePoolConfig config;
+  config.base = launchConfig(options);
+  config.size = std::min(options.jobs, scenarios.size());
+  config.base_port = options.portSet ? options.port : config.base_port;
+  auto pool = RenodePool::create(config);
+
+  std::unique_ptr<LoadCache> cache = options.loadCache ? std::make_unique<LoadCache>() : nullptr;
+  std::vector<std::string> setup = cache ? std::vector<std::string>{} : loadCommands(options.loadFiles);
+  run.scenarios.resize(scenarios.size());
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::once_flag ready;
+  std::mutex errMtx;
+  std::string firstError;
+
+  auto worker = [&] {
+    while (!failed) {
+      size_t i = next.fetch_add(1);
+      if (i >= scenarios.size()) return;
+      Error err;
+      auto lease = pool->acquire(std::chrono::milliseconds(options.startupTimeoutMs * 2), err);
+      if (!lease) {
+        std::lock_guard<std::mutex> lk(errMtx);
+        if (firstError.empty()) firstError = err.message;
+        failed = true;
+        return;
+      }
+      std::call_once(ready, [&] { run.renodeReadyNs = Telemetry::nowNs() - processStartNs; });
+
+      // Same teardown as a RenodeServer session; releasing the lease scrubs the rest
+      ExternalControlClient &client = *lease.client();
+      uint64_t setupStartNs = Telemetry::nowNs();
+      auto machine = client.createMachine(options.machine, setup, err);
+      runOne(client, machine, err, setupStartNs, [&] {
+        machine.reset();
+        if (Monitor *monitor = client.getMonitor()) monitor->pause();
+        return client.removeMachine(options.machine);
+      }, options, scenarios[i], cache.get(), processStartNs, run.scenarios[i]);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t j = 0; j < config.size; ++j) workers.emplace_back(worker);
+  for (auto &t : workers) t.join();
+
+  if (!failed) return true;
+  std::cerr << "digitwin-cli: " << firstError << "\n";
+  for (size_t i = 0; i < scenarios.size(); ++i) {
+    ScenarioReport &report = run.scenarios[i];
+    if (!report.path.empty()) continue;  // ran before the pool failed
+    report.path = scenarios[i].path;
+    report.machine = options.machine;
+    report.outcome = Outcome::Error;
+    report.message = scenarios[i].path + ": not run: " + firstError;
+  }
+  return false;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  uint64_t processStartNs = Telemetry::nowNs();
+
+  Options options;
+  bool help = false;
+  std::string problem = parseOptions(argc, argv, options, help);
+  if (help) {
+    std::cout << kUsage;
+    return kExitPass;
+  }
+  if (!problem.empty()) {
+    std::cerr << "digitwin-cli: " << problem << "\n\n" << kUsage;
+    return kExitUsage;
+  }
+
+  // Reject syntax errors before anything is launched
+  std::vector<Scenario> scenarios;
+  for (const std::string &path : options.scenarios) {
+    auto loaded = loadScenario(path);
+    if (loaded.error) {
+      std::cerr << loaded.error.message << "\n";
+      return kExitUsage;
+    }
+    scenarios.push_back(std::move(loaded.value));
+  }
+
+  RunReport run;
+  bool started = options.jobs > 1 ? runPooled(options, scenarios, processStartNs, run)
+                                  : runSequential(options, scenarios, processStartNs, run);
+
+  run.exitCode = started ? kExitPass : kExitError;
+  for (const ScenarioReport &scenario : run.scenarios) {
+    if (scenario.outcome == Outcome::Error) run.exitCode = kExitError;
+    if (scenario.outcome == Outcome::Fail && run.exitCode == kExitPass) run.exitCode = kExitFail;
+  }
+  run.totalNs = Telemetry::nowNs() - processStartNs;
+
+  if (!options.quiet) writeSummary(std::cerr, run);
+  if (options.jsonPath == "-") {
+    writeJson(std::cout, run);
+  } else if (!options.jsonPath.empty()) {
+    std::ofstream json(options.jsonPath);
+    writeJson(json, run);
+    if (!json) {
+      std::cerr << "digitwin-cli: cannot write " << options.jsonPath << "\n";
+      if (run.exitCode == kExitPass) run.exitCode = kExitError;
+    }
+  }
+  return run.exitCode;
+}
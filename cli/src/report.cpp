@@ -0,0 +1,99 @@
+// report.cpp
+#include "report.hpp"
+
+#include <cstdio>
+#include <iomanip>
+
+#include "renodeTelemetry.h"
+
+using namespace renode;
+
+namespace {
+
+std::string quoted(const std::string &text) {
+  std::string out = "\"";
+  for (char c : text) {
+    switch (c) {
+    case '"': out += "\\\""; break;
+    case '\\': out += "\\\\"; break;
+    case '\n': out += "\\n"; break;
+    case '\r': out += "\\r"; break;
+    case '\t': out += "\\t"; break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+  }
+  return out + "\"";
+}
+
+double ms(uint64_t ns) {
+  return static_cast<double>(ns) / 1e6;
+}
+
+} // namespace
+
+void writeSummary(std::ostream &out, const RunReport &report) {
+  auto flags = out.flags();
+  out << std::fixed << std::setprecision(1);
+  for (const ScenarioReport &scenario : report.scenarios) {
+    const char *label = scenario.outcome == Outcome::Pass ? "PASS " : scenario.outcome == Outcome::Fail ? "FAIL " : "ERROR";
+    out << label << " " << scenario.path << " (" << scenario.steps.size() << " steps, setup "
+        << ms(scenario.setupNs) << " ms, steps " << ms(scenario.stepsNs) << " ms";
+    if (!scenario.loadCache.empty()) out << ", load cache " << scenario.loadCache;
+    out << ")\n";
+    if (!scenario.message.empty()) out << "      " << scenario.message << "\n";
+  }
+  out << report.scenarios.size() << " scenario(s), ";
+  if (report.renodeReadyNs) {
+    out << "Renode ready after " << ms(report.renodeReadyNs) << " ms, ";
+  } else {
+    out << "Renode not ready, ";
+  }
+  out << "total " << ms(report.totalNs) << " ms\n";
+  out.flags(flags);
+}
+
+void writeJson(std::ostream &out, const RunReport &report) {
+  out << "{\n";
+  out << "  \"exitCode\": " << report.exitCode << ",\n";
+  out << "  \"mode\": " << quoted(report.mode) << ",\n";
+  out << "  \"totalNs\": " << report.totalNs << ",\n";
+  out << "  \"renodeReadyNs\": " << report.renodeReadyNs << ",\n";
+  if (report.launched) {
+    const RenodeStartupTimings &t = report.startup;
+    out << "  \"renodeStartup\": {\"spawnNs\": " << t.spawnNs << ", \"firstOutputNs\": " << t.firstOutputNs
+        << ", \"monitorReadyNs\": " << t.monitorReadyNs << ", \"serverStartNs\": " << t.serverStartNs
+        << ", \"controlReadyNs\": " << t.controlReadyNs << ", \"totalNs\": " << t.totalNs << "},\n";
+  }
+  out << "  \"scenarios\": [";
+  for (size_t i = 0; i < report.scenarios.size(); ++i) {
+    const ScenarioReport &s = report.scenarios[i];
+    out << (i ? ",\n" : "\n") << "    {\n";
+    out << "      \"path\": " << quoted(s.path) << ",\n";
+    out << "      \"machine\": " << quoted(s.machine) << ",\n";
+    out << "      \"result\": " << quoted(outcomeName(s.outcome)) << ",\n";
+    out << "      \"message\": " << quoted(s.message) << ",\n";
+    out << "      \"setupNs\": " << s.setupNs << ",\n";
+    out << "      \"firstRunNs\": " << s.firstRunNs << ",\n";
+    out << "      \"stepsNs\": " << s.stepsNs << ",\n";
+    out << "      \"teardownNs\": " << s.teardownNs << ",\n";
+    if (!s.loadCache.empty()) out << "      \"loadCache\": " << quoted(s.loadCache) << ",\n";
+    out << "      \"steps\": [";
+    for (size_t j = 0; j < s.steps.size(); ++j) {
+      const StepReport &step = s.steps[j];
+      out << (j ? ",\n" : "\n") << "        {\"line\": " << step.line << ", \"step\": " << quoted(step.text)
+          << ", \"result\": " << quoted(outcomeName(step.outcome)) << ", \"wallNs\": " << step.wallNs
+          << ", \"simTimeUs\": " << step.simTimeUs << ", \"message\": " << quoted(step.message) << "}";
+    }
+    out << (s.steps.empty() ? "]\n" : "\n      ]\n") << "    }";
+  }
+  out << (report.scenarios.empty() ? "],\n" : "\n  ],\n");
+  out << "  \"telemetry\": " << Telemetry::instance().snapshot().toJson() << "\n";
+  out << "}\n";
+}
@@ -0,0 +1,268 @@
+// scenario.cpp
+#include "scenario.hpp"
+
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+using namespace renode;
+
+namespace {
+
+bool parseInteger(const std::string &token, uint64_t &out) {
+  if (token.empty() || token[0] == '-') return false;
+  char *end = nullptr;
+  errno = 0;
+  out = std::strtoull(token.c_str(), &end, 0);
+  return errno == 0 && end && *end == '\0';
+}
+
+bool parseReal(const std::string &token, double &out) {
+  if (token.empty()) return false;
+  char *end = nullptr;
+  errno = 0;
+  out = std::strtod(token.c_str(), &end);
+  return errno == 0 && end && *end == '\0';
+}
+
+bool parseDuration(const std::string &token, uint64_t &us) {
+  size_t digits = token.find_first_not_of("0123456789.");
+  std::string number = token.substr(0, digits);
+  std::string unit = digits == std::string::npos ? "ms" : token.substr(digits);
+  double value = 0.0;
+  if (!parseReal(number, value) || value < 0.0) return false;
+  double scale = unit == "us" ? 1.0 : unit == "ms" ? 1e3 : unit == "s" ? 1e6 : 0.0;
+  if (scale == 0.0) return false;
+  us = static_cast<uint64_t>(value * scale + 0.5);
+  return true;
+}
+
+bool parseWidth(const std::string &token, AccessWidth &out) {
+  if (token == "byte") out = AccessWidth::AW_BYTE;
+  else if (token == "word") out = AccessWidth::AW_WORD;
+  else if (token == "dword") out = AccessWidth::AW_DWord;
+  else if (token == "qword") out = AccessWidth::AW_QWord;
+  else return false;
+  return true;
+}
+
+bool parseOp(const std::string &token, ScenarioStep::Op &out) {
+  using Op = ScenarioStep::Op;
+  if (token == "==") out = Op::Eq;
+  else if (token == "!=") out = Op::Ne;
+  else if (token == "<") out = Op::Lt;
+  else if (token == "<=") out = Op::Le;
+  else if (token == ">") out = Op::Gt;
+  else if (token == ">=") out = Op::Ge;
+  else return false;
+  return true;
+}
+
+bool parseLevel(const std::string &token, uint64_t &out) {
+  if (token == "low" || token == "0") out = static_cast<uint64_t>(GpioState::Low);
+  else if (token == "high" || token == "1") out = static_cast<uint64_t>(GpioState::High);
+  else if (token == "z" || token == "highz") out = static_cast<uint64_t>(GpioState::HighZ);
+  else return false;
+  return true;
+}
+
+bool parseEdge(const std::string &token, ScenarioStep::Edge &out) {
+  using Edge = ScenarioStep::Edge;
+  if (token == "rising") out = Edge::Rising;
+  else if (token == "falling") out = Edge::Falling;
+  else if (token == "edge") out = Edge::Any;
+  else if (token == "high") out = Edge::High;
+  else if (token == "low") out = Edge::Low;
+  else return false;
+  return true;
+}
+
+bool parseIndex(const std::string &token, int &out) {
+  uint64_t value = 0;
+  if (!parseInteger(token, value) || value > 4096) return false;
+  out = static_cast<int>(value);
+  return true;
+}
+
+ScenarioStep::Target parseTarget(const std::string &token) {
+  using Target = ScenarioStep::Target;
+  if (token == "gpio") return Target::Gpio;
+  if (token == "adc") return Target::Adc;
+  if (token == "mem") return Target::Mem;
+  if (token == "time") return Target::Time;
+  return Target::None;
+}
+
+// Fills `step` from the tokens after the keyword; returns an error message
+std::string parseStep(const std::string &keyword, const std::vector<std::string> &args,
+                      const std::string &rest, ScenarioStep &step) {
+  using Kind = ScenarioStep::Kind;
+  using Target = ScenarioStep::Target;
+  auto count = [&](size_t n) { return args.size() == n; };
+
+  if (keyword == "load") {
+    step.kind = Kind::Load;
+    if (!count(1)) return "expected: load <file>";
+    step.argument = args[0];
+    return {};
+  }
+  if (keyword == "monitor") {
+    step.kind = Kind::Monitor;
+    if (rest.empty()) return "expected: monitor <command>";
+    step.argument = rest;
+    return {};
+  }
+  if (keyword == "bus") {
+    step.kind = Kind::Bus;
+    if (!count(1)) return "expected: bus <node>";
+    step.argument = args[0];
+    return {};
+  }
+  if (keyword == "run") {
+    step.kind = Kind::Run;
+    if (!count(1) || !parseDuration(args[0], step.durationUs)) return "expected: run <duration>";
+    return {};
+  }
+
+  if (keyword == "wait") step.kind = Kind::Wait;
+  else if (keyword == "assert") step.kind = Kind::Assert;
+  else if (keyword == "inject") step.kind = Kind::Inject;
+  else return "unknown step '" + keyword + "'";
+
+  step.target = args.empty() ? Target::None : parseTarget(args[0]);
+  std::vector<std::string> a(args.begin() + (args.empty() ? 0 : 1), args.end());
+
+  if (step.kind == Kind::Wait) {
+    step.durationUs = ScenarioStep::kDefaultWaitUs;
+    if (a.size() >= 2 && a[a.size() - 2] == "within") {
+      if (!parseDuration(a.back(), step.durationUs) || step.durationUs == 0) return "bad duration after 'within'";
+      a.resize(a.size() - 2);
+    }
+    if (step.target == Target::Gpio) {
+      step.argument = a.size() == 3 ? a[0] : "";
+      if (a.size() != 3 || !parseIndex(a[1], step.index) || !parseEdge(a[2], step.edge)) {
+        return "expected: wait gpio <peripheral> <pin> <rising|falling|edge|high|low> [within <duration>]";
+      }
+      return {};
+    }
+    if (step.target == Target::Mem) {
+      if (a.size() != 4 || !parseInteger(a[0], step.address) || !parseWidth(a[1], step.width) || a[2] != "==" ||
+          !parseInteger(a[3], step.raw)) {
+        return "expected: wait mem <address> <width> == <value> [within <duration>]";
+      }
+      return {};
+    }
+    return "wait needs gpio or mem";
+  }
+
+  if (step.kind == Kind::Assert) {
+    switch (step.target) {
+    case Target::Gpio:
+      if (a.size() != 4 || !parseIndex(a[1], step.index) || !parseOp(a[2], step.op) ||
+          (step.op != ScenarioStep::Op::Eq && step.op != ScenarioStep::Op::Ne) || !parseLevel(a[3], step.raw)) {
+        return "expected: assert gpio <peripheral> <pin> <==|!=> <high|low|z>";
+      }
+      step.argument = a[0];
+      return {};
+    case Target::Adc:
+      if (a.size() != 4 || !parseIndex(a[1], step.index) || !parseOp(a[2], step.op) || !parseReal(a[3], step.value)) {
+        return "expected: assert adc <peripheral> <channel> <op> <value>";
+      }
+      step.argument = a[0];
+      return {};
+    case Target::Mem:
+      if (a.size() != 4 || !parseInteger(a[0], step.address) || !parseWidth(a[1], step.width) ||
+          !parseOp(a[2], step.op) || !parseInteger(a[3], step.raw)) {
+        return "expected: assert mem <address> <width> <op> <value>";
+      }
+      return {};
+    case Target::Time:
+      if (a.size() != 2 || !parseOp(a[0], step.op) || !parseDuration(a[1], step.durationUs)) {
+        return "expected: assert time <op> <duration>";
+      }
+      return {};
+    default:
+      return "assert needs gpio, adc, mem or time";
+    }
+  }
+
+  switch (step.target) {
+  case Target::Gpio:
+    if (a.size() != 3 || !parseIndex(a[1], step.index) || !parseLevel(a[2], step.raw)) {
+      return "expected: inject gpio <peripheral> <pin> <high|low|z>";
+    }
+    step.argument = a[0];
+    return {};
+  case Target::Adc:
+    if (a.size() != 3 || !parseIndex(a[1], step.index) || !parseReal(a[2], step.value)) {
+      return "expected: inject adc <peripheral> <channel> <value>";
+    }
+    step.argument = a[0];
+    return {};
+  case Target::Mem:
+    if (a.size() != 3 || !parseInteger(a[0], step.address) || !parseWidth(a[1], step.width) ||
+        !parseInteger(a[2], step.raw)) {
+      return "expected: inject mem <address> <width> <value>";
+    }
+    return {};
+  default:
+    return "inject needs gpio, adc or mem";
+  }
+}
+
+} // namespace
+
+Result<Scenario> parseScenario(const std::string &text, const std::string &path) {
+  Scenario scenario;
+  scenario.path = path;
+  std::istringstream in(text);
+  std::string line;
+  int lineNo = 0;
+  while (std::getline(in, line)) {
+    ++lineNo;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    std::string code = line.substr(0, line.find('#'));
+
+    std::istringstream words(code);
+    std::string keyword;
+    if (!(words >> keyword)) continue;
+    std::vector<std::string> args;
+    for (std::string word; words >> word;) args.push_back(word);
+    // Verbatim remainder, for monitor commands
+    size_t restStart = code.find_first_not_of(" \t", code.find(keyword) + keyword.size());
+    std::string rest = restStart == std::string::npos ? "" : code.substr(restStart);
+    while (!rest.empty() && (rest.back() == ' ' || rest.back() == '\t')) rest.pop_back();
+
+    ScenarioStep step;
+    step.line = lineNo;
+    size_t first = line.find_first_not_of(" \t");
+    step.text = code.substr(first, code.find_last_not_of(" \t") - first + 1);
+    std::string problem = parseStep(keyword, args, rest, step);
+    if (!problem.empty()) {
+      return {{}, {1, path + ":" + std::to_string(lineNo) + ": " + problem}};
+    }
+    scenario.steps.push_back(std::move(step));
+  }
+  return {std::move(scenario), {0, ""}};
+}
+
+Result<Scenario> loadScenario(const std::string &path) {
+  std::ifstream file(path);
+  if (!file) return {{}, {1, path + ": cannot open"}};
+  std::ostringstream text;
+  text << file.rdbuf();
+  return parseScenario(text.str(), path);
+}
+
+const char *opName(ScenarioStep::Op op) {
+  switch (op) {
+  case ScenarioStep::Op::Eq: return "==";
+  case ScenarioStep::Op::Ne: return "!=";
+  case ScenarioStep::Op::Lt: return "<";
+  case ScenarioStep::Op::Le: return "<=";
+  case ScenarioStep::Op::Gt: return ">";
+  case ScenarioStep::Op::Ge: return ">=";
+  }
+  return "?";
+}
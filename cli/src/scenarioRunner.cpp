@@ -0,0 +1,259 @@
+// scenarioRunner.cpp
+#include "scenarioRunner.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "renodeTelemetry.h"
+
+using namespace renode;
+
+namespace {
+
+template <typename T> bool compare(ScenarioStep::Op op, T actual, T expected) {
+  switch (op) {
+  case ScenarioStep::Op::Eq: return actual == expected;
+  case ScenarioStep::Op::Ne: return actual != expected;
+  case ScenarioStep::Op::Lt: return actual < expected;
+  case ScenarioStep::Op::Le: return actual <= expected;
+  case ScenarioStep::Op::Gt: return actual > expected;
+  case ScenarioStep::Op::Ge: return actual >= expected;
+  }
+  return false;
+}
+
+const char *levelName(uint64_t state) {
+  switch (static_cast<GpioState>(state)) {
+  case GpioState::Low: return "low";
+  case GpioState::High: return "high";
+  default: return "z";
+  }
+}
+
+std::string hex(uint64_t value) {
+  char buf[24];
+  std::snprintf(buf, sizeof(buf), "0x%llx", static_cast<unsigned long long>(value));
+  return buf;
+}
+
+} // namespace
+
+const char *outcomeName(Outcome outcome) {
+  switch (outcome) {
+  case Outcome::Pass: return "pass";
+  case Outcome::Fail: return "fail";
+  case Outcome::Error: return "error";
+  }
+  return "?";
+}
+
+ScenarioRunner::ScenarioRunner(std::shared_ptr<AMachine> machine, ExternalControlClient &client,
+                               uint64_t processStartNs)
+    : m_machine(std::move(machine)), m_client(client), m_processStartNs(processStartNs) {}
+
+void ScenarioRunner::run(const Scenario &scenario, ScenarioReport &report) {
+  uint64_t startNs = Telemetry::nowNs();
+  for (const ScenarioStep &step : scenario.steps) {
+    StepReport result;
+    result.line = step.line;
+    result.text = step.text;
+    uint64_t stepStartNs = Telemetry::nowNs();
+    result.outcome = runStep(step, report, result.message);
+    result.wallNs = Telemetry::nowNs() - stepStartNs;
+    auto now = m_machine->getTime(TimeUnit::TU_MICROSECONDS);
+    result.simTimeUs = now.error ? 0 : now.value;
+
+    Outcome outcome = result.outcome;
+    std::string message = result.message;
+    report.steps.push_back(std::move(result));
+    if (outcome != Outcome::Pass) {
+      report.outcome = outcome;
+      report.message = scenario.path + ":" + std::to_string(step.line) + ": " + message;
+      break;
+    }
+  }
+  report.stepsNs = Telemetry::nowNs() - startNs;
+}
+
+Outcome ScenarioRunner::runStep(const ScenarioStep &step, ScenarioReport &report, std::string &message) {
+  using Kind = ScenarioStep::Kind;
+  bool advancesTime = step.kind == Kind::Run || step.kind == Kind::Wait;
+  if (advancesTime && report.firstRunNs == 0) report.firstRunNs = Telemetry::nowNs() - m_processStartNs;
+
+  switch (step.kind) {
+  case Kind::Load:
+    if (Error err = m_machine->loadConfiguration(step.argument)) {
+      message = err.message;
+      return Outcome::Error;
+    }
+    return Outcome::Pass;
+
+  case Kind::Monitor: {
+    Monitor *monitor = m_client.getMonitor();
+    if (!monitor) {
+      message = "no monitor connection";
+      return Outcome::Error;
+    }
+    // Select the scenario's machine first so machine-relative commands apply to it
+    auto results = monitor->executeBatch({"mach set \"" + m_machine->name() + "\"", step.argument});
+    for (const auto &result : results) {
+      if (result.error || monitorReportedError(result.value)) {
+        message = result.error ? result.error.message : result.value;
+        return Outcome::Error;
+      }
+    }
+    message = results.back().value;
+    return Outcome::Pass;
+  }
+
+  case Kind::Bus:
+    m_busNode = step.argument;
+    m_bus.reset();
+    return Outcome::Pass;
+
+  case Kind::Run:
+    if (Error err = m_machine->runFor(step.durationUs, TimeUnit::TU_MICROSECONDS)) {
+      message = err.message;
+      return Outcome::Error;
+    }
+    return Outcome::Pass;
+
+  case Kind::Wait: return wait(step, message);
+  case Kind::Assert: return check(step, message);
+  case Kind::Inject: return inject(step, message);
+  }
+  return Outcome::Error;
+}
+
+Outcome ScenarioRunner::wait(const ScenarioStep &step, std::string &message) {
+  using Edge = ScenarioStep::Edge;
+  Error err;
+  StopCondition condition;
+  if (step.target == ScenarioStep::Target::Gpio) {
+    auto pinGpio = gpio(step.argument, err);
+    if (!pinGpio) {
+      message = err.message;
+      return Outcome::Error;
+    }
+    GpioEdge edge = GpioEdge::Any;
+    if (step.edge == Edge::High || step.edge == Edge::Low) {
+      // A level that already holds needs no edge
+      GpioState want = step.edge == Edge::High ? GpioState::High : GpioState::Low;
+      GpioState state = GpioState::Low;
+      if ((err = pinGpio->getState(step.index, state))) {
+        message = err.message;
+        return Outcome::Error;
+      }
+      if (state == want) return Outcome::Pass;
+      edge = step.edge == Edge::High ? GpioEdge::Rising : GpioEdge::Falling;
+    } else {
+      edge = step.edge == Edge::Rising ? GpioEdge::Rising : step.edge == Edge::Falling ? GpioEdge::Falling : GpioEdge::Any;
+    }
+    condition = StopCondition::onGpioEdge(pinGpio, step.index, edge);
+  } else {
+    auto memory = bus(err);
+    if (!memory) {
+      message = err.message;
+      return Outcome::Error;
+    }
+    condition = StopCondition::onMemory(memory, step.address, step.width, step.raw);
+  }
+
+  // A GPIO wait runs its whole window in one RUN_FOR and reports the edge's
+  // exact time; a memory wait is polled every millisecond and stops there
+  auto stop = m_machine->runUntil({condition}, step.durationUs);
+  if (stop.error) {
+    message = stop.error.message;
+    return Outcome::Error;
+  }
+  if (!stop.value.conditionMet) {
+    message = "timed out after " + std::to_string(step.durationUs) + " us";
+    return Outcome::Fail;
+  }
+  message = "at " + std::to_string(stop.value.triggerTimeUs) + " us";
+  return Outcome::Pass;
+}
+
+Outcome ScenarioRunner::check(const ScenarioStep &step, std::string &message) {
+  Error err;
+  switch (step.target) {
+  case ScenarioStep::Target::Gpio: {
+    auto pinGpio = gpio(step.argument, err);
+    GpioState state = GpioState::Low;
+    if (!pinGpio || (err = pinGpio->getState(step.index, state))) break;
+    if (compare(step.op, static_cast<uint64_t>(state), step.raw)) return Outcome::Pass;
+    message = step.argument + " pin " + std::to_string(step.index) + " is " + levelName(static_cast<uint64_t>(state));
+    return Outcome::Fail;
+  }
+  case ScenarioStep::Target::Adc: {
+    auto channelAdc = adc(step.argument, err);
+    AdcValue value = 0.0;
+    if (!channelAdc || (err = channelAdc->getChannelValue(step.index, value))) break;
+    if (compare(step.op, value, step.value)) return Outcome::Pass;
+    message = step.argument + " channel " + std::to_string(step.index) + " is " + std::to_string(value);
+    return Outcome::Fail;
+  }
+  case ScenarioStep::Target::Mem: {
+    auto memory = bus(err);
+    uint64_t value = 0;
+    if (!memory || (err = memory->read(step.address, step.width, value))) break;
+    if (compare(step.op, value, step.raw)) return Outcome::Pass;
+    message = hex(step.address) + " is " + hex(value);
+    return Outcome::Fail;
+  }
+  case ScenarioStep::Target::Time: {
+    auto now = m_machine->getTime(TimeUnit::TU_MICROSECONDS);
+    if ((err = now.error)) break;
+    if (compare(step.op, now.value, step.durationUs)) return Outcome::Pass;
+    message = "virtual time is " + std::to_string(now.value) + " us, expected " + opName(step.op) + " " +
+              std::to_string(step.durationUs) + " us";
+    return Outcome::Fail;
+  }
+  default:
+    err = {1, "unsupported assert"};
+    break;
+  }
+  message = err.message;
+  return Outcome::Error;
+}
+
+Outcome ScenarioRunner::inject(const ScenarioStep &step, std::string &message) {
+  Error err;
+  switch (step.target) {
+  case ScenarioStep::Target::Gpio:
+    if (auto pinGpio = gpio(step.argument, err)) err = pinGpio->setState(step.index, static_cast<GpioState>(step.raw));
+    break;
+  case ScenarioStep::Target::Adc:
+    if (auto channelAdc = adc(step.argument, err)) err = channelAdc->setChannelValue(step.index, step.value);
+    break;
+  case ScenarioStep::Target::Mem:
+    if (auto memory = bus(err)) err = memory->write(step.address, step.width, step.raw);
+    break;
+  default:
+    err = {1, "unsupported inject"};
+    break;
+  }
+  if (!err) return Outcome::Pass;
+  message = err.message;
+  return Outcome::Error;
+}
+
+std::shared_ptr<Gpio> ScenarioRunner::gpio(const std::string &path, Error &err) {
+  auto &handle = m_gpios[path];
+  if (!handle) handle = m_machine->getGpio(path, err);
+  return handle;
+}
+
+std::shared_ptr<Adc> ScenarioRunner::adc(const std::string &path, Error &err) {
+  auto &handle = m_adcs[path];
+  if (!handle) handle = m_machine->getAdc(path, err);
+  return handle;
+}
+
+std::shared_ptr<BusContext> ScenarioRunner::bus(Error &err) {
+  if (m_bus) return m_bus;
+  auto sysbus = m_machine->getSysBus("sysbus", err);
+  if (sysbus) m_bus = sysbus->getBusContext(m_busNode, err);
+  return m_bus;
+}
@@ -0,0 +1,58 @@
+// loadStepTest.cpp
+// digitwin-cli against FakeRenode: a `load` step Renode rejects in its
+// output (it has no status code) ends the scenario as an error with exit
+// status 3; the same scenario with a loadable file passes.
+#include <sys/wait.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "check.hpp"
+#include "fakeRenode.hpp"
+
+namespace {
+
+std::string readFile(const std::string &path) {
+  std::ifstream in(path);
+  std::stringstream text;
+  text << in.rdbuf();
+  return text.str();
+}
+
+// Exit status of digitwin-cli running one scenario with --json report
+int runCli(const std::string &cli, const FakeRenode &renode, const std::string &dir, const std::string &scenario,
+           const std::string &report) {
+  std::string path = dir + "/load.scenario";
+  std::ofstream(path) << scenario;
+  std::string command = "'" + cli + "' -q --connect 127.0.0.1:" + std::to_string(renode.controlPort()) + "/" +
+                        std::to_string(renode.monitorPort()) + " --json '" + report + "' '" + path + "'";
+  int status = std::system(command.c_str());
+  return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  CHECK(argc == 3);
+  const std::string cli = argv[1];
+  const std::string dir = argv[2];
+  const std::string report = dir + "/load-report.json";
+
+  FakeRenode renode;
+  renode.reply("machine LoadPlatformDescription @/missing/board.repl",
+               "Could not find file '/missing/board.repl'\r\n");
+
+  CHECK(runCli(cli, renode, dir, "load /missing/board.repl\nrun 1ms\n", report) == 3);
+  std::string json = readFile(report);
+  CHECK(json.find("\"step\": \"load /missing/board.repl\", \"result\": \"error\"") != std::string::npos);
+  CHECK(json.find("Could not find file") != std::string::npos);
+  CHECK(json.find("\"step\": \"run 1ms\"") == std::string::npos);  // stopped at the load
+
+  CHECK(runCli(cli, renode, dir, "load /boards/board.repl\nrun 1ms\n", report) == 0);
+  json = readFile(report);
+  CHECK(json.find("\"step\": \"run 1ms\", \"result\": \"pass\"") != std::string::npos);
+  return 0;
+}
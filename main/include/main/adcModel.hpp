@@ -0,0 +1,152 @@
+// adcModel.hpp
+// Sampled ADC channel history for plotting, fed once per run quantum.
+#pragma once
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QString>
+#include <QtQml/qqmlregistration.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "frameThrottle.hpp"
+#include "machineFeed.hpp"
+#include "simulationController.hpp"
+
+// Ring buffer of samples taken from all channels of one ADC at the same
+// virtual instants, plus a min/max pyramid per channel: level L summarises
+// kFanout^L consecutive samples, so any time range can be drawn from a
+// bounded number of columns without touching the raw samples. Storage grows
+// with the retained samples up to the capacity, so a large capacity costs
+// nothing until a run fills it. Appends come from the worker thread, queries
+// from the render thread.
+class AdcHistory {
+public:
+  struct Column {
+    uint64_t timeUs;  // first sample of the column
+    float min;
+    float max;
+  };
+
+  explicit AdcHistory(size_t capacity);
+
+  // Writer side. reset() drops everything and sizes for a channel count;
+  // append() takes one value per channel, and a timestamp going backwards
+  // (machine reset) starts over.
+  void reset(int channels);
+  void append(uint64_t timeUs, const std::vector<float> &values);
+
+  int channels() const;
+  uint64_t sampleCount() const;  // retained samples
+  bool timeRange(uint64_t &firstUs, uint64_t &lastUs) const;
+  float latest(int channel) const;
+
+  // Columns covering [fromUs, toUs] (plus one sample either side, so a line
+  // reaches the edges) from the finest level giving at most maxColumns
+  void query(int channel, uint64_t fromUs, uint64_t toUs, size_t maxColumns,
+             std::vector<Column> &out) const;
+
+  // Called after each append(); cleared before the GUI side goes away
+  void setNotifier(std::function<void()> notify);
+
+private:
+  static constexpr int kFanoutShift = 3;  // kFanout = 8
+  static constexpr size_t kInitialSamples = 4096;
+
+  struct MinMax {
+    float min;
+    float max;
+  };
+  struct Channel {
+    std::vector<float> raw;
+    std::vector<std::vector<MinMax>> levels;  // level 1 first
+  };
+
+  void resetLocked(int channels);
+  void growLocked(size_t samples);
+  uint64_t oldestLocked() const { return m_count > m_capacity ? m_count - m_capacity : 0; }
+  uint64_t timeAtLocked(uint64_t index) const { return m_times[index % m_capacity]; }
+
+  mutable std::mutex m_mtx;
+  size_t m_capacity;
+  size_t m_allocated = 0;  // samples the storage holds, up to m_capacity
+  int m_levelCount;
+  std::vector<uint64_t> m_times;
+  std::vector<Channel> m_channels;
+  uint64_t m_count = 0;  // samples appended since reset
+
+  FeedNotifier m_notifier;
+};
+
+// One row per channel of the ADC at `adcPath`, sampled after every run
+// quantum into an AdcHistory. Rows carry the latest value; the history is
+// drawn by AdcScope. QML sees at most one update per display frame.
+class AdcModel : public QAbstractListModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(SimulationController *controller READ controller WRITE setController NOTIFY controllerChanged FINAL)
+  Q_PROPERTY(QString adcPath READ adcPath WRITE setAdcPath NOTIFY adcPathChanged FINAL)
+  Q_PROPERTY(int historySize READ historySize WRITE setHistorySize NOTIFY historySizeChanged FINAL)
+  Q_PROPERTY(int channelCount READ channelCount NOTIFY channelCountChanged FINAL)
+  Q_PROPERTY(double sampleCount READ sampleCount NOTIFY samplesChanged FINAL)
+  Q_PROPERTY(double firstTimeMs READ firstTimeMs NOTIFY samplesChanged FINAL)
+  Q_PROPERTY(double lastTimeMs READ lastTimeMs NOTIFY samplesChanged FINAL)
+
+public:
+  enum Roles {
+    ChannelRole = Qt::UserRole + 1,
+    ValueRole,
+  };
+  Q_ENUM(Roles)
+
+  explicit AdcModel(QObject *parent = nullptr);
+  ~AdcModel() override;
+
+  SimulationController *controller() const { return m_controller; }
+  void setController(SimulationController *controller);
+  QString adcPath() const { return m_adcPath; }
+  void setAdcPath(const QString &path);
+  int historySize() const { return m_historySize; }
+  void setHistorySize(int samples);
+
+  int channelCount() const { return m_rows; }
+  double sampleCount() const { return static_cast<double>(m_sampleCount); }
+  double firstTimeMs() const { return static_cast<double>(m_firstUs) / 1000.0; }
+  double lastTimeMs() const { return static_cast<double>(m_lastUs) / 1000.0; }
+
+  // For renderers; safe to query from the render thread
+  std::shared_ptr<const AdcHistory> history() const { return m_history; }
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+signals:
+  void controllerChanged();
+  void adcPathChanged();
+  void historySizeChanged();
+  void channelCountChanged();
+  void samplesChanged();
+
+private:
+  void rebuild();
+  void attach();
+  void detach();
+  void flush();
+
+  QPointer<SimulationController> m_controller;
+  QString m_adcPath = QStringLiteral("sysbus.adc1");
+  int m_historySize = 1 << 20;
+  std::shared_ptr<AdcHistory> m_history;
+  MachineFeedLink m_link;
+  int m_rows = 0;
+  uint64_t m_sampleCount = 0;
+  uint64_t m_firstUs = 0;
+  uint64_t m_lastUs = 0;
+  FrameThrottle m_throttle;
+};
@@ -0,0 +1,77 @@
+// adcScope.hpp
+// Oscilloscope trace of one AdcModel channel, drawn as a single scene-graph node.
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+#include <QtQml/qqmlregistration.h>
+
+#include <vector>
+
+#include "adcModel.hpp"
+
+// Shows channel `channel` over the spanMs milliseconds of virtual time ending
+// at endMs, or at the newest sample while `follow` is set. The trace is one
+// line strip built in updatePaintNode() from AdcHistory::query(), at most two
+// vertices per pixel column however many samples the span holds, so zooming
+// out over a long run costs the same as a short one.
+class AdcScope : public QQuickItem {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(AdcModel *model READ model WRITE setModel NOTIFY modelChanged FINAL)
+  Q_PROPERTY(int channel READ channel WRITE setChannel NOTIFY channelChanged FINAL)
+  Q_PROPERTY(double spanMs READ spanMs WRITE setSpanMs NOTIFY spanMsChanged FINAL)
+  Q_PROPERTY(double endMs READ endMs WRITE setEndMs NOTIFY endMsChanged FINAL)
+  Q_PROPERTY(bool follow READ follow WRITE setFollow NOTIFY followChanged FINAL)
+  Q_PROPERTY(double minValue READ minValue WRITE setMinValue NOTIFY minValueChanged FINAL)
+  Q_PROPERTY(double maxValue READ maxValue WRITE setMaxValue NOTIFY maxValueChanged FINAL)
+  Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY colorChanged FINAL)
+
+public:
+  explicit AdcScope(QQuickItem *parent = nullptr);
+
+  AdcModel *model() const { return m_model; }
+  void setModel(AdcModel *model);
+  int channel() const { return m_channel; }
+  void setChannel(int channel);
+  double spanMs() const { return m_spanMs; }
+  void setSpanMs(double ms);
+  double endMs() const { return m_endMs; }
+  void setEndMs(double ms);
+  bool follow() const { return m_follow; }
+  void setFollow(bool follow);
+  double minValue() const { return m_minValue; }
+  void setMinValue(double value);
+  double maxValue() const { return m_maxValue; }
+  void setMaxValue(double value);
+  QColor color() const { return m_color; }
+  void setColor(const QColor &color);
+
+signals:
+  void modelChanged();
+  void channelChanged();
+  void spanMsChanged();
+  void endMsChanged();
+  void followChanged();
+  void minValueChanged();
+  void maxValueChanged();
+  void colorChanged();
+
+protected:
+  QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+  void samplesChanged();
+
+  QPointer<AdcModel> m_model;
+  int m_channel = 0;
+  double m_spanMs = 1000.0;
+  double m_endMs = 0.0;
+  bool m_follow = true;
+  double m_minValue = 0.0;
+  double m_maxValue = 3.3;
+  QColor m_color = QColor(0x4c, 0xaf, 0x50);
+  std::vector<AdcHistory::Column> m_columns;  // render thread scratch
+};
@@ -0,0 +1,148 @@
+// edgeStore.hpp
+// Append-only GPIO edge capture with a virtual-time index and protocol decoding.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+#include "machineFeed.hpp"
+
+// A decoded span of a capture (one UART frame, SPI word, I2C byte...)
+struct EdgeAnnotation {
+  uint64_t startUs = 0;
+  uint64_t endUs = 0;
+  int decoder = 0;
+  std::string text;
+};
+
+// Incremental protocol decoder. Fed every edge of the store in time order,
+// plus the capture's progress so frames that end without a further edge
+// (UART stop bit) complete. Emits annotations in time order.
+class ProtocolDecoder {
+public:
+  virtual ~ProtocolDecoder() = default;
+
+  // Line levels of every store channel when the decoder is added
+  virtual void reset(const std::vector<renode::GpioState> &levels) = 0;
+  // `levels` already includes this edge
+  virtual void edge(int channel, renode::GpioState state, uint64_t timeUs,
+                    const std::vector<renode::GpioState> &levels,
+                    std::vector<EdgeAnnotation> &out) = 0;
+  virtual void advance(uint64_t /*timeUs*/, std::vector<EdgeAnnotation> & /*out*/) {}
+};
+
+// 8N1, idle-high asynchronous serial on one channel
+std::unique_ptr<ProtocolDecoder> makeUartDecoder(int channel, uint32_t baud);
+// SPI in the given mode (0-3), MSB first; miso and cs (active low) may be -1
+std::unique_ptr<ProtocolDecoder> makeSpiDecoder(int sck, int mosi, int miso, int cs, int mode);
+// I2C with START/STOP, address and ACK/NAK
+std::unique_ptr<ProtocolDecoder> makeI2cDecoder(int scl, int sda);
+
+// Per-channel edge columns in fixed-size chunks: 32-bit offsets from the
+// chunk's base time plus 2-bit states, under 4.5 bytes per edge. The chunk
+// table doubles as the time index (binary search on base times, then within
+// one chunk), and each chunk carries the accumulated High time before it, so
+// edge counts, levels and duty cycles over any interval cost O(log n) plus
+// at most one chunk scan - never a pass over the capture.
+//
+// One writer thread (begin/append/advance) and any number of readers.
+class EdgeStore {
+public:
+  // Per pixel column of a summarize() call
+  struct Column {
+    renode::GpioState level;  // at the column's start
+    uint32_t edges;           // within the column
+  };
+
+  explicit EdgeStore(int channels);
+
+  int channels() const noexcept { return m_channelCount; }
+
+  // Writer side. begin() sets a channel's level at capture start; append()
+  // ignores repeated states; advance() tells decoders how far time has got.
+  void begin(int channel, renode::GpioState state, uint64_t timeUs);
+  void append(int channel, renode::GpioState state, uint64_t timeUs);
+  void advance(uint64_t timeUs);
+  void clear();
+
+  // Capture span over all channels; false before anything was recorded
+  bool timeRange(uint64_t &firstUs, uint64_t &lastUs) const;
+  uint64_t edgeCount(int channel) const;
+  renode::GpioState levelAt(int channel, uint64_t timeUs) const;
+  uint64_t edgesBetween(int channel, uint64_t fromUs, uint64_t toUs) const;
+  uint64_t highTimeBetween(int channel, uint64_t fromUs, uint64_t toUs) const;
+  // Time of the first edge after timeUs (false if none)
+  bool nextEdge(int channel, uint64_t timeUs, uint64_t &edgeUs) const;
+  bool previousEdge(int channel, uint64_t timeUs, uint64_t &edgeUs) const;
+
+  // `columns` equal slices of [fromUs, toUs)
+  void summarize(int channel, uint64_t fromUs, uint64_t toUs, int columns,
+                 std::vector<Column> &out) const;
+
+  // Decoders see edges appended after they are added
+  int addDecoder(std::unique_ptr<ProtocolDecoder> decoder);
+  void clearDecoders();
+  int decoderCount() const;
+  // Annotations overlapping [fromUs, toUs], at most maxCount, in decoder
+  // then time order; returns how many overlap in total
+  size_t annotations(uint64_t fromUs, uint64_t toUs, size_t maxCount,
+                     std::vector<EdgeAnnotation> &out) const;
+
+  // Called after each writer call; cleared before the GUI side goes away
+  void setNotifier(std::function<void()> notify);
+
+private:
+  static constexpr uint32_t kChunkEdges = 4096;
+
+  struct Chunk {
+    uint64_t baseUs = 0;        // time of the chunk's first edge
+    uint64_t firstIndex = 0;    // channel-wide index of that edge
+    uint64_t highBeforeUs = 0;  // High time from capture start to baseUs
+    uint32_t count = 0;
+    uint32_t offsetUs[kChunkEdges];
+    uint32_t coarseUs[kChunkEdges / 64];  // every 64th offset, searched first
+    uint64_t states[kChunkEdges / 32];    // 2 bits per edge
+
+    renode::GpioState state(uint32_t i) const {
+      return static_cast<renode::GpioState>((states[i / 32] >> (2 * (i % 32))) & 3u);
+    }
+    // Edges at or before baseUs + offset
+    uint32_t upperBound(uint32_t offset) const;
+  };
+
+  struct Channel {
+    bool begun = false;
+    uint64_t startUs = 0;
+    renode::GpioState initial = renode::GpioState::Low;
+    renode::GpioState last = renode::GpioState::Low;
+    uint64_t lastUs = 0;
+    uint64_t highUs = 0;  // High time from capture start to lastUs
+    uint64_t edges = 0;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+  };
+
+  struct Decoder {
+    std::unique_ptr<ProtocolDecoder> impl;
+    std::vector<EdgeAnnotation> annotations;
+  };
+
+  // Edges at or before timeUs, and the level after the first `index` edges
+  uint64_t indexAtLocked(const Channel &ch, uint64_t timeUs) const;
+  renode::GpioState stateAfterLocked(const Channel &ch, uint64_t index) const;
+  uint64_t edgeTimeLocked(const Channel &ch, uint64_t index) const;
+  uint64_t highUpToLocked(const Channel &ch, uint64_t timeUs) const;
+
+  int m_channelCount;
+  mutable std::mutex m_mtx;
+  std::vector<Channel> m_channels;
+  std::vector<renode::GpioState> m_levels;
+  std::vector<Decoder> m_decoders;
+  uint64_t m_lastUs = 0;
+
+  FeedNotifier m_notifier;
+};
@@ -0,0 +1,146 @@
+// eventBridge.hpp
+// Lock-free hand-off of backend events to the GUI thread, drained once per frame.
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QQuickWindow>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+
+#include "frameThrottle.hpp"
+
+// Fixed-size event record. `sink` routes it to the subscriber that asked
+// for it; index, state and value mean whatever that subscriber's kind says.
+struct SimEvent {
+  enum class Kind : uint8_t {
+    GpioEdge,   // index = row, state = GpioState
+    GpioLevel,  // same, but a read-back rather than an edge
+    AdcSample,  // index = channel, value
+  };
+
+  uint32_t sink = 0;
+  Kind kind = Kind::GpioEdge;
+  uint8_t state = 0;
+  uint16_t reserved = 0;
+  int32_t index = 0;
+  uint64_t timeUs = 0;
+  double value = 0.0;
+};
+static_assert(sizeof(SimEvent) == 32, "two records per cache line");
+
+// Wait-free single-producer / single-consumer ring of trivially copyable
+// records. Each side caches the other's index and only reloads it when the
+// ring looks full (producer) or empty (consumer), so the shared cache lines
+// are touched about once per batch.
+template <typename T> class SpscRing {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  // Capacity is rounded up to a power of two
+  explicit SpscRing(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    m_mask = size - 1;
+    m_items.reset(new T[size]);
+  }
+
+  size_t capacity() const noexcept { return m_mask + 1; }
+
+  // Producer: false when full (the record is not stored)
+  bool push(const T &item) noexcept {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    if (head - m_cachedTail > m_mask) {
+      m_cachedTail = m_tail.load(std::memory_order_acquire);
+      if (head - m_cachedTail > m_mask) return false;
+    }
+    m_items[head & m_mask] = item;
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: passes up to max records to fn in order; returns the count
+  template <typename Fn> size_t drain(Fn &&fn, size_t max) noexcept {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    if (m_cachedHead == tail) m_cachedHead = m_head.load(std::memory_order_acquire);
+    size_t count = std::min(m_cachedHead - tail, max);
+    for (size_t i = 0; i < count; ++i) fn(m_items[(tail + i) & m_mask]);
+    m_tail.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+private:
+  size_t m_mask = 0;
+  std::unique_ptr<T[]> m_items;
+  alignas(64) std::atomic<size_t> m_head{0};  // next write
+  size_t m_cachedTail = 0;                    // producer's copy of m_tail
+  alignas(64) std::atomic<size_t> m_tail{0};  // next read
+  size_t m_cachedHead = 0;                    // consumer's copy of m_head
+};
+
+// Carries events from the simulation worker (the producer: the only thread
+// that issues commands, so the only one inside recv_response where Renode
+// events are dispatched) to subscribers on the GUI thread. post() never
+// blocks and never allocates: when the ring is full the event is counted as
+// dropped, and after the next drain every subscriber is told to resync.
+//
+// With a window set, the ring is drained on the GUI thread as each frame
+// starts (QQuickWindow::afterAnimating, just before the scene graph syncs)
+// and a quiet window is woken for the first event after a drain; without
+// one, it is drained by a FrameThrottle.
+class EventBridge : public QObject {
+public:
+  struct Stats {
+    uint64_t posted = 0;
+    uint64_t dropped = 0;
+    uint64_t delivered = 0;
+  };
+
+  using Handler = std::function<void(const SimEvent &)>;
+  // Called after each drain that delivered to the subscriber, or for every
+  // subscriber when events were dropped since the previous drain
+  using FrameDone = std::function<void(bool overflowed)>;
+
+  explicit EventBridge(size_t capacity = size_t(1) << 16, QObject *parent = nullptr);
+
+  // Producer side
+  bool post(const SimEvent &event) noexcept;
+
+  // GUI thread. Events still queued for a removed sink are discarded.
+  uint32_t subscribe(Handler handler, FrameDone done = {});
+  void unsubscribe(uint32_t sink);
+  void setWindow(QQuickWindow *window);
+  Stats stats() const noexcept;
+  // Called on the GUI thread after a drain that changed the stats
+  void setStatsListener(std::function<void()> listener);
+
+private:
+  void wake();
+  void drain();
+
+  struct Sink {
+    Handler handler;
+    FrameDone done;
+    bool delivered = false;
+  };
+
+  SpscRing<SimEvent> m_ring;
+  std::atomic<uint64_t> m_posted{0};
+  std::atomic<uint64_t> m_dropped{0};
+  uint64_t m_delivered = 0;
+  uint64_t m_droppedSeen = 0;
+
+  std::map<uint32_t, Sink> m_sinks;
+  uint32_t m_nextSink = 1;
+  std::function<void()> m_statsListener;
+  QPointer<QQuickWindow> m_window;
+  QMetaObject::Connection m_frameConnection;
+  FrameThrottle m_throttle;
+};
@@ -0,0 +1,180 @@
+// fleetModel.hpp
+// Live overview of every machine across several Renode instances.
+#pragma once
+
+#include <QAbstractListModel>
+#include <QCollator>
+#include <QHash>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QStringList>
+#include <QtQml/qqmlregistration.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "frameThrottle.hpp"
+
+struct FleetFeed;
+struct FleetSnapshot;
+
+// One row per machine of every Renode instance in `endpoints`:
+//   "host:port"          control port, monitor on port + 1 (RenodePool layout)
+//   "host:port/monitor"  explicit monitor port
+//   "unix:/path"         a RenodeBroker socket; it has no monitor, so the
+//                        machines must be named in `machines`
+// Each endpoint is polled from its own thread every `pollIntervalMs`: the
+// machine list (from the monitor's "mach" listing every few polls, unless
+// `machines` names them), then each machine's virtual time and the `pins`
+// ("sysbus.gpioPortA:5"). A poll publishes the whole instance; snapshots are
+// merged at most once per frame by appending new machines, removing vanished
+// ones and emitting dataChanged() only for the roles that changed, in
+// contiguous runs, so a sorted FleetProxyModel on top only moves rows whose
+// sort key moved. An endpoint with nothing to list (no connection, or no
+// monitor to discover machines with) shows as one Unreachable row named
+// after the endpoint.
+//
+// Renode's control server serves a single client: point endpoints at
+// instances nothing else drives, or at their broker.
+class FleetModel : public QAbstractListModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QStringList endpoints READ endpoints WRITE setEndpoints NOTIFY endpointsChanged FINAL)
+  Q_PROPERTY(QStringList machines READ machines WRITE setMachines NOTIFY machinesChanged FINAL)
+  Q_PROPERTY(QStringList pins READ pins WRITE setPins NOTIFY pinsChanged FINAL)
+  Q_PROPERTY(int pollIntervalMs READ pollIntervalMs WRITE setPollIntervalMs NOTIFY pollIntervalMsChanged FINAL)
+  Q_PROPERTY(int count READ count NOTIFY countsChanged FINAL)
+  Q_PROPERTY(int runningCount READ runningCount NOTIFY countsChanged FINAL)
+  Q_PROPERTY(int unreachableCount READ unreachableCount NOTIFY countsChanged FINAL)
+
+public:
+  enum MachineState {
+    Running,      // virtual time advanced since the previous poll
+    Paused,
+    Unreachable,  // instance or machine did not answer
+  };
+  Q_ENUM(MachineState)
+
+  enum Roles {
+    InstanceRole = Qt::UserRole + 1,  // endpoint string
+    NameRole,
+    StateRole,
+    SimTimeMsRole,
+    RealTimeFactorRole,
+    PinsRole,      // "PA5=1 PB0=0"
+    HighPinsRole,  // how many of `pins` are high
+    ErrorRole,
+  };
+  Q_ENUM(Roles)
+
+  explicit FleetModel(QObject *parent = nullptr);
+  ~FleetModel() override;
+
+  QStringList endpoints() const { return m_endpoints; }
+  void setEndpoints(const QStringList &endpoints);
+  QStringList machines() const { return m_machines; }
+  void setMachines(const QStringList &machines);
+  QStringList pins() const { return m_pins; }
+  void setPins(const QStringList &pins);
+  int pollIntervalMs() const { return m_pollIntervalMs; }
+  void setPollIntervalMs(int ms);
+  int count() const { return static_cast<int>(m_rows.size()); }
+  int runningCount() const { return m_running; }
+  int unreachableCount() const { return m_unreachable; }
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+signals:
+  void endpointsChanged();
+  void machinesChanged();
+  void pinsChanged();
+  void pollIntervalMsChanged();
+  void countsChanged();
+
+private:
+  struct Row {
+    int endpoint = 0;
+    QString name;
+    MachineState state = Paused;
+    uint64_t simTimeUs = 0;
+    double realTimeFactor = 0.0;
+    QString pins;
+    int highPins = 0;
+    QString error;
+  };
+
+  void rebuild();
+  void attach();
+  void detach();
+  void flush();
+  void merge(FleetSnapshot &snapshot);
+  void emitChanged(const std::vector<uint8_t> &changed);
+  void reindex();
+  static QString keyOf(int endpoint, const QString &name);
+
+  QStringList m_endpoints;
+  QStringList m_machines;
+  QStringList m_pins;
+  int m_pollIntervalMs = 500;
+
+  std::vector<Row> m_rows;
+  QHash<QString, int> m_index;  // keyOf() -> row
+  int m_running = 0;
+  int m_unreachable = 0;
+  std::shared_ptr<FleetFeed> m_feed;
+  FrameThrottle m_throttle;
+};
+
+// Sorted, filtered view of a FleetModel for large fleets. Sorting is by the
+// role named in `sortBy` (names compare numerically, "board-9" before
+// "board-10"); `filterText` matches machine or instance, and `stateFilter`
+// keeps one FleetModel::MachineState (-1: all).
+class FleetProxyModel : public QSortFilterProxyModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QString sortBy READ sortBy WRITE setSortBy NOTIFY sortByChanged FINAL)
+  Q_PROPERTY(bool descending READ descending WRITE setDescending NOTIFY descendingChanged FINAL)
+  Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged FINAL)
+  Q_PROPERTY(int stateFilter READ stateFilter WRITE setStateFilter NOTIFY stateFilterChanged FINAL)
+  Q_PROPERTY(int count READ count NOTIFY countChanged FINAL)
+
+public:
+  explicit FleetProxyModel(QObject *parent = nullptr);
+
+  QString sortBy() const { return m_sortBy; }
+  void setSortBy(const QString &role);
+  bool descending() const { return m_descending; }
+  void setDescending(bool descending);
+  QString filterText() const { return m_filterText; }
+  void setFilterText(const QString &text);
+  int stateFilter() const { return m_stateFilter; }
+  void setStateFilter(int state);
+  int count() const { return rowCount(); }
+
+  void setSourceModel(QAbstractItemModel *model) override;
+
+signals:
+  void sortByChanged();
+  void descendingChanged();
+  void filterTextChanged();
+  void stateFilterChanged();
+  void countChanged();
+
+protected:
+  bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+  bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+  void applySort();
+
+  QString m_sortBy = QStringLiteral("name");
+  bool m_descending = false;
+  QString m_filterText;
+  int m_stateFilter = -1;
+  QCollator m_collator;
+};
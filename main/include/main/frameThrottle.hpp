@@ -0,0 +1,32 @@
+// frameThrottle.hpp
+// Coalesces backend change notifications into at most one GUI update per frame.
+#pragma once
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <atomic>
+#include <functional>
+
+// Lives on the GUI thread. request() may be called from any thread, as often
+// as the backend likes: the first call after a flush schedules flush() on the
+// GUI thread no sooner than one display frame after the previous one, and
+// further calls until then cost one atomic load. flush() must read whatever
+// state the requests announced; the pending flag is cleared before it runs,
+// so changes made during a flush schedule the next one.
+class FrameThrottle : public QObject {
+public:
+  explicit FrameThrottle(std::function<void()> flush, QObject *parent = nullptr);
+
+  void request();
+
+private:
+  void schedule();
+  void fire();
+
+  std::function<void()> m_flush;
+  std::atomic<bool> m_pending{false};
+  QTimer m_timer;
+  QElapsedTimer m_sinceFlush;
+};
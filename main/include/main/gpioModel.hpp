@@ -0,0 +1,121 @@
+// gpioModel.hpp
+// List model of GPIO pin states, fed from Renode state-change events.
+#pragma once
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QStringList>
+#include <QtQml/qqmlregistration.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "machineFeed.hpp"
+#include "renodeMachine.h"
+#include "simulationController.hpp"
+
+struct GpioFeed;
+
+// Pin state written from bridge events on the GUI thread and read by the
+// model and by renderers. Lock-free: states are packed 2 bits per pin, and
+// rows changed since the last takeDirty() are tracked in a bitmap so a
+// burst of edges on one pin costs one update.
+class GpioPinTable {
+public:
+  explicit GpioPinTable(int pins);
+
+  int size() const noexcept { return m_pins; }
+  renode::GpioState state(int row) const noexcept;
+  uint32_t toggles(int row) const noexcept;
+  uint64_t lastEdgeUs(int row) const noexcept;
+
+  // Writer side. A state change counts as a toggle unless countEdge is false
+  // (read-back). Marks the row dirty.
+  void set(int row, renode::GpioState state, uint64_t timestampUs, bool countEdge) noexcept;
+
+  // Reader side: clears the bitmap and calls emitRange(first, last) for each
+  // run of consecutive dirty rows
+  void takeDirty(const std::function<void(int first, int last)> &emitRange);
+
+private:
+  static constexpr int kStatesPerWord = 16;
+
+  int m_pins;
+  std::unique_ptr<std::atomic<uint32_t>[]> m_states;
+  std::unique_ptr<std::atomic<uint32_t>[]> m_toggles;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_lastEdgeUs;
+  std::unique_ptr<std::atomic<uint64_t>[]> m_dirty;
+  size_t m_dirtyWords;
+};
+
+// One row per pin of every port in `ports`, in port order. Rows are updated
+// in place: edges arrive through the controller's EventBridge, are applied
+// to a GpioPinTable once per frame, and published as the minimal set of
+// contiguous dataChanged() ranges, so kHz toggling never reaches QML at
+// event rate. If the bridge dropped events, every pin is read back; the
+// levels travel beside the ring behind a single marker event and are written
+// to the table when the marker is drained, in order with the edges.
+class GpioModel : public QAbstractListModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(SimulationController *controller READ controller WRITE setController NOTIFY controllerChanged FINAL)
+  Q_PROPERTY(QStringList ports READ ports WRITE setPorts NOTIFY portsChanged FINAL)
+  Q_PROPERTY(int pinsPerPort READ pinsPerPort WRITE setPinsPerPort NOTIFY pinsPerPortChanged FINAL)
+
+public:
+  enum Roles {
+    PortRole = Qt::UserRole + 1,
+    PinRole,
+    LabelRole,
+    StateRole,  // 0 low, 1 high, 2 high-Z
+    TogglesRole,
+    LastEdgeUsRole,
+  };
+  Q_ENUM(Roles)
+
+  explicit GpioModel(QObject *parent = nullptr);
+  ~GpioModel() override;
+
+  SimulationController *controller() const { return m_controller; }
+  void setController(SimulationController *controller);
+  QStringList ports() const { return m_ports; }
+  void setPorts(const QStringList &ports);
+  int pinsPerPort() const { return m_pinsPerPort; }
+  void setPinsPerPort(int pins);
+
+  // For renderers; safe to query from the render thread
+  std::shared_ptr<const GpioPinTable> table() const { return m_table; }
+
+  // Drives a pin from the GUI (0 low, 1 high); the row updates through the
+  // pin's own state-change event
+  Q_INVOKABLE void setPinState(int row, int state);
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+signals:
+  void controllerChanged();
+  void portsChanged();
+  void pinsPerPortChanged();
+
+private:
+  void rebuild();
+  void attach();
+  void detach();
+  void flush(bool overflowed);
+
+  QPointer<SimulationController> m_controller;
+  QStringList m_ports;
+  int m_pinsPerPort = 16;
+  QStringList m_labels;
+  std::shared_ptr<GpioPinTable> m_table;
+  std::shared_ptr<GpioFeed> m_feed;
+  MachineFeedLink m_link;
+  uint32_t m_sink = 0;
+  bool m_readBackPending = false;  // levels requested after an overflow
+};
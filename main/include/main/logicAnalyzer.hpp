@@ -0,0 +1,95 @@
+// logicAnalyzer.hpp
+// GPIO edge capture for the logic-analyzer page.
+#pragma once
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+#include <QtQml/qqmlregistration.h>
+
+#include <memory>
+
+#include "edgeStore.hpp"
+#include "frameThrottle.hpp"
+#include "machineFeed.hpp"
+#include "simulationController.hpp"
+
+// Records every edge of the probed pins, with Renode's virtual timestamps,
+// into an EdgeStore while a machine is attached. One row per probe; probes
+// are "<gpio path>:<pin>" strings such as "sysbus.gpioPortA:9". Decoders run
+// as edges arrive, so overlays and measurements are index lookups. Changing
+// the probes starts a new capture without decoders.
+class LogicAnalyzer : public QAbstractListModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(SimulationController *controller READ controller WRITE setController NOTIFY controllerChanged FINAL)
+  Q_PROPERTY(QStringList probes READ probes WRITE setProbes NOTIFY probesChanged FINAL)
+  Q_PROPERTY(double captureStartMs READ captureStartMs NOTIFY captureChanged FINAL)
+  Q_PROPERTY(double captureEndMs READ captureEndMs NOTIFY captureChanged FINAL)
+  Q_PROPERTY(int decoderCount READ decoderCount NOTIFY decodersChanged FINAL)
+
+public:
+  enum Roles {
+    ProbeRole = Qt::UserRole + 1,
+    LevelRole,  // 0 low, 1 high, 2 high-Z
+    EdgesRole,
+  };
+  Q_ENUM(Roles)
+
+  explicit LogicAnalyzer(QObject *parent = nullptr);
+  ~LogicAnalyzer() override;
+
+  SimulationController *controller() const { return m_controller; }
+  void setController(SimulationController *controller);
+  QStringList probes() const { return m_probes; }
+  void setProbes(const QStringList &probes);
+
+  double captureStartMs() const { return static_cast<double>(m_firstUs) / 1000.0; }
+  double captureEndMs() const { return static_cast<double>(m_lastUs) / 1000.0; }
+  int decoderCount() const { return m_store->decoderCount(); }
+
+  // For renderers; safe to query from the render thread
+  std::shared_ptr<const EdgeStore> store() const { return m_store; }
+
+  // Decoders take probe rows as channels and return their overlay row
+  Q_INVOKABLE int addUartDecoder(int channel, int baud);
+  Q_INVOKABLE int addSpiDecoder(int sck, int mosi, int miso = -1, int cs = -1, int mode = 0);
+  Q_INVOKABLE int addI2cDecoder(int scl, int sda);
+  Q_INVOKABLE void clearDecoders();
+
+  // Decoded spans overlapping the range: {decoder, startMs, endMs, text}.
+  // Past maxCount the view should show density instead of labels.
+  Q_INVOKABLE QVariantList annotations(double fromMs, double toMs, int maxCount = 500) const;
+  // {edges, highMs, dutyCycle, frequencyHz} of one probe between two cursors
+  Q_INVOKABLE QVariantMap measure(int channel, double fromMs, double toMs) const;
+  // Nearest edge after / before a time for cursor snapping; -1 if none
+  Q_INVOKABLE double nextEdgeMs(int channel, double ms) const;
+  Q_INVOKABLE double previousEdgeMs(int channel, double ms) const;
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+signals:
+  void controllerChanged();
+  void probesChanged();
+  void captureChanged();
+  void decodersChanged();
+
+private:
+  void rebuild();
+  void attach();
+  void detach();
+  void flush();
+
+  QPointer<SimulationController> m_controller;
+  QStringList m_probes;
+  std::shared_ptr<EdgeStore> m_store;
+  MachineFeedLink m_link;
+  uint64_t m_firstUs = 0;
+  uint64_t m_lastUs = 0;
+  FrameThrottle m_throttle;
+};
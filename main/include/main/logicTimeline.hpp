@@ -0,0 +1,90 @@
+// logicTimeline.hpp
+// Scene-graph waveform view of a LogicAnalyzer capture.
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+#include <QtQml/qqmlregistration.h>
+
+#include <vector>
+
+#include "logicAnalyzer.hpp"
+
+// One waveform row per probe over [startMs, startMs + spanMs], or the newest
+// spanMs of the capture while `follow` is set, plus cursors A and B
+// (negative = hidden). Each frame asks the store for one summary column per
+// pixel, so the cost depends on the item's width, not on how many edges the
+// span holds: idle columns merge into one line, single edges become a step,
+// and busier columns are drawn as a solid bar.
+class LogicTimeline : public QQuickItem {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(LogicAnalyzer *analyzer READ analyzer WRITE setAnalyzer NOTIFY analyzerChanged FINAL)
+  Q_PROPERTY(double startMs READ startMs WRITE setStartMs NOTIFY startMsChanged FINAL)
+  Q_PROPERTY(double spanMs READ spanMs WRITE setSpanMs NOTIFY spanMsChanged FINAL)
+  Q_PROPERTY(bool follow READ follow WRITE setFollow NOTIFY followChanged FINAL)
+  Q_PROPERTY(double rowHeight READ rowHeight WRITE setRowHeight NOTIFY rowHeightChanged FINAL)
+  Q_PROPERTY(double cursorAMs READ cursorAMs WRITE setCursorAMs NOTIFY cursorsChanged FINAL)
+  Q_PROPERTY(double cursorBMs READ cursorBMs WRITE setCursorBMs NOTIFY cursorsChanged FINAL)
+  Q_PROPERTY(QColor traceColor READ traceColor WRITE setTraceColor NOTIFY colorsChanged FINAL)
+  Q_PROPERTY(QColor cursorColor READ cursorColor WRITE setCursorColor NOTIFY colorsChanged FINAL)
+
+public:
+  explicit LogicTimeline(QQuickItem *parent = nullptr);
+
+  LogicAnalyzer *analyzer() const { return m_analyzer; }
+  void setAnalyzer(LogicAnalyzer *analyzer);
+  double startMs() const { return m_startMs; }
+  void setStartMs(double ms);
+  double spanMs() const { return m_spanMs; }
+  void setSpanMs(double ms);
+  bool follow() const { return m_follow; }
+  void setFollow(bool follow);
+  double rowHeight() const { return m_rowHeight; }
+  void setRowHeight(double height);
+  double cursorAMs() const { return m_cursorAMs; }
+  void setCursorAMs(double ms);
+  double cursorBMs() const { return m_cursorBMs; }
+  void setCursorBMs(double ms);
+  QColor traceColor() const { return m_traceColor; }
+  void setTraceColor(const QColor &color);
+  QColor cursorColor() const { return m_cursorColor; }
+  void setCursorColor(const QColor &color);
+
+  // Mapping between item x and virtual time for overlays and input handling
+  Q_INVOKABLE double timeAt(double x) const;
+  Q_INVOKABLE double xAt(double ms) const;
+  // Zoom by factor around the time under x (factor < 1 zooms in)
+  Q_INVOKABLE void zoom(double factor, double x);
+
+signals:
+  void analyzerChanged();
+  void startMsChanged();
+  void spanMsChanged();
+  void followChanged();
+  void rowHeightChanged();
+  void cursorsChanged();
+  void colorsChanged();
+
+protected:
+  QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+
+private:
+  void captureChanged();
+
+  QPointer<LogicAnalyzer> m_analyzer;
+  double m_startMs = 0.0;
+  double m_spanMs = 10.0;
+  bool m_follow = true;
+  double m_rowHeight = 28.0;
+  double m_cursorAMs = -1.0;
+  double m_cursorBMs = -1.0;
+  QColor m_traceColor = QColor(0x4c, 0xaf, 0x50);
+  QColor m_cursorColor = QColor(0xff, 0xc1, 0x07);
+
+  // Render thread scratch
+  std::vector<EdgeStore::Column> m_columns;
+  std::vector<float> m_vertices;  // x, y pairs
+};
@@ -0,0 +1,87 @@
+// machineFeed.hpp
+// Shared plumbing for models fed from the controller's machine on the worker thread.
+#pragma once
+
+#include <QPointer>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "renodeMachine.h"
+
+class SimulationController;
+
+// Change callback installed from the GUI thread and fired by the backend.
+// notify() runs it under the lock, so once set(nullptr) has returned it is
+// never called again and whatever it captured may go away.
+class FeedNotifier {
+public:
+  void set(std::function<void()> notify);
+  void notify();
+
+private:
+  std::mutex m_mtx;
+  std::function<void()> m_notify;
+};
+
+// Display name of a GPIO pin: "sysbus.gpioPortA" pin 5 -> "PA5", other
+// ports -> last path element and pin ("sysbus.gpio0" pin 5 -> "gpio0.5")
+std::string pinLabel(const std::string &port, int pin);
+
+// Event listeners one feed holds on the attached machine (worker thread
+// only). Port handles come from a cache shared by every feed on the same
+// machine, so re-attaching after a model rebuild adds listeners to the
+// existing server-side subscriptions instead of registering the pins again.
+class GpioListeners {
+public:
+  GpioListeners() = default;
+  GpioListeners(const GpioListeners &) = delete;
+  GpioListeners &operator=(const GpioListeners &) = delete;
+  ~GpioListeners() { clear(); }
+
+  // Cached handle for the port at path, nullptr if the machine has none
+  std::shared_ptr<renode::Gpio> port(const std::shared_ptr<renode::AMachine> &machine,
+                                     const std::string &path);
+  bool listen(const std::shared_ptr<renode::Gpio> &gpio, int pin, renode::GpioEventCallback cb);
+  // Drops every listener; the port handles stay cached for the next feed
+  void clear();
+
+private:
+  std::vector<std::pair<std::shared_ptr<renode::Gpio>, int>> m_handles;
+};
+
+// GUI-thread registration of a worker-side feed with a controller. The feed
+// is detached from the previous machine and attached to each new one
+// (attach/detach), and gets the virtual time after every quantum when it
+// has advance(uint64_t). After release() the worker may still run the feed
+// until it drops it, so a feed must only write into state it shares
+// ownership of and signal through a FeedNotifier that has been cleared.
+class MachineFeedLink {
+public:
+  template <typename Feed> void observe(SimulationController *controller, std::shared_ptr<Feed> feed) {
+    std::function<void(uint64_t)> advanced;
+    if constexpr (requires(Feed &f) { f.advance(uint64_t{}); }) {
+      advanced = [feed](uint64_t simTimeUs) { feed->advance(simTimeUs); };
+    }
+    observe(controller,
+            [feed](const std::shared_ptr<renode::AMachine> &machine) {
+              feed->detach();
+              if (machine) feed->attach(machine);
+            },
+            std::move(advanced));
+  }
+  void release();
+
+private:
+  void observe(SimulationController *controller,
+               std::function<void(const std::shared_ptr<renode::AMachine> &)> machineChanged,
+               std::function<void(uint64_t)> advanced);
+
+  QPointer<SimulationController> m_controller;
+  int m_observerId = 0;
+};
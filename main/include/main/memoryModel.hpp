@@ -0,0 +1,158 @@
+// memoryModel.hpp
+// Virtualized hex view of a target address range.
+#pragma once
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QString>
+#include <QtQml/qqmlregistration.h>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "frameThrottle.hpp"
+#include "machineFeed.hpp"
+#include "simulationController.hpp"
+
+struct MemoryFeed;
+
+// LRU cache of fixed-size pages of target memory (GUI thread only). Each
+// page carries the virtual time its bytes were read at as a generation tag,
+// and which bytes differ from the read before it.
+class MemoryPageCache {
+public:
+  static constexpr int kPageShift = 12;
+  static constexpr size_t kPageSize = size_t(1) << kPageShift;
+
+  struct Page {
+    uint64_t generationUs = 0;
+    bool valid = false;            // false: the read failed, bytes are zero
+    std::vector<uint8_t> bytes;    // kPageSize
+    std::vector<uint8_t> changed;  // 1 where the byte differs from the previous read
+  };
+
+  explicit MemoryPageCache(size_t capacity);
+
+  size_t capacity() const noexcept { return m_capacity; }
+  size_t size() const noexcept { return m_pages.size(); }
+
+  // Lookup without affecting eviction order; nullptr if not cached
+  const Page *find(uint64_t page) const;
+  // Marks a page as recently used
+  void touch(uint64_t page);
+
+  // Stores a read of one page, evicting the least recently used page when
+  // full. Bytes from a later generation are diffed against the cached copy;
+  // a re-read at the same generation keeps the previous change flags.
+  void store(uint64_t page, uint64_t generationUs, const uint8_t *bytes, bool valid);
+  void clear();
+
+private:
+  struct Entry {
+    Page page;
+    std::list<uint64_t>::iterator lru;
+  };
+
+  size_t m_capacity;
+  std::unordered_map<uint64_t, Entry> m_pages;
+  std::list<uint64_t> m_lru;  // most recent first
+};
+
+// One row per 16 bytes of [baseAddress, baseAddress + size), read through a
+// BusContext of `busNode` on `busPath`. Rows are virtual: nothing is read
+// until a view shows them, so a 2 MiB flash scrolls like a short list.
+//
+// The view reports its visible rows with setVisibleRows(); missing pages
+// are read on the worker as coalesced block transfers, together with a few
+// pages ahead in the scroll direction. While the simulation runs, visible
+// pages whose generation is older than the current virtual time are read
+// again, one batch at a time, and `changed` flags the bytes that differ from
+// the previous read.
+class MemoryModel : public QAbstractListModel {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(SimulationController *controller READ controller WRITE setController NOTIFY controllerChanged FINAL)
+  Q_PROPERTY(QString busPath READ busPath WRITE setBusPath NOTIFY rangeChanged FINAL)
+  Q_PROPERTY(QString busNode READ busNode WRITE setBusNode NOTIFY rangeChanged FINAL)
+  Q_PROPERTY(qulonglong baseAddress READ baseAddress WRITE setBaseAddress NOTIFY rangeChanged FINAL)
+  Q_PROPERTY(int size READ size WRITE setSize NOTIFY rangeChanged FINAL)
+  Q_PROPERTY(QString error READ error NOTIFY errorChanged FINAL)
+
+public:
+  static constexpr int kBytesPerRow = 16;
+
+  enum Roles {
+    AddressRole = Qt::UserRole + 1,  // "08000010"
+    HexRole,
+    AsciiRole,
+    ChangedRole,  // bit i set: byte i changed since the previous read
+    LoadedRole,
+  };
+  Q_ENUM(Roles)
+
+  explicit MemoryModel(QObject *parent = nullptr);
+  ~MemoryModel() override;
+
+  SimulationController *controller() const { return m_controller; }
+  void setController(SimulationController *controller);
+  QString busPath() const { return m_busPath; }
+  void setBusPath(const QString &path);
+  QString busNode() const { return m_busNode; }
+  void setBusNode(const QString &node);
+  qulonglong baseAddress() const { return m_baseAddress; }
+  void setBaseAddress(qulonglong address);
+  int size() const { return m_size; }
+  void setSize(int bytes);
+  QString error() const { return m_error; }
+
+  // Rows currently on screen, inclusive; drives refresh and prefetch
+  Q_INVOKABLE void setVisibleRows(int first, int last);
+  Q_INVOKABLE int rowForAddress(qulonglong address) const;
+
+  int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+  QHash<int, QByteArray> roleNames() const override;
+
+signals:
+  void controllerChanged();
+  void rangeChanged();
+  void errorChanged();
+
+private:
+  static constexpr int kPrefetchAhead = 4;    // pages
+  static constexpr int kPrefetchBehind = 1;
+  static constexpr int kMaxRunPages = 16;     // one 64 KiB block read
+  static constexpr int kMaxFetchPages = 32;   // per worker round trip
+
+  void rebuild();
+  void attach();
+  void detach();
+  void flush();
+  void schedule();
+  void emitPages(uint64_t firstPage, uint64_t lastPage);
+  uint64_t firstPage() const;
+  uint64_t lastPage() const;
+
+  QPointer<SimulationController> m_controller;
+  QString m_busPath = QStringLiteral("sysbus");
+  QString m_busNode = QStringLiteral("sysbus.cpu");
+  qulonglong m_baseAddress = 0x08000000;
+  int m_size = 2 * 1024 * 1024;
+  QString m_error;
+
+  std::shared_ptr<MemoryFeed> m_feed;
+  MachineFeedLink m_link;
+  MemoryPageCache m_cache{128};
+  uint64_t m_simTimeUs = 0;  // pages older than this are stale
+  bool m_inFlight = false;
+  bool m_hasBus = false;  // last state published by the feed
+  int m_firstRow = 0;
+  int m_lastRow = -1;
+  int m_direction = 1;
+  mutable std::vector<uint64_t> m_missed;  // pages data() was asked for
+  mutable FrameThrottle m_throttle;
+};
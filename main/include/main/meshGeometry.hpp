@@ -0,0 +1,68 @@
+// meshGeometry.hpp
+// Runtime .obj / glTF import for the 3D twin scene.
+#pragma once
+
+#include <QQuick3DGeometry>
+#include <QString>
+#include <QUrl>
+#include <QVector3D>
+#include <QtQml/qqmlregistration.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Triangle mesh in the layout MeshGeometry uploads: interleaved position and
+// normal, 32-bit indices, node transforms already applied
+struct MeshData {
+  static constexpr int kFloatsPerVertex = 6;  // x y z nx ny nz
+
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  QVector3D boundsMin;
+  QVector3D boundsMax;
+};
+
+// Parses .obj, .gltf (with external or data: buffers) and .glb files.
+// Thread-safe and shared: files already in memory are not parsed again
+// while any geometry still holds them. Returns nullptr and sets error on
+// failure.
+std::shared_ptr<const MeshData> importMesh(const QString &path, QString &error);
+
+// Geometry loaded from `source` on the global thread pool, so large models
+// never stall the GUI thread. The model shows nothing until status becomes
+// Ready; each part of a scene appears as soon as its own file is parsed.
+class MeshGeometry : public QQuick3DGeometry {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QUrl source READ source WRITE setSource NOTIFY sourceChanged FINAL)
+  Q_PROPERTY(Status status READ status NOTIFY statusChanged FINAL)
+  Q_PROPERTY(QString errorString READ errorString NOTIFY statusChanged FINAL)
+  Q_PROPERTY(int triangleCount READ triangleCount NOTIFY statusChanged FINAL)
+
+public:
+  enum Status { Null, Loading, Ready, Error };
+  Q_ENUM(Status)
+
+  explicit MeshGeometry(QQuick3DObject *parent = nullptr);
+
+  QUrl source() const { return m_source; }
+  void setSource(const QUrl &source);
+  Status status() const { return m_status; }
+  QString errorString() const { return m_error; }
+  int triangleCount() const { return m_triangles; }
+
+signals:
+  void sourceChanged();
+  void statusChanged();
+
+private:
+  void apply(const std::shared_ptr<const MeshData> &mesh, const QString &error);
+
+  QUrl m_source;
+  Status m_status = Null;
+  QString m_error;
+  int m_triangles = 0;
+  uint64_t m_request = 0;  // results of superseded loads are dropped
+};
@@ -0,0 +1,94 @@
+// partInstancing.hpp
+// Instanced scene parts driven by GPIO and ADC signals.
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuick3DInstancing>
+#include <QVariantList>
+#include <QVector3D>
+#include <QtQml/qqmlregistration.h>
+
+#include <vector>
+
+#include "adcModel.hpp"
+#include "gpioModel.hpp"
+
+// Instance table for one mesh repeated many times (LEDs, relays, pads,
+// motor shafts), drawn in a single call. Each entry of `parts` is a map:
+//
+//   position, rotation (euler degrees), scale    placement; scale may be a number
+//   color, activeColor                           idle / fully active color
+//   signal                                       "PA5" (GpioModel label) or "adc:0"
+//   activeRotation                               GPIO: euler offset while high (relay)
+//   axis, minAngle, maxAngle, minValue, maxValue ADC: value range mapped to an angle
+//                                                about axis in model space (motor),
+//                                                color blended
+//
+// Parts follow the models' per-frame dataChanged(), so signal updates are
+// already batched to one per frame; only the entries of parts bound to the
+// changed rows are recomputed. The activation (0..1) is passed to custom
+// materials as the instance data's x.
+class PartInstancing : public QQuick3DInstancing {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(GpioModel *gpio READ gpio WRITE setGpio NOTIFY gpioChanged FINAL)
+  Q_PROPERTY(AdcModel *adc READ adc WRITE setAdc NOTIFY adcChanged FINAL)
+  Q_PROPERTY(QVariantList parts READ parts WRITE setParts NOTIFY partsChanged FINAL)
+
+public:
+  explicit PartInstancing(QQuick3DObject *parent = nullptr);
+
+  GpioModel *gpio() const { return m_gpio; }
+  void setGpio(GpioModel *gpio);
+  AdcModel *adc() const { return m_adc; }
+  void setAdc(AdcModel *adc);
+  QVariantList parts() const { return m_partList; }
+  void setParts(const QVariantList &parts);
+
+signals:
+  void gpioChanged();
+  void adcChanged();
+  void partsChanged();
+
+protected:
+  QByteArray getInstanceBuffer(int *instanceCount) override;
+
+private:
+  enum class Source { None, Gpio, Adc };
+
+  struct Part {
+    QVector3D position;
+    QVector3D rotation;
+    QVector3D scale{1, 1, 1};
+    QColor color{Qt::white};
+    QColor activeColor{Qt::white};
+    Source source = Source::None;
+    QString signal;
+    int row = -1;
+    float activation = 0.0f;
+    QVector3D activeRotation;
+    QVector3D axis{0, 1, 0};
+    float minAngle = 0.0f;
+    float maxAngle = 360.0f;
+    float minValue = 0.0f;
+    float maxValue = 3.3f;
+  };
+
+  void resolve();
+  void rowsChanged(Source source, int first, int last);
+  void updateActivation(Part &part) const;
+  InstanceTableEntry entry(const Part &part) const;
+
+  QPointer<GpioModel> m_gpio;
+  QPointer<AdcModel> m_adc;
+  QVariantList m_partList;
+  std::vector<Part> m_parts;
+  std::vector<std::vector<int>> m_gpioParts;  // model row -> bound parts
+  std::vector<std::vector<int>> m_adcParts;
+
+  QByteArray m_buffer;
+  std::vector<int> m_dirty;  // parts to patch into m_buffer
+  bool m_rebuild = true;
+};
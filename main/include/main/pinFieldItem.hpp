@@ -0,0 +1,83 @@
+// pinFieldItem.hpp
+// All pin indicators of one GpioModel as a single scene-graph node.
+#pragma once
+
+#include <QColor>
+#include <QPointer>
+#include <QQuickItem>
+#include <QtQml/qqmlregistration.h>
+
+#include <vector>
+
+#include "gpioModel.hpp"
+
+// Draws one square per model row, `columns` per line (one line per port by
+// default), as a single vertex-colored triangle list: a board costs one
+// draw call whatever its pin count. Dirty rows from the model's per-frame
+// dataChanged() are re-read from its packed pin table and only their
+// vertex colors are rewritten. Clicking a cell toggles the pin through
+// GpioModel::setPinState(); cells are found arithmetically, not by items.
+class PinFieldItem : public QQuickItem {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(GpioModel *model READ model WRITE setModel NOTIFY modelChanged FINAL)
+  Q_PROPERTY(int columns READ columns WRITE setColumns NOTIFY layoutChanged FINAL)
+  Q_PROPERTY(double cellSize READ cellSize WRITE setCellSize NOTIFY layoutChanged FINAL)
+  Q_PROPERTY(double spacing READ spacing WRITE setSpacing NOTIFY layoutChanged FINAL)
+  Q_PROPERTY(bool interactive READ interactive WRITE setInteractive NOTIFY interactiveChanged FINAL)
+  Q_PROPERTY(QColor lowColor READ lowColor WRITE setLowColor NOTIFY colorsChanged FINAL)
+  Q_PROPERTY(QColor highColor READ highColor WRITE setHighColor NOTIFY colorsChanged FINAL)
+  Q_PROPERTY(QColor highZColor READ highZColor WRITE setHighZColor NOTIFY colorsChanged FINAL)
+
+public:
+  explicit PinFieldItem(QQuickItem *parent = nullptr);
+
+  GpioModel *model() const { return m_model; }
+  void setModel(GpioModel *model);
+  int columns() const { return m_columns; }
+  void setColumns(int columns);
+  double cellSize() const { return m_cellSize; }
+  void setCellSize(double size);
+  double spacing() const { return m_spacing; }
+  void setSpacing(double spacing);
+  bool interactive() const { return m_interactive; }
+  void setInteractive(bool interactive);
+  QColor lowColor() const { return m_lowColor; }
+  void setLowColor(const QColor &color);
+  QColor highColor() const { return m_highColor; }
+  void setHighColor(const QColor &color);
+  QColor highZColor() const { return m_highZColor; }
+  void setHighZColor(const QColor &color);
+
+  // Model row under an item position, or -1 (gaps included)
+  Q_INVOKABLE int pinAt(double x, double y) const;
+
+signals:
+  void modelChanged();
+  void layoutChanged();
+  void interactiveChanged();
+  void colorsChanged();
+
+protected:
+  QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+  void mousePressEvent(QMouseEvent *event) override;
+  void mouseReleaseEvent(QMouseEvent *event) override;
+
+private:
+  void relayout();
+  void rowsChanged(int first, int last);
+
+  QPointer<GpioModel> m_model;
+  int m_columns = 16;
+  double m_cellSize = 14.0;
+  double m_spacing = 3.0;
+  bool m_interactive = true;
+  QColor m_lowColor = QColor(0x26, 0x32, 0x38);
+  QColor m_highColor = QColor(0x4c, 0xaf, 0x50);
+  QColor m_highZColor = QColor(0x9e, 0x9e, 0x9e);
+
+  int m_pressedPin = -1;
+  bool m_rebuild = true;        // geometry or colors must be redone from scratch
+  std::vector<int> m_dirtyRows;  // rows whose color may have changed
+};
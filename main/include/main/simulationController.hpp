@@ -0,0 +1,193 @@
+// simulationController.hpp
+// QML-facing simulation control; all Renode I/O runs on a worker thread.
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QQuickWindow>
+#include <QString>
+#include <QThread>
+#include <QtQml/qqmlregistration.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "eventBridge.hpp"
+#include "frameThrottle.hpp"
+#include "renodeInterface.h"
+#include "renodeMachine.h"
+
+// Latest backend state, written by the worker and read by the GUI thread
+struct SimulationState {
+  bool connected = false;
+  bool running = false;
+  uint64_t simTimeUs = 0;
+  double realTimeFactor = 0.0;  // virtual time over wall time of the last quantum
+  QString status;
+};
+
+// Connection parameters handed to the worker on connect
+struct SimulationSettings {
+  QString renodePath;
+  QString scriptPath;
+  QString machineName;
+  quint16 port = 5555;
+  quint16 monitorPort = 5556;
+};
+
+// Lives on SimulationController's worker thread and owns the Renode client
+// and machine. Never blocks the GUI: results are published through the
+// shared SimulationState, and the run loop advances one quantum per event
+// so pause/reset requests interleave with it.
+class SimulationWorker : public QObject {
+  Q_OBJECT
+
+public:
+  // Called on the worker thread with the newly attached machine, and with
+  // nullptr before the machine goes away
+  using MachineObserver = std::function<void(const std::shared_ptr<renode::AMachine> &)>;
+  // Called on the worker thread with the virtual time after each run quantum
+  // or runFor(), i.e. whenever the machine has advanced
+  using AdvanceObserver = std::function<void(uint64_t simTimeUs)>;
+
+  SimulationWorker(std::mutex &stateMtx, SimulationState &state, FrameThrottle &throttle,
+                   std::atomic<bool> &runRequested);
+  ~SimulationWorker() override;
+
+  void connectToRenode(const SimulationSettings &settings);
+  void disconnectFromRenode();
+  void startRunning(quint64 quantumUs);
+  void runFor(quint64 durationUs);
+  void reset();
+
+  // An added observer sees the current machine right away; a removed one
+  // sees nullptr if a machine was attached
+  void addObserver(int id, MachineObserver observer, AdvanceObserver advanced);
+  void removeObserver(int id);
+  // One-off work against the current machine (nullptr if none)
+  void runTask(const MachineObserver &task);
+
+private:
+  void step();
+  template <typename Fn> void publish(Fn &&update);
+  void refreshTime(double wallSeconds, uint64_t startUs);
+  void notifyObservers();
+
+  std::mutex &m_stateMtx;
+  SimulationState &m_state;
+  FrameThrottle &m_throttle;
+  std::atomic<bool> &m_runRequested;
+  struct Observer {
+    MachineObserver machine;
+    AdvanceObserver advanced;
+  };
+  std::map<int, Observer> m_observers;
+
+  std::unique_ptr<renode::ExternalControlClient> m_client;
+  std::shared_ptr<renode::AMachine> m_machine;
+  quint64 m_quantumUs = 10000;
+  bool m_stepQueued = false;
+};
+
+// QML entry point for running the simulation. Backend state changes are
+// coalesced: however fast the worker advances, QML sees at most one update
+// per display frame.
+class SimulationController : public QObject {
+  Q_OBJECT
+  QML_ELEMENT
+
+  Q_PROPERTY(QString renodePath READ renodePath WRITE setRenodePath NOTIFY renodePathChanged FINAL)
+  Q_PROPERTY(QString scriptPath READ scriptPath WRITE setScriptPath NOTIFY scriptPathChanged FINAL)
+  Q_PROPERTY(QString machineName READ machineName WRITE setMachineName NOTIFY machineNameChanged FINAL)
+  Q_PROPERTY(int quantumMs READ quantumMs WRITE setQuantumMs NOTIFY quantumMsChanged FINAL)
+
+  Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged FINAL)
+  Q_PROPERTY(bool running READ running NOTIFY runningChanged FINAL)
+  Q_PROPERTY(double simTimeMs READ simTimeMs NOTIFY simTimeMsChanged FINAL)
+  Q_PROPERTY(double realTimeFactor READ realTimeFactor NOTIFY realTimeFactorChanged FINAL)
+  Q_PROPERTY(QString status READ status NOTIFY statusChanged FINAL)
+  Q_PROPERTY(QQuickWindow *window READ window WRITE setWindow NOTIFY windowChanged FINAL)
+  Q_PROPERTY(double eventsDelivered READ eventsDelivered NOTIFY eventStatsChanged FINAL)
+  Q_PROPERTY(double eventsDropped READ eventsDropped NOTIFY eventStatsChanged FINAL)
+
+public:
+  explicit SimulationController(QObject *parent = nullptr);
+  ~SimulationController() override;
+
+  QString renodePath() const { return m_settings.renodePath; }
+  void setRenodePath(const QString &path);
+  QString scriptPath() const { return m_settings.scriptPath; }
+  void setScriptPath(const QString &path);
+  QString machineName() const { return m_settings.machineName; }
+  void setMachineName(const QString &name);
+  int quantumMs() const { return m_quantumMs; }
+  void setQuantumMs(int ms);
+
+  bool connected() const { return m_view.connected; }
+  bool running() const { return m_view.running; }
+  double simTimeMs() const { return static_cast<double>(m_view.simTimeUs) / 1000.0; }
+  double realTimeFactor() const { return m_view.realTimeFactor; }
+  QString status() const { return m_view.status; }
+  // Window whose frames drain the event bridge
+  QQuickWindow *window() const { return m_window; }
+  void setWindow(QQuickWindow *window);
+  double eventsDelivered() const { return static_cast<double>(m_events.stats().delivered); }
+  double eventsDropped() const { return static_cast<double>(m_events.stats().dropped); }
+
+  // Backend-to-GUI event path for high-rate peripheral events; post from the
+  // worker thread only
+  EventBridge *events() { return &m_events; }
+
+  // Backend hook for models fed from the machine (see SimulationWorker::
+  // MachineObserver). The observers run and are destroyed on the worker
+  // thread; returns an id for unobserveMachine().
+  int observeMachine(SimulationWorker::MachineObserver observer,
+                     SimulationWorker::AdvanceObserver advanced = {});
+  void unobserveMachine(int id);
+  // Queues task behind the worker's pending requests; it gets the machine
+  // attached at that point, or nullptr
+  void withMachine(SimulationWorker::MachineObserver task);
+
+  Q_INVOKABLE void connectToRenode();
+  Q_INVOKABLE void disconnectFromRenode();
+  Q_INVOKABLE void run();
+  Q_INVOKABLE void pause();
+  Q_INVOKABLE void reset();
+  Q_INVOKABLE void runFor(int milliseconds);
+
+signals:
+  void renodePathChanged();
+  void scriptPathChanged();
+  void machineNameChanged();
+  void quantumMsChanged();
+  void connectedChanged();
+  void runningChanged();
+  void simTimeMsChanged();
+  void realTimeFactorChanged();
+  void statusChanged();
+  void windowChanged();
+  void eventStatsChanged();
+
+private:
+  void flush();
+
+  // Shared with the worker
+  std::mutex m_stateMtx;
+  SimulationState m_state;
+  FrameThrottle m_throttle;
+  std::atomic<bool> m_runRequested{false};
+
+  QThread m_thread;
+  SimulationWorker *m_worker = nullptr;  // deleted on m_thread when it finishes
+
+  SimulationSettings m_settings;
+  int m_quantumMs = 10;
+  int m_nextObserverId = 1;
+  SimulationState m_view;  // what QML currently sees
+  QPointer<QQuickWindow> m_window;
+  EventBridge m_events;
+};
@@ -0,0 +1,178 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import digitwin
+
+Item {
+    id: page
+
+    // "host:port", "host:port/monitorPort" or "unix:/broker.sock"
+    property list<string> endpoints
+    property list<string> pins: ["sysbus.gpioPortA:5", "sysbus.gpioPortB:0"]
+
+    readonly property var stateNames: ["Running", "Paused", "Unreachable"]
+    readonly property var stateColors: ["#66bb6a", "#ffca28", "#e57373"]
+
+    FleetModel {
+        id: fleet
+        endpoints: page.endpoints
+        pins: page.pins
+    }
+
+    FleetProxyModel {
+        id: sortedFleet
+        sourceModel: fleet
+        sortBy: sortKey.currentValue ?? "name"
+        descending: descendingBox.checked
+        filterText: filterField.text
+        stateFilter: stateBox.currentValue ?? -1
+    }
+
+    FontMetrics {
+        id: mono
+        font.family: "monospace"
+        font.pixelSize: 12
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: 4
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            TextField {
+                Layout.fillWidth: true
+                placeholderText: "Renode instances: host:port, unix:/path …"
+                text: page.endpoints.join(", ")
+                onAccepted: page.endpoints = text.split(",").map(s => s.trim()).filter(s => s.length > 0)
+            }
+            TextField {
+                id: filterField
+                Layout.preferredWidth: 180
+                placeholderText: "Filter"
+            }
+            ComboBox {
+                id: stateBox
+                textRole: "text"
+                valueRole: "value"
+                model: [
+                    { text: "All states", value: -1 },
+                    { text: "Running", value: FleetModel.Running },
+                    { text: "Paused", value: FleetModel.Paused },
+                    { text: "Unreachable", value: FleetModel.Unreachable }
+                ]
+            }
+            ComboBox {
+                id: sortKey
+                textRole: "text"
+                valueRole: "value"
+                model: [
+                    { text: "Name", value: "name" },
+                    { text: "Instance", value: "instance" },
+                    { text: "State", value: "machineState" },
+                    { text: "Sim time", value: "simTimeMs" },
+                    { text: "Real-time factor", value: "realTimeFactor" },
+                    { text: "High pins", value: "highPins" }
+                ]
+            }
+            CheckBox {
+                id: descendingBox
+                text: "Descending"
+            }
+            Label {
+                font.family: "monospace"
+                text: sortedFleet.count + "/" + fleet.count + " machines, " + fleet.runningCount + " running"
+                      + (fleet.unreachableCount > 0 ? ", " + fleet.unreachableCount + " unreachable" : "")
+            }
+        }
+
+        ListView {
+            id: rows
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+            model: sortedFleet
+            reuseItems: true
+            boundsBehavior: Flickable.StopAtBounds
+            ScrollBar.vertical: ScrollBar { minimumSize: 0.02 }
+
+            // Fixed row height: only visible rows get delegates, however
+            // large the fleet
+            readonly property real rowHeight: mono.height + 6
+
+            delegate: Rectangle {
+                id: machineRow
+
+                required property int index
+                required property string instance
+                required property string name
+                required property int machineState
+                required property double simTimeMs
+                required property double realTimeFactor
+                required property string pins
+                required property string error
+
+                width: ListView.view.width
+                height: rows.rowHeight
+                color: index % 2 ? palette.alternateBase : palette.base
+
+                RowLayout {
+                    anchors.fill: parent
+                    anchors.leftMargin: 6
+                    anchors.rightMargin: 6
+                    spacing: 12
+
+                    Rectangle {
+                        Layout.preferredWidth: 10
+                        Layout.preferredHeight: 10
+                        radius: 5
+                        color: page.stateColors[machineRow.machineState]
+                    }
+                    Text {
+                        Layout.preferredWidth: mono.averageCharacterWidth * 24
+                        elide: Text.ElideRight
+                        font: mono.font
+                        color: palette.text
+                        text: machineRow.name
+                    }
+                    Text {
+                        Layout.preferredWidth: mono.averageCharacterWidth * 22
+                        elide: Text.ElideMiddle
+                        font: mono.font
+                        color: palette.placeholderText
+                        text: machineRow.instance
+                    }
+                    Text {
+                        Layout.preferredWidth: mono.averageCharacterWidth * 12
+                        font: mono.font
+                        color: palette.text
+                        text: page.stateNames[machineRow.machineState]
+                    }
+                    Text {
+                        Layout.preferredWidth: mono.averageCharacterWidth * 14
+                        horizontalAlignment: Text.AlignRight
+                        font: mono.font
+                        color: palette.text
+                        text: (machineRow.simTimeMs / 1000).toFixed(3) + " s"
+                    }
+                    Text {
+                        Layout.preferredWidth: mono.averageCharacterWidth * 8
+                        horizontalAlignment: Text.AlignRight
+                        font: mono.font
+                        color: palette.text
+                        text: "×" + machineRow.realTimeFactor.toFixed(2)
+                    }
+                    Text {
+                        Layout.fillWidth: true
+                        elide: Text.ElideRight
+                        font: mono.font
+                        color: machineRow.error.length > 0 ? "#e57373" : palette.text
+                        text: machineRow.error.length > 0 ? machineRow.error : machineRow.pins
+                    }
+                }
+            }
+        }
+    }
+}
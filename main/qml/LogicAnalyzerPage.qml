@@ -0,0 +1,173 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import digitwin
+
+Item {
+    id: page
+
+    required property SimulationController controller
+
+    LogicAnalyzer {
+        id: capture
+        controller: page.controller
+        probes: [
+            "sysbus.gpioPortA:2",  // USART2 TX
+            "sysbus.gpioPortA:5",  // SPI1 SCK
+            "sysbus.gpioPortA:6",  // SPI1 MISO
+            "sysbus.gpioPortA:7",  // SPI1 MOSI
+            "sysbus.gpioPortA:4",  // SPI1 NSS
+            "sysbus.gpioPortB:6",  // I2C1 SCL
+            "sysbus.gpioPortB:7"   // I2C1 SDA
+        ]
+        Component.onCompleted: {
+            addUartDecoder(0, 115200)
+            addSpiDecoder(1, 3, 2, 4, 0)
+            addI2cDecoder(5, 6)
+        }
+    }
+
+    // Re-read whenever the view moves or the capture grows
+    readonly property var visibleAnnotations: {
+        capture.captureEndMs
+        capture.decoderCount
+        return capture.annotations(timeline.startMs, timeline.startMs + timeline.spanMs, 400)
+    }
+    readonly property var measurement: timeline.cursorAMs >= 0 && timeline.cursorBMs >= 0
+                                       ? capture.measure(probeList.currentIndex,
+                                                          timeline.cursorAMs, timeline.cursorBMs)
+                                       : null
+
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: 4
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            CheckBox {
+                text: "Follow"
+                checked: timeline.follow
+                onToggled: timeline.follow = checked
+            }
+            Label { text: "Span " + timeline.spanMs.toPrecision(3) + " ms" }
+            Item { Layout.fillWidth: true }
+            Label {
+                font.family: "monospace"
+                text: timeline.cursorAMs < 0 ? "A: -" : "A: " + timeline.cursorAMs.toFixed(3) + " ms"
+            }
+            Label {
+                font.family: "monospace"
+                text: timeline.cursorBMs < 0 ? "B: -" : "B: " + timeline.cursorBMs.toFixed(3) + " ms"
+            }
+            Label {
+                font.family: "monospace"
+                visible: page.measurement !== null
+                text: page.measurement === null ? "" :
+                      "Δ " + Math.abs(timeline.cursorBMs - timeline.cursorAMs).toFixed(3) + " ms  "
+                      + page.measurement.edges + " edges  "
+                      + (page.measurement.dutyCycle * 100).toFixed(1) + "% high  "
+                      + page.measurement.frequencyHz.toFixed(1) + " Hz"
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            spacing: 0
+
+            ListView {
+                id: probeList
+                Layout.preferredWidth: 160
+                Layout.fillHeight: true
+                interactive: false
+                model: capture
+                currentIndex: 0
+
+                delegate: ItemDelegate {
+                    required property int index
+                    required property string probe
+                    required property real edges
+
+                    width: ListView.view.width
+                    height: timeline.rowHeight
+                    highlighted: ListView.isCurrentItem
+                    text: probe.replace("sysbus.gpioPort", "P").replace(":", "") + "  " + edges
+                    font.pixelSize: 11
+                    onClicked: probeList.currentIndex = index
+                }
+            }
+
+            LogicTimeline {
+                id: timeline
+                Layout.fillWidth: true
+                Layout.fillHeight: true
+                clip: true
+                analyzer: capture
+
+                Repeater {
+                    model: page.visibleAnnotations
+
+                    delegate: Rectangle {
+                        required property var modelData
+
+                        x: timeline.xAt(modelData.startMs)
+                        y: (capture.rowCount() + modelData.decoder) * timeline.rowHeight + 4
+                        width: Math.max(timeline.xAt(modelData.endMs) - x, 2)
+                        height: timeline.rowHeight - 8
+                        radius: 2
+                        color: "#37474f"
+                        border.color: "#90a4ae"
+
+                        Label {
+                            anchors.centerIn: parent
+                            width: parent.width - 4
+                            horizontalAlignment: Text.AlignHCenter
+                            elide: Text.ElideRight
+                            text: modelData.text
+                            font.pixelSize: 10
+                            color: "white"
+                        }
+                    }
+                }
+
+                WheelHandler {
+                    onWheel: event => timeline.zoom(event.angleDelta.y > 0 ? 0.8 : 1.25, point.position.x)
+                }
+                DragHandler {
+                    property real startAtPress
+                    target: null
+                    onActiveChanged: {
+                        if (active) {
+                            timeline.follow = false
+                            startAtPress = timeline.startMs
+                        }
+                    }
+                    onTranslationChanged: if (active)
+                        timeline.startMs = startAtPress - translation.x / timeline.width * timeline.spanMs
+                }
+                TapHandler {
+                    acceptedButtons: Qt.LeftButton | Qt.RightButton
+                    onTapped: (eventPoint, button) => {
+                        let ms = timeline.timeAt(eventPoint.position.x)
+                        // Snap to the closest edge of the probe row under the pointer
+                        let row = Math.floor(eventPoint.position.y / timeline.rowHeight)
+                        if (row < capture.rowCount()) {
+                            let next = capture.nextEdgeMs(row, ms)
+                            let prev = capture.previousEdgeMs(row, ms)
+                            let best = next < 0 ? prev : prev < 0 ? next
+                                     : (next - ms < ms - prev ? next : prev)
+                            if (best >= 0 && Math.abs(timeline.xAt(best) - eventPoint.position.x) < 8)
+                                ms = best
+                        }
+                        if (button === Qt.RightButton)
+                            timeline.cursorBMs = ms
+                        else
+                            timeline.cursorAMs = ms
+                    }
+                }
+            }
+        }
+    }
+}
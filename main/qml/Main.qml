@@ -1,7 +1,14 @@
 import QtQuick
 import QtQuick.Controls
+import QtQuick.Layouts
+import digitwin
 
 ApplicationWindow {
+    id: root
+
+    property string renodePath
+    property string scriptPath
+
     width: 1280
     height: 720
     minimumWidth: 800
@@ -9,21 +16,179 @@ ApplicationWindow {
     visible: true
     title: "DigiTwin"
 
-    Rectangle {
-        width: 400
-        height: 300
-        color: "lightblue"
+    SimulationController {
+        id: simulation
+        window: root
+        renodePath: root.renodePath
+        scriptPath: root.scriptPath
+    }
+
+    header: ToolBar {
+        RowLayout {
+            anchors.fill: parent
+            spacing: 8
+
+            Button {
+                text: simulation.connected ? "Disconnect" : "Connect"
+                onClicked: simulation.connected ? simulation.disconnectFromRenode()
+                                                : simulation.connectToRenode()
+            }
+            Button {
+                text: simulation.running ? "Pause" : "Run"
+                enabled: simulation.connected
+                onClicked: simulation.running ? simulation.pause() : simulation.run()
+            }
+            Button {
+                text: "Reset"
+                enabled: simulation.connected
+                onClicked: simulation.reset()
+            }
+            SpinBox {
+                id: stepMs
+                from: 1
+                to: 10000
+                value: 100
+                editable: true
+                enabled: simulation.connected && !simulation.running
+            }
+            Button {
+                text: "Run for " + stepMs.value + " ms"
+                enabled: simulation.connected && !simulation.running
+                onClicked: simulation.runFor(stepMs.value)
+            }
+            Item { Layout.fillWidth: true }
+            Label {
+                text: "t = " + (simulation.simTimeMs / 1000).toFixed(3) + " s"
+                font.family: "monospace"
+            }
+            Label {
+                text: "×" + simulation.realTimeFactor.toFixed(2)
+                font.family: "monospace"
+                visible: simulation.running
+            }
+            Label {
+                text: simulation.eventsDropped + " events dropped"
+                color: "#e57373"
+                visible: simulation.eventsDropped > 0
+            }
+        }
+    }
+
+    GpioModel {
+        id: gpio
+        controller: simulation
+    }
+
+    AdcModel {
+        id: adc
+        controller: simulation
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: 8
+        spacing: 8
 
-        Text {
-            text: "Hello, QML World!"
-            //anchors: anchors.centerInParent
+        TabBar {
+            id: pages
+            Layout.fillWidth: true
+            TabButton { text: "Dashboard" }
+            TabButton { text: "Logic analyzer" }
+            TabButton { text: "Memory" }
+            TabButton { text: "3D" }
+            TabButton { text: "Fleet" }
         }
 
-        Button {
-            text: "Click me"
-            width: 200
-            height: 50
-            //anchors: anchors.centerInParent
+        StackLayout {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            currentIndex: pages.currentIndex
+
+            ColumnLayout {
+                spacing: 8
+
+                // One draw call for every pin; click a cell to toggle it
+                PinFieldItem {
+                    id: pinField
+                    Layout.fillHeight: true
+                    model: gpio
+                    columns: gpio.pinsPerPort
+                    cellSize: 22
+
+                    readonly property int hoveredPin: hover.hovered
+                        ? pinAt(hover.point.position.x, hover.point.position.y) : -1
+
+                    HoverHandler { id: hover }
+                    ToolTip.visible: hoveredPin >= 0
+                    ToolTip.text: hoveredPin < 0 ? ""
+                        : gpio.data(gpio.index(hoveredPin, 0), GpioModel.LabelRole) + ": "
+                          + gpio.data(gpio.index(hoveredPin, 0), GpioModel.TogglesRole) + " toggles"
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: 8
+
+                    Label { text: "ADC channel" }
+                    SpinBox {
+                        id: adcChannel
+                        from: 0
+                        to: Math.max(adc.channelCount - 1, 0)
+                    }
+                    Label { text: "Span (ms)" }
+                    SpinBox {
+                        id: adcSpan
+                        from: 1
+                        to: 3600000
+                        value: 1000
+                        editable: true
+                    }
+                    CheckBox {
+                        id: adcFollow
+                        text: "Follow"
+                        checked: true
+                    }
+                    Slider {
+                        id: adcScroll
+                        Layout.fillWidth: true
+                        enabled: !adcFollow.checked
+                        from: adc.firstTimeMs
+                        to: adc.lastTimeMs
+                    }
+                    Label {
+                        text: adc.sampleCount + " samples"
+                        font.family: "monospace"
+                    }
+                }
+
+                AdcScope {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: 200
+                    clip: true
+                    model: adc
+                    channel: adcChannel.value
+                    spanMs: adcSpan.value
+                    follow: adcFollow.checked
+                    endMs: adcFollow.checked ? adc.lastTimeMs : adcScroll.value
+                }
+            }
+
+            LogicAnalyzerPage {
+                controller: simulation
+            }
+            MemoryPage {
+                controller: simulation
+            }
+            TwinScenePage {
+                gpioModel: gpio
+                adcModel: adc
+            }
+            FleetPage {}
         }
     }
+
+    footer: Label {
+        text: simulation.status
+        padding: 6
+    }
 }
@@ -0,0 +1,134 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import digitwin
+
+Item {
+    id: page
+
+    required property SimulationController controller
+
+    MemoryModel {
+        id: memory
+        controller: page.controller
+    }
+
+    FontMetrics {
+        id: mono
+        font.family: "monospace"
+        font.pixelSize: 12
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: 4
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            ComboBox {
+                id: region
+                textRole: "name"
+                model: [
+                    { name: "Flash", base: 0x08000000, size: 2 * 1024 * 1024 },
+                    { name: "SRAM", base: 0x20000000, size: 128 * 1024 },
+                    { name: "Peripherals", base: 0x40000000, size: 64 * 1024 }
+                ]
+                onActivated: {
+                    memory.baseAddress = model[currentIndex].base
+                    memory.size = model[currentIndex].size
+                }
+            }
+            TextField {
+                id: gotoField
+                Layout.preferredWidth: 120
+                font.family: "monospace"
+                placeholderText: "Go to 0x…"
+                onAccepted: {
+                    let address = parseInt(text, 16)
+                    if (!isNaN(address))
+                        rows.positionViewAtIndex(memory.rowForAddress(address), ListView.Beginning)
+                }
+            }
+            Label {
+                Layout.fillWidth: true
+                elide: Text.ElideRight
+                color: "#e57373"
+                text: memory.error
+            }
+        }
+
+        ListView {
+            id: rows
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+            model: memory
+            reuseItems: true
+            boundsBehavior: Flickable.StopAtBounds
+            ScrollBar.vertical: ScrollBar { minimumSize: 0.02 }
+
+            // Fixed-height rows keep the content height arithmetic, however
+            // large the range
+            readonly property real rowHeight: mono.height + 2
+
+            function reportVisible() {
+                let first = Math.floor(contentY / rowHeight)
+                memory.setVisibleRows(first, first + Math.ceil(height / rowHeight))
+            }
+            onContentYChanged: reportVisible()
+            onHeightChanged: reportVisible()
+            onCountChanged: reportVisible()
+
+            delegate: Row {
+                required property string address
+                required property string hex
+                required property string ascii
+                required property int changed
+                required property bool loaded
+
+                height: rows.rowHeight
+                spacing: mono.averageCharacterWidth * 2
+
+                Text {
+                    font: mono.font
+                    color: "#90a4ae"
+                    text: address
+                }
+                Item {
+                    width: mono.averageCharacterWidth * 47
+                    height: parent.height
+
+                    // Bytes that differ from the previous read
+                    Repeater {
+                        model: {
+                            let bytes = []
+                            for (let i = 0; i < 16; ++i)
+                                if (changed & (1 << i)) bytes.push(i)
+                            return bytes
+                        }
+                        delegate: Rectangle {
+                            required property int modelData
+                            x: modelData * 3 * mono.averageCharacterWidth - 1
+                            width: mono.averageCharacterWidth * 2 + 2
+                            height: parent.height
+                            radius: 2
+                            color: "#5d4037"
+                        }
+                    }
+                    Text {
+                        font: mono.font
+                        color: loaded ? palette.text : palette.placeholderText
+                        text: hex
+                    }
+                }
+                Text {
+                    font: mono.font
+                    color: loaded ? palette.text : palette.placeholderText
+                    text: ascii
+                }
+            }
+        }
+    }
+}
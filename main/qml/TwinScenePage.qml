@@ -0,0 +1,195 @@
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import QtQuick3D
+import QtQuick3D.Helpers
+import digitwin
+
+Item {
+    id: page
+
+    required property GpioModel gpioModel
+    required property AdcModel adcModel
+    property string modelFile
+
+    // Board layout in scene units (1 unit = 1 mm)
+    readonly property real boardWidth: 200
+    readonly property real boardDepth: 140
+
+    function ledParts() {
+        let parts = []
+        let pins = ["PA5", "PA6", "PA7", "PB0", "PB1", "PB2", "PB10", "PB11"]
+        for (let i = 0; i < pins.length; ++i) {
+            parts.push({
+                position: Qt.vector3d(-70 + i * 20, 8, -50),
+                scale: 0.06,
+                color: "#3e1010",
+                activeColor: "#ff3d3d",
+                signal: pins[i]
+            })
+        }
+        return parts
+    }
+
+    function relayParts() {
+        return [
+            { position: Qt.vector3d(40, 12, 20), scale: Qt.vector3d(0.02, 0.12, 0.3),
+              color: "#607d8b", activeColor: "#ffca28",
+              activeRotation: Qt.vector3d(0, 0, -25), signal: "PC0" },
+            { position: Qt.vector3d(60, 12, 20), scale: Qt.vector3d(0.02, 0.12, 0.3),
+              color: "#607d8b", activeColor: "#ffca28",
+              activeRotation: Qt.vector3d(0, 0, -25), signal: "PC1" }
+        ]
+    }
+
+    // A dense field of static parts; one draw call however many there are
+    function padParts(columns, rows) {
+        let parts = []
+        for (let y = 0; y < rows; ++y)
+            for (let x = 0; x < columns; ++x)
+                parts.push({
+                    position: Qt.vector3d(-90 + x * 180 / columns, 5.5, 5 + y * 60 / rows),
+                    scale: Qt.vector3d(0.015, 0.002, 0.015),
+                    color: "#c0a060"
+                })
+        return parts
+    }
+
+    function copyParts(count) {
+        let parts = []
+        let side = Math.ceil(Math.sqrt(count))
+        for (let i = 0; i < count; ++i)
+            parts.push({
+                position: Qt.vector3d(-60 + (i % side) * 30, 6, -20 + Math.floor(i / side) * 30),
+                color: "white"
+            })
+        return parts
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        spacing: 4
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: 8
+
+            TextField {
+                id: modelPath
+                Layout.fillWidth: true
+                placeholderText: "Model file (.obj, .gltf, .glb)"
+                onAccepted: page.modelFile = text
+            }
+            SpinBox {
+                id: copies
+                from: 1
+                to: 400
+                value: 1
+            }
+            Label {
+                text: imported.status === MeshGeometry.Loading ? "Loading…"
+                    : imported.status === MeshGeometry.Error ? imported.errorString
+                    : imported.status === MeshGeometry.Ready ? imported.triangleCount + " triangles"
+                    : ""
+            }
+        }
+
+        View3D {
+            id: view
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+
+            environment: SceneEnvironment {
+                clearColor: "#202428"
+                backgroundMode: SceneEnvironment.Color
+                antialiasingMode: SceneEnvironment.MSAA
+            }
+
+            Node {
+                id: origin
+
+                PerspectiveCamera {
+                    id: camera
+                    position: Qt.vector3d(0, 160, 220)
+                    eulerRotation.x: -35
+                    clipNear: 1
+                    clipFar: 5000
+                }
+            }
+
+            DirectionalLight {
+                eulerRotation.x: -50
+                eulerRotation.y: -30
+                castsShadow: true
+            }
+
+            // PCB
+            Model {
+                source: "#Cube"
+                scale: Qt.vector3d(page.boardWidth / 100, 0.1, page.boardDepth / 100)
+                materials: PrincipledMaterial { baseColor: "#1b5e20"; roughness: 0.8 }
+            }
+
+            Model {
+                source: "#Sphere"
+                instancing: PartInstancing {
+                    gpio: page.gpioModel
+                    parts: page.ledParts()
+                }
+                materials: PrincipledMaterial { baseColor: "white"; lighting: PrincipledMaterial.NoLighting }
+            }
+
+            Model {
+                source: "#Cube"
+                instancing: PartInstancing {
+                    gpio: page.gpioModel
+                    parts: page.relayParts()
+                }
+                materials: PrincipledMaterial { baseColor: "white"; metalness: 0.6 }
+            }
+
+            Model {
+                source: "#Cube"
+                instancing: PartInstancing { parts: page.padParts(96, 32) }
+                materials: PrincipledMaterial { baseColor: "white"; metalness: 1.0; roughness: 0.3 }
+            }
+
+            // Motor shaft, angle from ADC channel 0
+            Model {
+                source: "#Cylinder"
+                instancing: PartInstancing {
+                    adc: page.adcModel
+                    parts: [{
+                        position: Qt.vector3d(-60, 30, 40),
+                        rotation: Qt.vector3d(0, 0, 0),
+                        scale: Qt.vector3d(0.2, 0.5, 0.2),
+                        color: "#90a4ae",
+                        activeColor: "#ff7043",
+                        signal: "adc:0",
+                        axis: Qt.vector3d(0, 1, 0),
+                        minAngle: 0,
+                        maxAngle: 270
+                    }]
+                }
+                materials: PrincipledMaterial { baseColor: "white"; metalness: 0.8 }
+            }
+
+            // Imported part, repeated `copies` times through instancing
+            Model {
+                visible: imported.status === MeshGeometry.Ready
+                geometry: MeshGeometry {
+                    id: imported
+                    source: page.modelFile.length > 0 ? "file://" + page.modelFile : ""
+                }
+                instancing: PartInstancing { parts: page.copyParts(copies.value) }
+                materials: PrincipledMaterial { baseColor: "#cfd8dc" }
+            }
+
+            OrbitCameraController {
+                anchors.fill: parent
+                origin: origin
+                camera: camera
+            }
+        }
+    }
+}
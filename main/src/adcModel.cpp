@@ -0,0 +1,298 @@
+// adcModel.cpp
+#include "adcModel.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+using namespace renode;
+
+// ============================================================================
+// AdcHistory
+// ============================================================================
+
+AdcHistory::AdcHistory(size_t capacity) : m_capacity(std::max<size_t>(capacity, 16)) {
+  // Stop once a level would hold fewer than 16 columns of the full buffer
+  m_levelCount = 0;
+  while ((m_capacity >> (kFanoutShift * (m_levelCount + 1))) >= 16) ++m_levelCount;
+}
+
+void AdcHistory::reset(int channels) {
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    resetLocked(channels);
+  }
+  m_notifier.notify();
+}
+
+void AdcHistory::resetLocked(int channels) {
+  m_count = 0;
+  m_allocated = 0;
+  m_times = {};
+  m_channels.assign(static_cast<size_t>(std::max(channels, 0)), Channel{});
+  for (auto &ch : m_channels) ch.levels.resize(m_levelCount);
+}
+
+// Only called while the ring has not wrapped yet, so every sample and bucket
+// keeps its index
+void AdcHistory::growLocked(size_t samples) {
+  m_allocated = samples;
+  m_times.resize(samples);
+  for (auto &ch : m_channels) {
+    ch.raw.resize(samples);
+    for (int l = 0; l < m_levelCount; ++l) {
+      // Enough buckets for every one overlapping the retained samples
+      ch.levels[l].resize((samples >> (kFanoutShift * (l + 1))) + 2);
+    }
+  }
+}
+
+void AdcHistory::append(uint64_t timeUs, const std::vector<float> &values) {
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    if (m_count && timeUs < timeAtLocked(m_count - 1)) resetLocked(static_cast<int>(m_channels.size()));
+
+    uint64_t index = m_count;
+    if (index == m_allocated && m_allocated < m_capacity) {
+      growLocked(std::min(m_capacity, std::max(m_allocated * 2, kInitialSamples)));
+    }
+    m_times[index % m_capacity] = timeUs;
+    for (size_t c = 0; c < m_channels.size(); ++c) {
+      Channel &ch = m_channels[c];
+      float v = c < values.size() ? values[c] : 0.0f;
+      ch.raw[index % m_capacity] = v;
+      for (int l = 0; l < m_levelCount; ++l) {
+        int shift = kFanoutShift * (l + 1);
+        auto &buckets = ch.levels[l];
+        MinMax &bucket = buckets[(index >> shift) % buckets.size()];
+        if ((index & ((uint64_t(1) << shift) - 1)) == 0) {
+          bucket = {v, v};
+        } else {
+          bucket.min = std::min(bucket.min, v);
+          bucket.max = std::max(bucket.max, v);
+        }
+      }
+    }
+    ++m_count;
+  }
+  m_notifier.notify();
+}
+
+int AdcHistory::channels() const {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  return static_cast<int>(m_channels.size());
+}
+
+uint64_t AdcHistory::sampleCount() const {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  return m_count - oldestLocked();
+}
+
+bool AdcHistory::timeRange(uint64_t &firstUs, uint64_t &lastUs) const {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  if (!m_count) return false;
+  firstUs = timeAtLocked(oldestLocked());
+  lastUs = timeAtLocked(m_count - 1);
+  return true;
+}
+
+float AdcHistory::latest(int channel) const {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  if (!m_count || channel < 0 || channel >= static_cast<int>(m_channels.size())) return 0.0f;
+  return m_channels[channel].raw[(m_count - 1) % m_capacity];
+}
+
+void AdcHistory::query(int channel, uint64_t fromUs, uint64_t toUs, size_t maxColumns,
+                       std::vector<Column> &out) const {
+  out.clear();
+  std::lock_guard<std::mutex> lk(m_mtx);
+  if (!m_count || channel < 0 || channel >= static_cast<int>(m_channels.size())) return;
+  if (maxColumns == 0 || toUs < fromUs) return;
+
+  // Timestamps increase with the sample index: binary search the ring
+  uint64_t oldest = oldestLocked();
+  auto firstAtOrAfter = [&](uint64_t timeUs, bool strictlyAfter) {
+    uint64_t lo = oldest, hi = m_count;
+    while (lo < hi) {
+      uint64_t mid = lo + (hi - lo) / 2;
+      uint64_t t = timeAtLocked(mid);
+      if (strictlyAfter ? t <= timeUs : t < timeUs) lo = mid + 1;
+      else hi = mid;
+    }
+    return lo;
+  };
+  uint64_t begin = firstAtOrAfter(fromUs, false);
+  uint64_t end = firstAtOrAfter(toUs, true);
+  if (begin > oldest) --begin;
+  if (end < m_count) ++end;
+  if (begin >= end) return;
+
+  const Channel &ch = m_channels[channel];
+  if (end - begin <= maxColumns || m_levelCount == 0) {
+    out.reserve(end - begin);
+    for (uint64_t i = begin; i < end; ++i) {
+      float v = ch.raw[i % m_capacity];
+      out.push_back({timeAtLocked(i), v, v});
+    }
+    return;
+  }
+
+  int level = 1;
+  while (level < m_levelCount &&
+         ((end - 1) >> (kFanoutShift * level)) - (begin >> (kFanoutShift * level)) + 1 > maxColumns) {
+    ++level;
+  }
+  int shift = kFanoutShift * level;
+  const auto &buckets = ch.levels[level - 1];
+  out.reserve(((end - 1) >> shift) - (begin >> shift) + 1);
+  for (uint64_t b = begin >> shift; b <= (end - 1) >> shift; ++b) {
+    // The oldest bucket may have lost its first samples to the ring
+    const MinMax &mm = buckets[b % buckets.size()];
+    out.push_back({timeAtLocked(std::max(b << shift, oldest)), mm.min, mm.max});
+  }
+}
+
+void AdcHistory::setNotifier(std::function<void()> notify) {
+  m_notifier.set(std::move(notify));
+}
+
+// ============================================================================
+// Backend feed (worker thread)
+// ============================================================================
+
+namespace {
+
+// Samples every channel of the ADC after each quantum while a machine is attached
+struct AdcFeed {
+  std::shared_ptr<AdcHistory> history;
+  std::string path;
+  std::shared_ptr<Adc> adc;
+  int channels = 0;
+  std::vector<float> values;
+
+  void attach(const std::shared_ptr<AMachine> &machine) {
+    Error err;
+    adc = machine->getAdc(path, err);
+    channels = 0;
+    if (adc && adc->getChannelCount(channels)) channels = 0;
+    if (!channels) adc.reset();
+    values.assign(static_cast<size_t>(channels), 0.0f);
+    history->reset(channels);
+    if (adc) advance(machine->getTime(TimeUnit::TU_MICROSECONDS).value);
+  }
+
+  void detach() { adc.reset(); }
+
+  void advance(uint64_t timeUs) {
+    if (!adc) return;
+    for (int c = 0; c < channels; ++c) {
+      AdcValue v = 0.0;
+      if (!adc->getChannelValue(c, v)) values[c] = static_cast<float>(v);
+    }
+    history->append(timeUs, values);
+  }
+};
+
+} // namespace
+
+// ============================================================================
+// AdcModel
+// ============================================================================
+
+AdcModel::AdcModel(QObject *parent)
+    : QAbstractListModel(parent), m_throttle([this] { flush(); }) {
+  rebuild();
+}
+
+AdcModel::~AdcModel() {
+  detach();
+}
+
+void AdcModel::setController(SimulationController *controller) {
+  if (m_controller == controller) return;
+  detach();
+  m_controller = controller;
+  attach();
+  emit controllerChanged();
+}
+
+void AdcModel::setAdcPath(const QString &path) {
+  if (m_adcPath == path) return;
+  m_adcPath = path;
+  rebuild();
+  emit adcPathChanged();
+}
+
+void AdcModel::setHistorySize(int samples) {
+  samples = std::max(samples, 1024);
+  if (m_historySize == samples) return;
+  m_historySize = samples;
+  rebuild();
+  emit historySizeChanged();
+}
+
+void AdcModel::rebuild() {
+  detach();
+  m_history = std::make_shared<AdcHistory>(static_cast<size_t>(m_historySize));
+  attach();
+  flush();
+}
+
+void AdcModel::attach() {
+  if (!m_controller) return;
+  m_history->setNotifier([throttle = &m_throttle] { throttle->request(); });
+
+  auto feed = std::make_shared<AdcFeed>();
+  feed->history = m_history;
+  feed->path = m_adcPath.toStdString();
+  m_link.observe(m_controller, feed);
+}
+
+void AdcModel::detach() {
+  if (m_history) m_history->setNotifier(nullptr);
+  m_link.release();
+}
+
+int AdcModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid()) return 0;
+  return m_rows;
+}
+
+QVariant AdcModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= m_rows) return {};
+  switch (role) {
+  case ChannelRole: return index.row();
+  case Qt::DisplayRole:
+  case ValueRole: return static_cast<double>(m_history->latest(index.row()));
+  default: return {};
+  }
+}
+
+QHash<int, QByteArray> AdcModel::roleNames() const {
+  return {
+      {ChannelRole, "channel"},
+      {ValueRole, "value"},
+  };
+}
+
+// Runs at most once per display frame (FrameThrottle)
+void AdcModel::flush() {
+  int channels = m_history->channels();
+  if (channels != m_rows) {
+    beginResetModel();
+    m_rows = channels;
+    endResetModel();
+    emit channelCountChanged();
+  } else if (m_rows > 0) {
+    emit dataChanged(index(0), index(m_rows - 1), {ValueRole});
+  }
+
+  uint64_t count = m_history->sampleCount();
+  uint64_t firstUs = 0, lastUs = 0;
+  m_history->timeRange(firstUs, lastUs);
+  if (count == m_sampleCount && firstUs == m_firstUs && lastUs == m_lastUs) return;
+  m_sampleCount = count;
+  m_firstUs = firstUs;
+  m_lastUs = lastUs;
+  emit samplesChanged();
+}
@@ -0,0 +1,131 @@
+// adcScope.cpp
+#include "adcScope.hpp"
+
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+
+#include <algorithm>
+#include <cmath>
+
+AdcScope::AdcScope(QQuickItem *parent) : QQuickItem(parent) {
+  setFlag(ItemHasContents, true);
+}
+
+void AdcScope::setModel(AdcModel *model) {
+  if (m_model == model) return;
+  if (m_model) disconnect(m_model, nullptr, this, nullptr);
+  m_model = model;
+  if (m_model) connect(m_model, &AdcModel::samplesChanged, this, &AdcScope::samplesChanged);
+  samplesChanged();
+  emit modelChanged();
+}
+
+void AdcScope::setChannel(int channel) {
+  if (m_channel == channel) return;
+  m_channel = channel;
+  update();
+  emit channelChanged();
+}
+
+void AdcScope::setSpanMs(double ms) {
+  ms = std::max(ms, 0.001);
+  if (m_spanMs == ms) return;
+  m_spanMs = ms;
+  update();
+  emit spanMsChanged();
+}
+
+void AdcScope::setEndMs(double ms) {
+  if (m_endMs == ms) return;
+  m_endMs = ms;
+  update();
+  emit endMsChanged();
+}
+
+void AdcScope::setFollow(bool follow) {
+  if (m_follow == follow) return;
+  m_follow = follow;
+  samplesChanged();
+  emit followChanged();
+}
+
+void AdcScope::setMinValue(double value) {
+  if (m_minValue == value) return;
+  m_minValue = value;
+  update();
+  emit minValueChanged();
+}
+
+void AdcScope::setMaxValue(double value) {
+  if (m_maxValue == value) return;
+  m_maxValue = value;
+  update();
+  emit maxValueChanged();
+}
+
+void AdcScope::setColor(const QColor &color) {
+  if (m_color == color) return;
+  m_color = color;
+  update();
+  emit colorChanged();
+}
+
+void AdcScope::samplesChanged() {
+  if (m_follow && m_model) setEndMs(m_model->lastTimeMs());
+  update();
+}
+
+// Render thread, GUI thread blocked
+QSGNode *AdcScope::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
+  auto *node = static_cast<QSGGeometryNode *>(oldNode);
+  if (!node) {
+    node = new QSGGeometryNode;
+    auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+    geometry->setLineWidth(1);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(new QSGFlatColorMaterial);
+    node->setFlag(QSGNode::OwnsMaterial);
+  }
+
+  auto *material = static_cast<QSGFlatColorMaterial *>(node->material());
+  if (material->color() != m_color) {
+    material->setColor(m_color);
+    node->markDirty(QSGNode::DirtyMaterial);
+  }
+
+  const double w = width();
+  const double h = height();
+  m_columns.clear();
+  if (m_model && w >= 1.0 && h >= 1.0) {
+    double endUs = std::max(m_endMs, 0.0) * 1000.0;
+    double fromUs = std::max(endUs - m_spanMs * 1000.0, 0.0);
+    m_model->history()->query(m_channel, static_cast<uint64_t>(fromUs), static_cast<uint64_t>(endUs),
+                              static_cast<size_t>(std::ceil(w)), m_columns);
+  }
+
+  // Two vertices per column, alternating min/max so consecutive columns
+  // join without crossing diagonals
+  QSGGeometry *geometry = node->geometry();
+  geometry->allocate(static_cast<int>(m_columns.size() * 2));
+  if (!m_columns.empty()) {
+    const double spanUs = m_spanMs * 1000.0;
+    const double fromUs = m_endMs * 1000.0 - spanUs;
+    const double range = m_maxValue - m_minValue;
+    auto y = [&](float v) {
+      double norm = range != 0.0 ? (static_cast<double>(v) - m_minValue) / range : 0.5;
+      return static_cast<float>(h - std::clamp(norm, 0.0, 1.0) * h);
+    };
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+      const auto &c = m_columns[i];
+      float x = static_cast<float>((static_cast<double>(c.timeUs) - fromUs) / spanUs * w);
+      bool up = (i % 2) == 0;
+      vertices[2 * i].set(x, y(up ? c.min : c.max));
+      vertices[2 * i + 1].set(x, y(up ? c.max : c.min));
+    }
+  }
+  node->markDirty(QSGNode::DirtyGeometry);
+  return node;
+}
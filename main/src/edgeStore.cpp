@@ -0,0 +1,517 @@
+// edgeStore.cpp
+#include "edgeStore.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+using namespace renode;
+
+namespace {
+
+// Undriven lines read as pulled up (open-drain buses, idle UART)
+bool isHigh(GpioState s) {
+  return s != GpioState::Low;
+}
+
+std::string hexByte(uint32_t value) {
+  char buf[8];
+  std::snprintf(buf, sizeof(buf), "0x%02X", value & 0xFFu);
+  return buf;
+}
+
+// ============================================================================
+// Decoders
+// ============================================================================
+
+class UartDecoder : public ProtocolDecoder {
+public:
+  UartDecoder(int channel, uint32_t baud)
+      : channel_(channel), bitUs_(1e6 / std::max<uint32_t>(baud, 1)) {}
+
+  void reset(const std::vector<GpioState> &levels) override {
+    high_ = channel_ < static_cast<int>(levels.size()) && isHigh(levels[channel_]);
+    busy_ = false;
+  }
+
+  void edge(int channel, GpioState state, uint64_t timeUs, const std::vector<GpioState> &,
+            std::vector<EdgeAnnotation> &out) override {
+    if (channel != channel_ || isHigh(state) == high_) return;
+    run(timeUs, out);
+    high_ = isHigh(state);
+    if (!busy_ && !high_) {
+      busy_ = true;
+      startUs_ = timeUs;
+      bit_ = 0;
+      data_ = 0;
+    }
+  }
+
+  void advance(uint64_t timeUs, std::vector<EdgeAnnotation> &out) override {
+    run(timeUs, out);
+  }
+
+private:
+  // Take every bit sample that falls before timeUs; the line has held its
+  // current level since the last edge
+  void run(uint64_t timeUs, std::vector<EdgeAnnotation> &out) {
+    while (busy_) {
+      double sampleUs = static_cast<double>(startUs_) + (bit_ + 0.5) * bitUs_;
+      if (sampleUs >= static_cast<double>(timeUs)) return;
+      if (bit_ == 0) {
+        if (high_) {  // glitch, not a start bit
+          busy_ = false;
+          return;
+        }
+      } else if (bit_ <= 8) {
+        if (high_) data_ |= 1u << (bit_ - 1);
+      } else {
+        std::string text = data_ >= 0x20 && data_ < 0x7F ? std::string(1, static_cast<char>(data_))
+                                                          : hexByte(data_);
+        if (!high_) text += " FE";  // stop bit low: framing error
+        out.push_back({startUs_, startUs_ + static_cast<uint64_t>(10 * bitUs_), 0, text});
+        busy_ = false;
+        return;
+      }
+      ++bit_;
+    }
+  }
+
+  int channel_;
+  double bitUs_;
+  bool high_ = true;
+  bool busy_ = false;
+  uint64_t startUs_ = 0;
+  int bit_ = 0;
+  uint32_t data_ = 0;
+};
+
+class SpiDecoder : public ProtocolDecoder {
+public:
+  SpiDecoder(int sck, int mosi, int miso, int cs, int mode)
+      : sck_(sck), mosi_(mosi), miso_(miso), cs_(cs),
+        // Leading edge for CPHA 0, trailing for CPHA 1; leading is rising for CPOL 0
+        sampleRising_(((mode >> 1) & 1) == (mode & 1)) {}
+
+  void reset(const std::vector<GpioState> &levels) override {
+    sckHigh_ = sck_ < static_cast<int>(levels.size()) && isHigh(levels[sck_]);
+    bits_ = 0;
+  }
+
+  void edge(int channel, GpioState state, uint64_t timeUs, const std::vector<GpioState> &levels,
+            std::vector<EdgeAnnotation> &out) override {
+    if (channel == cs_) {
+      bits_ = 0;  // word boundary whichever way chip select moved
+      return;
+    }
+    if (channel != sck_ || isHigh(state) == sckHigh_) return;
+    sckHigh_ = isHigh(state);
+    if (sckHigh_ != sampleRising_) return;
+    if (cs_ >= 0 && isHigh(levels[cs_])) return;
+
+    if (bits_ == 0) {
+      startUs_ = timeUs;
+      mosiByte_ = 0;
+      misoByte_ = 0;
+    }
+    mosiByte_ = (mosiByte_ << 1) | (isHigh(levels[mosi_]) ? 1u : 0u);
+    if (miso_ >= 0) misoByte_ = (misoByte_ << 1) | (isHigh(levels[miso_]) ? 1u : 0u);
+    if (++bits_ < 8) return;
+
+    std::string text = hexByte(mosiByte_);
+    if (miso_ >= 0) text += "/" + hexByte(misoByte_);
+    out.push_back({startUs_, timeUs, 0, text});
+    bits_ = 0;
+  }
+
+private:
+  int sck_, mosi_, miso_, cs_;
+  bool sampleRising_;
+  bool sckHigh_ = false;
+  int bits_ = 0;
+  uint32_t mosiByte_ = 0;
+  uint32_t misoByte_ = 0;
+  uint64_t startUs_ = 0;
+};
+
+class I2cDecoder : public ProtocolDecoder {
+public:
+  I2cDecoder(int scl, int sda) : scl_(scl), sda_(sda) {}
+
+  void reset(const std::vector<GpioState> &levels) override {
+    int n = static_cast<int>(levels.size());
+    sclHigh_ = scl_ < n && isHigh(levels[scl_]);
+    sdaHigh_ = sda_ < n && isHigh(levels[sda_]);
+    inFrame_ = false;
+    bits_ = 0;
+  }
+
+  void edge(int channel, GpioState state, uint64_t timeUs, const std::vector<GpioState> &,
+            std::vector<EdgeAnnotation> &out) override {
+    bool high = isHigh(state);
+    if (channel == sda_ && high != sdaHigh_) {
+      sdaHigh_ = high;
+      if (!sclHigh_) return;
+      // SDA moving while SCL is high: START (falling) or STOP (rising)
+      if (!high) {
+        out.push_back({timeUs, timeUs, 0, inFrame_ ? "Sr" : "S"});
+        inFrame_ = true;
+        addressNext_ = true;
+      } else {
+        out.push_back({timeUs, timeUs, 0, "P"});
+        inFrame_ = false;
+      }
+      bits_ = 0;
+      byte_ = 0;
+      return;
+    }
+    if (channel != scl_ || high == sclHigh_) return;
+    sclHigh_ = high;
+    if (!high || !inFrame_) return;
+
+    if (bits_ == 0) startUs_ = timeUs;
+    if (bits_ < 8) {
+      byte_ = (byte_ << 1) | (sdaHigh_ ? 1u : 0u);
+      ++bits_;
+      return;
+    }
+    // Ninth clock: receiver's ACK (low) or NAK
+    std::string text;
+    if (addressNext_) {
+      text = hexByte(byte_ >> 1) + ((byte_ & 1) ? " R" : " W");
+    } else {
+      text = hexByte(byte_);
+    }
+    text += sdaHigh_ ? " NAK" : " ACK";
+    out.push_back({startUs_, timeUs, 0, text});
+    addressNext_ = false;
+    bits_ = 0;
+    byte_ = 0;
+  }
+
+private:
+  int scl_, sda_;
+  bool sclHigh_ = true;
+  bool sdaHigh_ = true;
+  bool inFrame_ = false;
+  bool addressNext_ = false;
+  int bits_ = 0;
+  uint32_t byte_ = 0;
+  uint64_t startUs_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<ProtocolDecoder> makeUartDecoder(int channel, uint32_t baud) {
+  return std::make_unique<UartDecoder>(channel, baud);
+}
+
+std::unique_ptr<ProtocolDecoder> makeSpiDecoder(int sck, int mosi, int miso, int cs, int mode) {
+  return std::make_unique<SpiDecoder>(sck, mosi, miso, cs, mode);
+}
+
+std::unique_ptr<ProtocolDecoder> makeI2cDecoder(int scl, int sda) {
+  return std::make_unique<I2cDecoder>(scl, sda);
+}
+
+// ============================================================================
+// EdgeStore
+// ============================================================================
+
+EdgeStore::EdgeStore(int channels)
+    : m_channelCount(std::max(channels, 0)), m_channels(m_channelCount),
+      m_levels(m_channelCount, GpioState::Low) {}
+
+void EdgeStore::begin(int channel, GpioState state, uint64_t timeUs) {
+  if (channel < 0 || channel >= m_channelCount) return;
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    Channel &ch = m_channels[channel];
+    ch = Channel{};
+    ch.begun = true;
+    ch.startUs = timeUs;
+    ch.initial = ch.last = state;
+    ch.lastUs = timeUs;
+    m_levels[channel] = state;
+    m_lastUs = std::max(m_lastUs, timeUs);
+    for (auto &d : m_decoders) d.impl->reset(m_levels);
+  }
+  m_notifier.notify();
+}
+
+void EdgeStore::append(int channel, GpioState state, uint64_t timeUs) {
+  if (channel < 0 || channel >= m_channelCount) return;
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    Channel &ch = m_channels[channel];
+    if (!ch.begun) {
+      // No initial level known: the first event only establishes one
+      ch.begun = true;
+      ch.startUs = ch.lastUs = timeUs;
+      ch.initial = ch.last = state;
+      m_levels[channel] = state;
+      return;
+    }
+    if (state == ch.last) return;
+    timeUs = std::max(timeUs, ch.lastUs);
+    if (ch.last == GpioState::High) ch.highUs += timeUs - ch.lastUs;
+
+    if (ch.chunks.empty() || ch.chunks.back()->count == kChunkEdges ||
+        timeUs - ch.chunks.back()->baseUs > std::numeric_limits<uint32_t>::max()) {
+      auto chunk = std::make_unique<Chunk>();
+      chunk->baseUs = timeUs;
+      chunk->firstIndex = ch.edges;
+      chunk->highBeforeUs = ch.highUs;
+      ch.chunks.push_back(std::move(chunk));
+    }
+    Chunk &c = *ch.chunks.back();
+    uint32_t i = c.count++;
+    c.offsetUs[i] = static_cast<uint32_t>(timeUs - c.baseUs);
+    if (i % 64 == 0) c.coarseUs[i / 64] = c.offsetUs[i];
+    if (i % 32 == 0) c.states[i / 32] = 0;
+    c.states[i / 32] |= static_cast<uint64_t>(state) << (2 * (i % 32));
+
+    ++ch.edges;
+    ch.last = state;
+    ch.lastUs = timeUs;
+    m_levels[channel] = state;
+    m_lastUs = std::max(m_lastUs, timeUs);
+
+    for (size_t d = 0; d < m_decoders.size(); ++d) {
+      auto &ann = m_decoders[d].annotations;
+      size_t before = ann.size();
+      m_decoders[d].impl->edge(channel, state, timeUs, m_levels, ann);
+      for (size_t a = before; a < ann.size(); ++a) ann[a].decoder = static_cast<int>(d);
+    }
+  }
+  m_notifier.notify();
+}
+
+void EdgeStore::advance(uint64_t timeUs) {
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    m_lastUs = std::max(m_lastUs, timeUs);
+    for (size_t d = 0; d < m_decoders.size(); ++d) {
+      auto &ann = m_decoders[d].annotations;
+      size_t before = ann.size();
+      m_decoders[d].impl->advance(timeUs, ann);
+      for (size_t a = before; a < ann.size(); ++a) ann[a].decoder = static_cast<int>(d);
+    }
+  }
+  m_notifier.notify();
+}
+
+void EdgeStore::clear() {
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    for (auto &ch : m_channels) ch = Channel{};
+    std::fill(m_levels.begin(), m_levels.end(), GpioState::Low);
+    for (auto &d : m_decoders) {
+      d.annotations.clear();
+      d.impl->reset(m_levels);
+    }
+    m_lastUs = 0;
+  }
+  m_notifier.notify();
+}
+
+bool EdgeStore::timeRange(uint64_t &firstUs, uint64_t &lastUs) const {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  bool any = false;
+  for (const auto &ch : m_channels) {
+    if (!ch.begun) continue;
+    firstUs = any ? std::min(firstUs, ch.startUs) : ch.startUs;
+    any = true;
+  }
+  if (any) lastUs = m_lastUs;
+  return any;
+}
+
+uint64_t EdgeStore::edgeCount(int channel) const {
+  if (channel < 0 || channel >= m_channelCount) return 0;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  return m_channels[channel].edges;
+}
+
+// Two short searches instead of one over the whole chunk: a zoomed-out view
+// touches one chunk per pixel column, and this keeps it to a few cache lines
+uint32_t EdgeStore::Chunk::upperBound(uint32_t offset) const {
+  const uint32_t *coarseEnd = coarseUs + (count + 63) / 64;
+  uint32_t segment = static_cast<uint32_t>(std::upper_bound(coarseUs, coarseEnd, offset) - coarseUs);
+  if (segment == 0) return 0;
+  const uint32_t *first = offsetUs + (segment - 1) * 64;
+  const uint32_t *last = offsetUs + std::min(count, segment * 64);
+  return static_cast<uint32_t>(std::upper_bound(first, last, offset) - offsetUs);
+}
+
+uint64_t EdgeStore::indexAtLocked(const Channel &ch, uint64_t timeUs) const {
+  auto it = std::upper_bound(ch.chunks.begin(), ch.chunks.end(), timeUs,
+                             [](uint64_t t, const std::unique_ptr<Chunk> &c) { return t < c->baseUs; });
+  if (it == ch.chunks.begin()) return 0;
+  const Chunk &c = **(it - 1);
+  uint64_t offset = timeUs - c.baseUs;
+  if (offset > std::numeric_limits<uint32_t>::max()) return c.firstIndex + c.count;
+  return c.firstIndex + c.upperBound(static_cast<uint32_t>(offset));
+}
+
+GpioState EdgeStore::stateAfterLocked(const Channel &ch, uint64_t index) const {
+  if (index == 0 || ch.chunks.empty()) return ch.initial;
+  uint64_t edge = std::min(index, ch.edges) - 1;
+  auto it = std::upper_bound(ch.chunks.begin(), ch.chunks.end(), edge,
+                             [](uint64_t i, const std::unique_ptr<Chunk> &c) { return i < c->firstIndex; });
+  const Chunk &c = **(it - 1);
+  return c.state(static_cast<uint32_t>(edge - c.firstIndex));
+}
+
+uint64_t EdgeStore::edgeTimeLocked(const Channel &ch, uint64_t index) const {
+  auto it = std::upper_bound(ch.chunks.begin(), ch.chunks.end(), index,
+                             [](uint64_t i, const std::unique_ptr<Chunk> &c) { return i < c->firstIndex; });
+  const Chunk &c = **(it - 1);
+  return c.baseUs + c.offsetUs[index - c.firstIndex];
+}
+
+uint64_t EdgeStore::highUpToLocked(const Channel &ch, uint64_t timeUs) const {
+  if (!ch.begun || timeUs <= ch.startUs) return 0;
+  if (timeUs >= ch.lastUs) {
+    return ch.highUs + (ch.last == GpioState::High ? timeUs - ch.lastUs : 0);
+  }
+  auto it = std::upper_bound(ch.chunks.begin(), ch.chunks.end(), timeUs,
+                             [](uint64_t t, const std::unique_ptr<Chunk> &c) { return t < c->baseUs; });
+  if (it == ch.chunks.begin()) {
+    return ch.initial == GpioState::High ? timeUs - ch.startUs : 0;
+  }
+  // Walk the one chunk from its base up to timeUs
+  const Chunk &c = **(it - 1);
+  uint64_t high = c.highBeforeUs;
+  uint64_t prevUs = c.baseUs;
+  GpioState prev = c.state(0);
+  for (uint32_t i = 1; i < c.count; ++i) {
+    uint64_t t = c.baseUs + c.offsetUs[i];
+    if (t > timeUs) break;
+    if (prev == GpioState::High) high += t - prevUs;
+    prevUs = t;
+    prev = c.state(i);
+  }
+  if (prev == GpioState::High) high += timeUs - prevUs;
+  return high;
+}
+
+GpioState EdgeStore::levelAt(int channel, uint64_t timeUs) const {
+  if (channel < 0 || channel >= m_channelCount) return GpioState::Low;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  const Channel &ch = m_channels[channel];
+  return stateAfterLocked(ch, indexAtLocked(ch, timeUs));
+}
+
+uint64_t EdgeStore::edgesBetween(int channel, uint64_t fromUs, uint64_t toUs) const {
+  if (channel < 0 || channel >= m_channelCount || toUs <= fromUs) return 0;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  const Channel &ch = m_channels[channel];
+  return indexAtLocked(ch, toUs) - indexAtLocked(ch, fromUs);
+}
+
+uint64_t EdgeStore::highTimeBetween(int channel, uint64_t fromUs, uint64_t toUs) const {
+  if (channel < 0 || channel >= m_channelCount || toUs <= fromUs) return 0;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  const Channel &ch = m_channels[channel];
+  return highUpToLocked(ch, toUs) - highUpToLocked(ch, fromUs);
+}
+
+bool EdgeStore::nextEdge(int channel, uint64_t timeUs, uint64_t &edgeUs) const {
+  if (channel < 0 || channel >= m_channelCount) return false;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  const Channel &ch = m_channels[channel];
+  uint64_t index = indexAtLocked(ch, timeUs);
+  if (index >= ch.edges) return false;
+  edgeUs = edgeTimeLocked(ch, index);
+  return true;
+}
+
+bool EdgeStore::previousEdge(int channel, uint64_t timeUs, uint64_t &edgeUs) const {
+  if (channel < 0 || channel >= m_channelCount || timeUs == 0) return false;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  const Channel &ch = m_channels[channel];
+  uint64_t index = indexAtLocked(ch, timeUs - 1);
+  if (index == 0) return false;
+  edgeUs = edgeTimeLocked(ch, index - 1);
+  return true;
+}
+
+void EdgeStore::summarize(int channel, uint64_t fromUs, uint64_t toUs, int columns,
+                          std::vector<Column> &out) const {
+  out.clear();
+  if (channel < 0 || channel >= m_channelCount || columns <= 0 || toUs <= fromUs) return;
+  std::lock_guard<std::mutex> lk(m_mtx);
+  const Channel &ch = m_channels[channel];
+  out.reserve(columns);
+  double step = static_cast<double>(toUs - fromUs) / columns;
+  uint64_t index = indexAtLocked(ch, fromUs);
+  GpioState level = stateAfterLocked(ch, index);
+
+  // Walk forward: each column end is searched from the chunk holding the
+  // previous one, and the level entering a column is the one leaving the last
+  const auto &chunks = ch.chunks;
+  auto byBase = [](uint64_t t, const std::unique_ptr<Chunk> &c) { return t < c->baseUs; };
+  size_t k = std::upper_bound(chunks.begin(), chunks.end(), fromUs, byBase) - chunks.begin();
+  for (int c = 0; c < columns; ++c) {
+    uint64_t endUs = fromUs + static_cast<uint64_t>(step * (c + 1));
+    if (k < chunks.size() && chunks[k]->baseUs <= endUs) {
+      k = std::upper_bound(chunks.begin() + k, chunks.end(), endUs, byBase) - chunks.begin();
+    }
+    uint64_t next = 0;
+    GpioState endLevel = ch.initial;
+    if (k > 0) {
+      // Chunks with a base at or before endUs hold at least their first edge
+      const Chunk &chunk = *chunks[k - 1];
+      uint64_t offset = endUs - chunk.baseUs;
+      uint32_t pos = chunk.count;
+      if (offset < chunk.offsetUs[chunk.count - 1]) {
+        pos = chunk.upperBound(static_cast<uint32_t>(offset));
+      }
+      next = chunk.firstIndex + pos;
+      endLevel = chunk.state(pos - 1);
+    }
+    out.push_back({level, static_cast<uint32_t>(next - index)});
+    index = next;
+    level = endLevel;
+  }
+}
+
+int EdgeStore::addDecoder(std::unique_ptr<ProtocolDecoder> decoder) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  decoder->reset(m_levels);
+  m_decoders.push_back({std::move(decoder), {}});
+  return static_cast<int>(m_decoders.size()) - 1;
+}
+
+void EdgeStore::clearDecoders() {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  m_decoders.clear();
+}
+
+int EdgeStore::decoderCount() const {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  return static_cast<int>(m_decoders.size());
+}
+
+size_t EdgeStore::annotations(uint64_t fromUs, uint64_t toUs, size_t maxCount,
+                              std::vector<EdgeAnnotation> &out) const {
+  out.clear();
+  std::lock_guard<std::mutex> lk(m_mtx);
+  size_t total = 0;
+  for (const auto &d : m_decoders) {
+    // Each decoder's annotations are in time order and do not overlap
+    auto first = std::lower_bound(d.annotations.begin(), d.annotations.end(), fromUs,
+                                  [](const EdgeAnnotation &a, uint64_t t) { return a.endUs < t; });
+    auto last = std::upper_bound(first, d.annotations.end(), toUs,
+                                 [](uint64_t t, const EdgeAnnotation &a) { return t < a.startUs; });
+    total += static_cast<size_t>(last - first);
+    size_t take = std::min<size_t>(static_cast<size_t>(last - first), maxCount - std::min(maxCount, out.size()));
+    out.insert(out.end(), first, first + take);
+  }
+  return total;
+}
+
+void EdgeStore::setNotifier(std::function<void()> notify) {
+  m_notifier.set(std::move(notify));
+}
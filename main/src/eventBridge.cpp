@@ -0,0 +1,78 @@
+// eventBridge.cpp
+#include "eventBridge.hpp"
+
+#include <utility>
+
+EventBridge::EventBridge(size_t capacity, QObject *parent)
+    : QObject(parent), m_ring(capacity), m_throttle([this] { wake(); }) {}
+
+bool EventBridge::post(const SimEvent &event) noexcept {
+  bool stored = m_ring.push(event);
+  (stored ? m_posted : m_dropped).fetch_add(1, std::memory_order_relaxed);
+  m_throttle.request();
+  return stored;
+}
+
+uint32_t EventBridge::subscribe(Handler handler, FrameDone done) {
+  uint32_t sink = m_nextSink++;
+  m_sinks.emplace(sink, Sink{std::move(handler), std::move(done)});
+  return sink;
+}
+
+void EventBridge::unsubscribe(uint32_t sink) {
+  m_sinks.erase(sink);
+}
+
+void EventBridge::setWindow(QQuickWindow *window) {
+  if (m_window == window) return;
+  disconnect(m_frameConnection);
+  m_window = window;
+  if (m_window) {
+    m_frameConnection = connect(m_window, &QQuickWindow::afterAnimating, this, &EventBridge::drain);
+  }
+}
+
+EventBridge::Stats EventBridge::stats() const noexcept {
+  return {m_posted.load(std::memory_order_relaxed), m_dropped.load(std::memory_order_relaxed), m_delivered};
+}
+
+void EventBridge::setStatsListener(std::function<void()> listener) {
+  m_statsListener = std::move(listener);
+}
+
+// At most once per display frame (FrameThrottle): let the window's next
+// frame pick the events up, or drain right away if nothing will render
+void EventBridge::wake() {
+  if (m_window && m_window->isExposed()) {
+    m_window->update();
+  } else {
+    drain();
+  }
+}
+
+void EventBridge::drain() {
+  // Bounded to one ring's worth so a busy producer cannot starve the frame
+  Sink *last = nullptr;
+  uint32_t lastId = 0;
+  size_t count = m_ring.drain([&](const SimEvent &event) {
+    if (!last || lastId != event.sink) {
+      auto it = m_sinks.find(event.sink);
+      last = it == m_sinks.end() ? nullptr : &it->second;
+      lastId = event.sink;
+      if (!last) return;
+    }
+    last->delivered = true;
+    last->handler(event);
+  }, m_ring.capacity());
+
+  uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+  bool overflowed = dropped != m_droppedSeen;
+  m_droppedSeen = dropped;
+  for (auto &[id, sink] : m_sinks) {
+    if ((sink.delivered || overflowed) && sink.done) sink.done(overflowed);
+    sink.delivered = false;
+  }
+
+  m_delivered += count;
+  if ((count > 0 || overflowed) && m_statsListener) m_statsListener();
+}
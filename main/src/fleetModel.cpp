@@ -0,0 +1,629 @@
+// fleetModel.cpp
+#include "fleetModel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "machineFeed.hpp"
+#include "renodeInterface.h"
+#include "renodeMachine.h"
+
+using namespace renode;
+
+// ============================================================================
+// Backend feed (one poller thread per endpoint)
+// ============================================================================
+
+struct FleetSample {
+  std::string name;
+  FleetModel::MachineState state = FleetModel::Paused;
+  uint64_t simTimeUs = 0;
+  double realTimeFactor = 0.0;
+  std::string pins;
+  int highPins = 0;
+  std::string error;
+};
+
+// Every machine of one endpoint as of one poll
+struct FleetSnapshot {
+  int endpoint = 0;
+  std::vector<FleetSample> machines;
+};
+
+// Shared by the model and its pollers. Only the newest snapshot of each
+// endpoint is kept: a GUI that falls behind skips polls, it never queues them.
+struct FleetFeed {
+  std::mutex mtx;
+  std::condition_variable wake;
+  bool stopped = false;
+  std::vector<FleetSnapshot> outbox;
+  std::function<void()> notify;  // cleared before the model goes away
+  std::map<int, ExternalControlClient *> clients;  // connection in use per endpoint
+  std::vector<std::thread> pollers;  // GUI thread only
+
+  // Announce (or withdraw, nullptr) the connection a poller is using so
+  // stop() can interrupt a command blocked on it
+  void track(int endpoint, ExternalControlClient *client) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (client && stopped) client->interrupt();
+    clients[endpoint] = client;
+  }
+
+  void publish(FleetSnapshot snapshot) {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (stopped) return;
+    auto it = std::find_if(outbox.begin(), outbox.end(),
+                           [&](const FleetSnapshot &s) { return s.endpoint == snapshot.endpoint; });
+    if (it != outbox.end()) {
+      *it = std::move(snapshot);
+    } else {
+      outbox.push_back(std::move(snapshot));
+    }
+    if (notify) notify();
+  }
+
+  std::vector<FleetSnapshot> take() {
+    std::lock_guard<std::mutex> lk(mtx);
+    return std::exchange(outbox, {});
+  }
+
+  // False once stopped
+  bool sleepFor(std::chrono::milliseconds interval) {
+    std::unique_lock<std::mutex> lk(mtx);
+    return !wake.wait_for(lk, interval, [this] { return stopped; });
+  }
+
+  bool isStopped() {
+    std::lock_guard<std::mutex> lk(mtx);
+    return stopped;
+  }
+
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      stopped = true;
+      notify = nullptr;
+      for (auto &[endpoint, client] : clients) {
+        if (client) client->interrupt();
+      }
+    }
+    wake.notify_all();
+  }
+
+  // Stops the pollers and waits for them; a poller still establishing its
+  // connection exits once the attempt resolves
+  void join() {
+    stop();
+    for (std::thread &poller : pollers) {
+      if (poller.joinable()) poller.join();
+    }
+    pollers.clear();
+  }
+
+  ~FleetFeed() { join(); }
+};
+
+namespace {
+
+constexpr int kListEveryPolls = 10;  // machine discovery is a monitor round trip
+
+struct FleetEndpoint {
+  std::string host;
+  uint16_t port = 0;
+  uint16_t monitorPort = 0;
+  std::string socketPath;  // broker
+};
+
+struct FleetPin {
+  size_t port = 0;  // index into FleetPollConfig::ports
+  int pin = 0;
+  std::string label;
+};
+
+struct FleetPollConfig {
+  int index = 0;
+  std::string label;  // endpoint as configured, names its row when no machine is known
+  FleetEndpoint endpoint;
+  std::vector<std::string> machines;  // empty: discover
+  std::vector<std::string> ports;
+  std::vector<FleetPin> pins;
+  std::chrono::milliseconds interval{500};
+};
+
+bool parseEndpoint(const QString &text, FleetEndpoint &out) {
+  QString spec = text.trimmed();
+  if (spec.startsWith(QLatin1String("unix:"))) {
+    out.socketPath = spec.mid(5).toStdString();
+    return !out.socketPath.empty();
+  }
+  QString monitor;
+  int slash = spec.indexOf(QLatin1Char('/'));
+  if (slash >= 0) {
+    monitor = spec.mid(slash + 1);
+    spec.truncate(slash);
+  }
+  int colon = spec.lastIndexOf(QLatin1Char(':'));
+  bool ok = colon > 0;
+  uint port = ok ? spec.mid(colon + 1).toUInt(&ok) : 0;
+  if (!ok || port == 0 || port > 65534) return false;
+  out.host = spec.left(colon).toStdString();
+  out.port = static_cast<uint16_t>(port);
+  out.monitorPort = static_cast<uint16_t>(port + 1);
+  if (!monitor.isEmpty()) {
+    uint monitorPort = monitor.toUInt(&ok);
+    if (!ok || monitorPort == 0 || monitorPort > 65535) return false;
+    out.monitorPort = static_cast<uint16_t>(monitorPort);
+  }
+  return true;
+}
+
+std::unique_ptr<ExternalControlClient> connectEndpoint(const FleetPollConfig &config, std::string &error) {
+  const FleetEndpoint &endpoint = config.endpoint;
+  try {
+    auto client = endpoint.socketPath.empty() ? ExternalControlClient::connect(endpoint.host, endpoint.port)
+                                              : ExternalControlClient::connectUnix(endpoint.socketPath);
+    if (!client || !client->performHandshake()) {
+      error = "Handshake failed";
+      return nullptr;
+    }
+    // Optional when the machine list is configured, required to discover it
+    bool monitor = endpoint.socketPath.empty() && client->connectMonitor(endpoint.host, endpoint.monitorPort);
+    if (!monitor && config.machines.empty()) {
+      error = endpoint.socketPath.empty()
+                  ? "Monitor unreachable on " + endpoint.host + ":" + std::to_string(endpoint.monitorPort)
+                  : "No monitor through a broker; list the machines to poll";
+      return nullptr;
+    }
+    return client;
+  } catch (const std::exception &e) {
+    error = e.what();
+    return nullptr;
+  }
+}
+
+// Virtual time is emulation-wide (GET_TIME carries no machine id), so one
+// query per poll covers every machine of the instance; machines and GPIO
+// ports are resolved once and cached, leaving one round trip per pin
+void pollEndpoint(FleetFeed &feed, const FleetPollConfig &config) {
+  struct Tracked {
+    std::shared_ptr<AMachine> machine;
+    std::vector<std::shared_ptr<Gpio>> ports;
+  };
+
+  std::unique_ptr<ExternalControlClient> client;
+  std::map<std::string, Tracked> tracked;
+  std::vector<std::string> names = config.machines;
+  int sinceListing = kListEveryPolls;
+  bool sampled = false;
+  uint64_t lastSimUs = 0;
+  std::chrono::steady_clock::time_point lastWall;
+
+  // Nothing discovered yet: the endpoint itself is the row
+  auto unreachable = [&](const std::string &error) {
+    FleetSnapshot snapshot{config.index, {}};
+    for (const std::string &name : names) {
+      snapshot.machines.push_back({name, FleetModel::Unreachable, 0, 0.0, {}, 0, error});
+    }
+    if (names.empty()) snapshot.machines.push_back({config.label, FleetModel::Unreachable, 0, 0.0, {}, 0, error});
+    feed.publish(std::move(snapshot));
+  };
+
+  while (!feed.isStopped()) {
+    if (!client) {
+      std::string error;
+      client = connectEndpoint(config, error);
+      tracked.clear();
+      sinceListing = kListEveryPolls;
+      sampled = false;
+      if (!client) {
+        unreachable(error);
+        if (!feed.sleepFor(config.interval)) break;
+        continue;
+      }
+      feed.track(config.index, client.get());
+    }
+
+    Error err;
+    if (config.machines.empty() && ++sinceListing >= kListEveryPolls) {
+      auto listed = client->listMachines();
+      err = listed.error;
+      if (!err) {
+        names = std::move(listed.value);
+        sinceListing = 0;
+        for (auto it = tracked.begin(); it != tracked.end();) {
+          it = std::find(names.begin(), names.end(), it->first) == names.end() ? tracked.erase(it) : std::next(it);
+        }
+      }
+    }
+    std::optional<uint64_t> simUs;
+    if (!err) simUs = client->getCurrentTimeMicroseconds(err);
+    if (!simUs) {
+      feed.track(config.index, nullptr);
+      client.reset();  // reconnect on the next poll
+      unreachable(err.message);
+      if (!feed.sleepFor(config.interval)) break;
+      continue;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    FleetModel::MachineState state = FleetModel::Paused;
+    double realTimeFactor = 0.0;
+    if (sampled && *simUs >= lastSimUs) {
+      double wallUs = std::chrono::duration<double, std::micro>(now - lastWall).count();
+      realTimeFactor = wallUs > 0.0 ? static_cast<double>(*simUs - lastSimUs) / wallUs : 0.0;
+      if (*simUs > lastSimUs) state = FleetModel::Running;
+    }
+    sampled = true;
+    lastSimUs = *simUs;
+    lastWall = now;
+
+    FleetSnapshot snapshot{config.index, {}};
+    snapshot.machines.reserve(names.size());
+    for (const std::string &name : names) {
+      FleetSample sample{name, state, *simUs, realTimeFactor};
+      Tracked &t = tracked[name];
+      if (!t.machine) {
+        t.machine = client->getMachine(name, err);
+        t.ports.assign(config.ports.size(), nullptr);
+        if (!t.machine) {
+          sample.state = FleetModel::Unreachable;
+          sample.error = err.message;
+          snapshot.machines.push_back(std::move(sample));
+          continue;
+        }
+      }
+      for (const FleetPin &pin : config.pins) {
+        auto &gpio = t.ports[pin.port];
+        if (!gpio) gpio = t.machine->getGpio(config.ports[pin.port], err);
+        GpioState level = GpioState::Low;
+        if (!gpio || gpio->getState(pin.pin, level)) continue;
+        if (!sample.pins.empty()) sample.pins += ' ';
+        sample.pins += pin.label;
+        sample.pins += level == GpioState::High ? "=1" : level == GpioState::HighZ ? "=Z" : "=0";
+        if (level == GpioState::High) ++sample.highPins;
+      }
+      snapshot.machines.push_back(std::move(sample));
+    }
+
+    feed.publish(std::move(snapshot));
+    if (!feed.sleepFor(config.interval)) break;
+  }
+  feed.track(config.index, nullptr);
+}
+
+} // namespace
+
+// ============================================================================
+// FleetModel
+// ============================================================================
+
+namespace {
+
+enum ChangedRoles : uint8_t {
+  StateChanged = 1 << 0,
+  TimeChanged = 1 << 1,
+  PinsChanged = 1 << 2,
+  ErrorChanged = 1 << 3,
+};
+
+} // namespace
+
+FleetModel::FleetModel(QObject *parent) : QAbstractListModel(parent), m_throttle([this] { flush(); }) {}
+
+FleetModel::~FleetModel() {
+  detach();
+}
+
+void FleetModel::setEndpoints(const QStringList &endpoints) {
+  if (m_endpoints == endpoints) return;
+  m_endpoints = endpoints;
+  rebuild();
+  emit endpointsChanged();
+}
+
+void FleetModel::setMachines(const QStringList &machines) {
+  if (m_machines == machines) return;
+  m_machines = machines;
+  rebuild();
+  emit machinesChanged();
+}
+
+void FleetModel::setPins(const QStringList &pins) {
+  if (m_pins == pins) return;
+  m_pins = pins;
+  rebuild();
+  emit pinsChanged();
+}
+
+void FleetModel::setPollIntervalMs(int ms) {
+  ms = std::clamp(ms, 50, 60000);
+  if (m_pollIntervalMs == ms) return;
+  m_pollIntervalMs = ms;
+  rebuild();
+  emit pollIntervalMsChanged();
+}
+
+void FleetModel::rebuild() {
+  detach();
+  beginResetModel();
+  m_rows.clear();
+  m_index.clear();
+  endResetModel();
+  m_running = 0;
+  m_unreachable = 0;
+  emit countsChanged();
+  attach();
+}
+
+// One poller thread per endpoint, owning its connection. detach() joins
+// them, interrupting any command blocked on an unresponsive instance.
+void FleetModel::attach() {
+  if (m_endpoints.isEmpty()) return;
+  auto feed = std::make_shared<FleetFeed>();
+  feed->notify = [throttle = &m_throttle] { throttle->request(); };
+  m_feed = feed;
+
+  FleetPollConfig base;
+  base.interval = std::chrono::milliseconds(m_pollIntervalMs);
+  for (const QString &machine : m_machines) base.machines.push_back(machine.trimmed().toStdString());
+  for (const QString &spec : m_pins) {
+    int colon = spec.lastIndexOf(QLatin1Char(':'));
+    bool ok = colon > 0;
+    int pin = ok ? spec.mid(colon + 1).toInt(&ok) : 0;
+    if (!ok || pin < 0) continue;
+    std::string port = spec.left(colon).trimmed().toStdString();
+    auto it = std::find(base.ports.begin(), base.ports.end(), port);
+    if (it == base.ports.end()) it = base.ports.insert(base.ports.end(), port);
+    base.pins.push_back({static_cast<size_t>(it - base.ports.begin()), pin, pinLabel(port, pin)});
+  }
+
+  for (int i = 0; i < m_endpoints.size(); ++i) {
+    FleetPollConfig config = base;
+    config.index = i;
+    config.label = m_endpoints.at(i).trimmed().toStdString();
+    if (!parseEndpoint(m_endpoints.at(i), config.endpoint)) {
+      FleetSnapshot invalid{i, {}};
+      invalid.machines.push_back({m_endpoints.at(i).toStdString(), Unreachable, 0, 0.0, {}, 0, "Invalid endpoint"});
+      feed->publish(std::move(invalid));
+      continue;
+    }
+    feed->pollers.emplace_back([feed = feed.get(), config = std::move(config)] { pollEndpoint(*feed, config); });
+  }
+}
+
+void FleetModel::detach() {
+  if (m_feed) m_feed->join();
+  m_feed.reset();
+}
+
+QString FleetModel::keyOf(int endpoint, const QString &name) {
+  return QString::number(endpoint) + QLatin1Char('\n') + name;
+}
+
+// Runs at most once per display frame (FrameThrottle)
+void FleetModel::flush() {
+  if (!m_feed) return;
+  for (FleetSnapshot &snapshot : m_feed->take()) merge(snapshot);
+
+  int running = 0, unreachable = 0;
+  for (const Row &row : m_rows) {
+    running += row.state == Running;
+    unreachable += row.state == Unreachable;
+  }
+  if (running != m_running || unreachable != m_unreachable) {
+    m_running = running;
+    m_unreachable = unreachable;
+    emit countsChanged();
+  }
+}
+
+void FleetModel::merge(FleetSnapshot &snapshot) {
+  std::vector<uint8_t> changed(m_rows.size(), 0);
+  std::vector<uint8_t> seen(m_rows.size(), 0);
+  std::vector<Row> added;
+
+  for (FleetSample &sample : snapshot.machines) {
+    QString name = QString::fromStdString(sample.name);
+    Row fresh{snapshot.endpoint,
+              name,
+              sample.state,
+              sample.simTimeUs,
+              sample.realTimeFactor,
+              QString::fromStdString(sample.pins),
+              sample.highPins,
+              QString::fromStdString(sample.error)};
+    auto it = m_index.constFind(keyOf(snapshot.endpoint, name));
+    if (it == m_index.constEnd()) {
+      added.push_back(std::move(fresh));
+      continue;
+    }
+    int row = it.value();
+    seen[row] = 1;
+    Row &current = m_rows[row];
+    // An unreachable machine keeps its last readings
+    if (fresh.state == Unreachable) {
+      fresh.simTimeUs = current.simTimeUs;
+      fresh.pins = current.pins;
+      fresh.highPins = current.highPins;
+    }
+    uint8_t mask = 0;
+    if (current.state != fresh.state) mask |= StateChanged;
+    if (current.simTimeUs != fresh.simTimeUs || current.realTimeFactor != fresh.realTimeFactor) mask |= TimeChanged;
+    if (current.pins != fresh.pins || current.highPins != fresh.highPins) mask |= PinsChanged;
+    if (current.error != fresh.error) mask |= ErrorChanged;
+    if (mask) current = std::move(fresh);
+    changed[row] = mask;
+  }
+
+  emitChanged(changed);
+
+  // Machines the instance no longer lists, removed in contiguous runs
+  bool removed = false;
+  for (int last = static_cast<int>(m_rows.size()) - 1; last >= 0;) {
+    if (m_rows[last].endpoint != snapshot.endpoint || seen[last]) {
+      --last;
+      continue;
+    }
+    int first = last;
+    while (first > 0 && m_rows[first - 1].endpoint == snapshot.endpoint && !seen[first - 1]) --first;
+    beginRemoveRows({}, first, last);
+    m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+    endRemoveRows();
+    removed = true;
+    last = first - 1;
+  }
+  if (removed) reindex();
+
+  if (!added.empty()) {
+    int first = static_cast<int>(m_rows.size());
+    beginInsertRows({}, first, first + static_cast<int>(added.size()) - 1);
+    for (Row &row : added) {
+      m_index.insert(keyOf(row.endpoint, row.name), static_cast<int>(m_rows.size()));
+      m_rows.push_back(std::move(row));
+    }
+    endInsertRows();
+  }
+}
+
+// One dataChanged() per run of consecutive rows with the same changed roles
+void FleetModel::emitChanged(const std::vector<uint8_t> &changed) {
+  auto rolesOf = [](uint8_t mask) {
+    QList<int> roles;
+    if (mask & StateChanged) roles << StateRole;
+    if (mask & TimeChanged) roles << SimTimeMsRole << RealTimeFactorRole;
+    if (mask & PinsChanged) roles << PinsRole << HighPinsRole;
+    if (mask & ErrorChanged) roles << ErrorRole;
+    return roles;
+  };
+  size_t rows = changed.size();
+  for (size_t first = 0; first < rows;) {
+    uint8_t mask = changed[first];
+    size_t last = first;
+    while (last + 1 < rows && changed[last + 1] == mask) ++last;
+    if (mask) emit dataChanged(index(static_cast<int>(first)), index(static_cast<int>(last)), rolesOf(mask));
+    first = last + 1;
+  }
+}
+
+void FleetModel::reindex() {
+  m_index.clear();
+  m_index.reserve(static_cast<qsizetype>(m_rows.size()));
+  for (size_t i = 0; i < m_rows.size(); ++i) {
+    m_index.insert(keyOf(m_rows[i].endpoint, m_rows[i].name), static_cast<int>(i));
+  }
+}
+
+int FleetModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid()) return 0;
+  return static_cast<int>(m_rows.size());
+}
+
+QVariant FleetModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= static_cast<int>(m_rows.size())) return {};
+  const Row &row = m_rows[index.row()];
+  switch (role) {
+  case InstanceRole: return m_endpoints.value(row.endpoint);
+  case Qt::DisplayRole:
+  case NameRole: return row.name;
+  case StateRole: return static_cast<int>(row.state);
+  case SimTimeMsRole: return static_cast<double>(row.simTimeUs) / 1000.0;
+  case RealTimeFactorRole: return row.realTimeFactor;
+  case PinsRole: return row.pins;
+  case HighPinsRole: return row.highPins;
+  case ErrorRole: return row.error;
+  default: return {};
+  }
+}
+
+QHash<int, QByteArray> FleetModel::roleNames() const {
+  return {
+      {InstanceRole, "instance"},
+      {NameRole, "name"},
+      {StateRole, "machineState"},
+      {SimTimeMsRole, "simTimeMs"},
+      {RealTimeFactorRole, "realTimeFactor"},
+      {PinsRole, "pins"},
+      {HighPinsRole, "highPins"},
+      {ErrorRole, "error"},
+  };
+}
+
+// ============================================================================
+// FleetProxyModel
+// ============================================================================
+
+FleetProxyModel::FleetProxyModel(QObject *parent) : QSortFilterProxyModel(parent) {
+  m_collator.setNumericMode(true);
+  m_collator.setCaseSensitivity(Qt::CaseInsensitive);
+  setDynamicSortFilter(true);
+  auto notifyCount = [this] { emit countChanged(); };
+  connect(this, &QAbstractItemModel::rowsInserted, this, notifyCount);
+  connect(this, &QAbstractItemModel::rowsRemoved, this, notifyCount);
+  connect(this, &QAbstractItemModel::modelReset, this, notifyCount);
+  connect(this, &QAbstractItemModel::layoutChanged, this, notifyCount);
+}
+
+void FleetProxyModel::setSortBy(const QString &role) {
+  if (m_sortBy == role) return;
+  m_sortBy = role;
+  applySort();
+  emit sortByChanged();
+}
+
+void FleetProxyModel::setDescending(bool descending) {
+  if (m_descending == descending) return;
+  m_descending = descending;
+  applySort();
+  emit descendingChanged();
+}
+
+void FleetProxyModel::setFilterText(const QString &text) {
+  if (m_filterText == text) return;
+  m_filterText = text;
+  invalidateFilter();
+  emit filterTextChanged();
+}
+
+void FleetProxyModel::setStateFilter(int state) {
+  if (m_stateFilter == state) return;
+  m_stateFilter = state;
+  invalidateFilter();
+  emit stateFilterChanged();
+}
+
+void FleetProxyModel::setSourceModel(QAbstractItemModel *model) {
+  QSortFilterProxyModel::setSourceModel(model);
+  applySort();
+}
+
+// Resolved by name so QML can say sortBy: "simTimeMs"
+void FleetProxyModel::applySort() {
+  QAbstractItemModel *model = sourceModel();
+  if (!model) return;
+  int role = model->roleNames().key(m_sortBy.toUtf8(), FleetModel::NameRole);
+  setSortRole(role);
+  sort(0, m_descending ? Qt::DescendingOrder : Qt::AscendingOrder);
+}
+
+bool FleetProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+  QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
+  if (m_stateFilter >= 0 && index.data(FleetModel::StateRole).toInt() != m_stateFilter) return false;
+  if (m_filterText.isEmpty()) return true;
+  return index.data(FleetModel::NameRole).toString().contains(m_filterText, Qt::CaseInsensitive) ||
+         index.data(FleetModel::InstanceRole).toString().contains(m_filterText, Qt::CaseInsensitive);
+}
+
+bool FleetProxyModel::lessThan(const QModelIndex &left, const QModelIndex &right) const {
+  QVariant l = left.data(sortRole());
+  QVariant r = right.data(sortRole());
+  if (l.typeId() == QMetaType::QString) return m_collator.compare(l.toString(), r.toString()) < 0;
+  return QVariant::compare(l, r) == QPartialOrdering::Less;
+}
@@ -0,0 +1,37 @@
+// frameThrottle.cpp
+#include "frameThrottle.hpp"
+
+#include <QGuiApplication>
+#include <QScreen>
+
+#include <algorithm>
+#include <cmath>
+
+FrameThrottle::FrameThrottle(std::function<void()> flush, QObject *parent)
+    : QObject(parent), m_flush(std::move(flush)) {
+  m_timer.setSingleShot(true);
+  m_timer.setTimerType(Qt::PreciseTimer);
+  connect(&m_timer, &QTimer::timeout, this, &FrameThrottle::fire);
+  m_sinceFlush.start();
+}
+
+void FrameThrottle::request() {
+  if (m_pending.load(std::memory_order_relaxed) || m_pending.exchange(true)) return;
+  QMetaObject::invokeMethod(this, &FrameThrottle::schedule, Qt::QueuedConnection);
+}
+
+void FrameThrottle::schedule() {
+  if (m_timer.isActive()) return;
+  double hz = 60.0;
+  if (QScreen *screen = QGuiApplication::primaryScreen()) {
+    hz = std::max(screen->refreshRate(), 1.0);
+  }
+  qint64 frameMs = static_cast<qint64>(std::lround(1000.0 / hz));
+  m_timer.start(static_cast<int>(std::max<qint64>(0, frameMs - m_sinceFlush.elapsed())));
+}
+
+void FrameThrottle::fire() {
+  m_pending = false;
+  m_sinceFlush.restart();
+  m_flush();
+}
@@ -0,0 +1,303 @@
+// gpioModel.cpp
+#include "gpioModel.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <string>
+#include <utility>
+
+using namespace renode;
+
+// ============================================================================
+// GpioPinTable
+// ============================================================================
+
+GpioPinTable::GpioPinTable(int pins)
+    : m_pins(pins),
+      m_states(new std::atomic<uint32_t>[(pins + kStatesPerWord - 1) / kStatesPerWord]),
+      m_toggles(new std::atomic<uint32_t>[pins]),
+      m_lastEdgeUs(new std::atomic<uint64_t>[pins]),
+      m_dirty(new std::atomic<uint64_t>[(pins + 63) / 64]),
+      m_dirtyWords((pins + 63) / 64) {
+  for (int i = 0; i < (pins + kStatesPerWord - 1) / kStatesPerWord; ++i) m_states[i] = 0;
+  for (int i = 0; i < pins; ++i) {
+    m_toggles[i] = 0;
+    m_lastEdgeUs[i] = 0;
+  }
+  for (size_t i = 0; i < m_dirtyWords; ++i) m_dirty[i] = 0;
+}
+
+GpioState GpioPinTable::state(int row) const noexcept {
+  uint32_t word = m_states[row / kStatesPerWord].load(std::memory_order_relaxed);
+  return static_cast<GpioState>((word >> (2 * (row % kStatesPerWord))) & 3u);
+}
+
+uint32_t GpioPinTable::toggles(int row) const noexcept {
+  return m_toggles[row].load(std::memory_order_relaxed);
+}
+
+uint64_t GpioPinTable::lastEdgeUs(int row) const noexcept {
+  return m_lastEdgeUs[row].load(std::memory_order_relaxed);
+}
+
+void GpioPinTable::set(int row, GpioState state, uint64_t timestampUs, bool countEdge) noexcept {
+  if (row < 0 || row >= m_pins) return;
+  // Single writer: plain read-modify-write, readers only ever see whole words
+  auto &word = m_states[row / kStatesPerWord];
+  int shift = 2 * (row % kStatesPerWord);
+  uint32_t old = word.load(std::memory_order_relaxed);
+  uint32_t next = (old & ~(3u << shift)) | (static_cast<uint32_t>(state) << shift);
+  if (next == old) return;
+  word.store(next, std::memory_order_relaxed);
+  if (countEdge) {
+    m_toggles[row].fetch_add(1, std::memory_order_relaxed);
+    m_lastEdgeUs[row].store(timestampUs, std::memory_order_relaxed);
+  }
+
+  m_dirty[row / 64].fetch_or(uint64_t(1) << (row % 64), std::memory_order_release);
+}
+
+void GpioPinTable::takeDirty(const std::function<void(int first, int last)> &emitRange) {
+  int runStart = -1;
+  int runEnd = -2;
+  for (size_t w = 0; w < m_dirtyWords; ++w) {
+    uint64_t bits = m_dirty[w].exchange(0, std::memory_order_acquire);
+    while (bits) {
+      int row = static_cast<int>(w * 64) + std::countr_zero(bits);
+      bits &= bits - 1;
+      if (row != runEnd + 1) {
+        if (runStart >= 0) emitRange(runStart, runEnd);
+        runStart = row;
+      }
+      runEnd = row;
+    }
+  }
+  if (runStart >= 0) emitRange(runStart, runEnd);
+}
+
+// ============================================================================
+// Backend feed (worker thread)
+// ============================================================================
+
+// Subscribes every pin of every port to the bridge while a machine is attached
+struct GpioFeed {
+  EventBridge *bridge = nullptr;
+  uint32_t sink = 0;
+  std::vector<std::string> ports;
+  int pinsPerPort = 0;
+  GpioListeners listeners;
+  std::vector<std::shared_ptr<Gpio>> byPort;  // null where the port is missing
+
+  void attach(const std::shared_ptr<AMachine> &machine) {
+    byPort.assign(ports.size(), nullptr);
+    for (size_t p = 0; p < ports.size(); ++p) {
+      auto gpio = listeners.port(machine, ports[p]);
+      if (!gpio) continue;
+      byPort[p] = gpio;
+      int base = static_cast<int>(p) * pinsPerPort;
+      for (int pin = 0; pin < pinsPerPort; ++pin) {
+        auto cb = [bridge = bridge, sink = sink, row = base + pin](int, GpioState s, uint64_t timestampUs) {
+          bridge->post({sink, SimEvent::Kind::GpioEdge, static_cast<uint8_t>(s), 0, row, timestampUs});
+        };
+        listeners.listen(gpio, pin, GpioEventCallback(cb));
+      }
+    }
+    readBack();
+  }
+
+  // Current level of every pin after attaching, in order with the edges
+  void readBack() {
+    for (size_t p = 0; p < byPort.size(); ++p) {
+      if (!byPort[p]) continue;
+      int base = static_cast<int>(p) * pinsPerPort;
+      for (int pin = 0; pin < pinsPerPort; ++pin) {
+        GpioState state = GpioState::Low;
+        if (byPort[p]->getState(pin, state)) continue;
+        bridge->post({sink, SimEvent::Kind::GpioLevel, static_cast<uint8_t>(state), 0, base + pin});
+      }
+    }
+  }
+
+  // Read-back after the bridge dropped edges. Posting one event per pin
+  // would refill the ring that just overflowed, so the levels are parked
+  // here behind a single marker event for no row; the model applies them
+  // when it drains the marker, in stream order with the edges around it.
+  std::mutex levelsMtx;
+  std::vector<std::pair<int, GpioState>> levels;
+  bool markerLost = false;  // the ring was still full; read again
+
+  void readLevels() {
+    std::vector<std::pair<int, GpioState>> read;
+    for (size_t p = 0; p < byPort.size(); ++p) {
+      if (!byPort[p]) continue;
+      int base = static_cast<int>(p) * pinsPerPort;
+      for (int pin = 0; pin < pinsPerPort; ++pin) {
+        GpioState state = GpioState::Low;
+        if (!byPort[p]->getState(pin, state)) read.emplace_back(base + pin, state);
+      }
+    }
+    std::lock_guard<std::mutex> lk(levelsMtx);
+    levels = std::move(read);
+    if (!bridge->post({sink, SimEvent::Kind::GpioLevel, 0, 0, -1})) markerLost = true;
+  }
+
+  // GUI thread, as the marker is drained
+  void applyLevels(GpioPinTable &table) {
+    std::lock_guard<std::mutex> lk(levelsMtx);
+    for (const auto &[row, state] : levels) table.set(row, state, 0, false);
+    levels.clear();
+  }
+
+  bool takeMarkerLost() {
+    std::lock_guard<std::mutex> lk(levelsMtx);
+    return std::exchange(markerLost, false);
+  }
+
+  void detach() {
+    listeners.clear();
+    byPort.clear();
+  }
+
+  void setState(size_t port, int pin, GpioState state) {
+    if (port < byPort.size() && byPort[port]) byPort[port]->setState(pin, state);
+  }
+};
+
+// ============================================================================
+// GpioModel
+// ============================================================================
+
+GpioModel::GpioModel(QObject *parent) : QAbstractListModel(parent) {
+  for (char c = 'A'; c <= 'K'; ++c) {
+    m_ports.append(QStringLiteral("sysbus.gpioPort%1").arg(QLatin1Char(c)));
+  }
+  rebuild();
+}
+
+GpioModel::~GpioModel() {
+  detach();
+}
+
+void GpioModel::setController(SimulationController *controller) {
+  if (m_controller == controller) return;
+  detach();
+  m_controller = controller;
+  attach();
+  emit controllerChanged();
+}
+
+void GpioModel::setPorts(const QStringList &ports) {
+  if (m_ports == ports) return;
+  m_ports = ports;
+  rebuild();
+  emit portsChanged();
+}
+
+void GpioModel::setPinsPerPort(int pins) {
+  pins = std::clamp(pins, 1, 16);
+  if (m_pinsPerPort == pins) return;
+  m_pinsPerPort = pins;
+  rebuild();
+  emit pinsPerPortChanged();
+}
+
+void GpioModel::rebuild() {
+  detach();
+  beginResetModel();
+  m_labels.clear();
+  for (const QString &port : m_ports) {
+    const std::string path = port.toStdString();
+    for (int pin = 0; pin < m_pinsPerPort; ++pin) m_labels.append(QString::fromStdString(pinLabel(path, pin)));
+  }
+  m_table = std::make_shared<GpioPinTable>(static_cast<int>(m_labels.size()));
+  endResetModel();
+  attach();
+}
+
+void GpioModel::attach() {
+  if (!m_controller) return;
+  auto feed = std::make_shared<GpioFeed>();
+  m_sink = m_controller->events()->subscribe(
+      [this, table = m_table, feed](const SimEvent &event) {
+        if (event.index < 0) {  // overflow read-back marker
+          feed->applyLevels(*table);
+          m_readBackPending = false;
+          return;
+        }
+        table->set(event.index, static_cast<GpioState>(event.state), event.timeUs,
+                   event.kind == SimEvent::Kind::GpioEdge);
+      },
+      [this](bool overflowed) { flush(overflowed); });
+
+  feed->bridge = m_controller->events();
+  feed->sink = m_sink;
+  feed->pinsPerPort = m_pinsPerPort;
+  for (const QString &port : m_ports) feed->ports.push_back(port.toStdString());
+  m_feed = feed;
+  m_link.observe(m_controller, feed);
+}
+
+// The bridge discards whatever the feed still posts for a sink that is gone
+void GpioModel::detach() {
+  if (m_controller && m_sink) m_controller->events()->unsubscribe(m_sink);
+  m_link.release();
+  m_feed.reset();
+  m_sink = 0;
+  m_readBackPending = false;
+}
+
+void GpioModel::setPinState(int row, int state) {
+  if (!m_controller || !m_feed || row < 0 || row >= rowCount() || state < 0 || state > 1) return;
+  m_controller->withMachine([feed = m_feed, port = static_cast<size_t>(row / m_pinsPerPort),
+                             pin = row % m_pinsPerPort, state](const std::shared_ptr<AMachine> &) {
+    feed->setState(port, pin, static_cast<GpioState>(state));
+  });
+}
+
+int GpioModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid()) return 0;
+  return static_cast<int>(m_labels.size());
+}
+
+QVariant GpioModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= m_labels.size()) return {};
+  int row = index.row();
+  switch (role) {
+  case PortRole: return m_ports.at(row / m_pinsPerPort);
+  case PinRole: return row % m_pinsPerPort;
+  case Qt::DisplayRole:
+  case LabelRole: return m_labels.at(row);
+  case StateRole: return static_cast<int>(m_table->state(row));
+  case TogglesRole: return static_cast<quint32>(m_table->toggles(row));
+  case LastEdgeUsRole: return static_cast<qulonglong>(m_table->lastEdgeUs(row));
+  default: return {};
+  }
+}
+
+QHash<int, QByteArray> GpioModel::roleNames() const {
+  return {
+      {PortRole, "port"},
+      {PinRole, "pin"},
+      {LabelRole, "label"},
+      {StateRole, "pinState"},
+      {TogglesRole, "toggles"},
+      {LastEdgeUsRole, "lastEdgeUs"},
+  };
+}
+
+// Runs at most once per display frame (EventBridge drain)
+void GpioModel::flush(bool overflowed) {
+  static const QList<int> roles{StateRole, TogglesRole, LastEdgeUsRole};
+  m_table->takeDirty([this](int first, int last) {
+    emit dataChanged(index(first), index(last), roles);
+  });
+  // Edges were lost: levels may be stale, so read every pin back. One
+  // read-back at a time however long the bridge stays saturated, unless
+  // its marker was itself dropped.
+  if (overflowed && m_readBackPending && m_feed && m_feed->takeMarkerLost()) m_readBackPending = false;
+  if (overflowed && !m_readBackPending && m_controller && m_feed) {
+    m_readBackPending = true;
+    m_controller->withMachine([feed = m_feed](const std::shared_ptr<AMachine> &) { feed->readLevels(); });
+  }
+}
@@ -0,0 +1,214 @@
+// logicAnalyzer.cpp
+#include "logicAnalyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace renode;
+
+namespace {
+
+uint64_t toUs(double ms) {
+  return ms > 0.0 ? static_cast<uint64_t>(std::llround(ms * 1000.0)) : 0;
+}
+
+// Records the probed pins while a machine is attached (worker thread)
+struct EdgeFeed {
+  struct Probe {
+    std::string path;
+    int pin = -1;
+  };
+
+  std::shared_ptr<EdgeStore> store;
+  std::vector<Probe> probes;
+  GpioListeners listeners;
+
+  void attach(const std::shared_ptr<AMachine> &machine) {
+    store->clear();
+    uint64_t now = machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+    for (size_t i = 0; i < probes.size(); ++i) {
+      const Probe &probe = probes[i];
+      if (probe.pin < 0) continue;
+      auto gpio = listeners.port(machine, probe.path);
+      if (!gpio) continue;
+
+      GpioState state = GpioState::Low;
+      if (!gpio->getState(probe.pin, state)) store->begin(static_cast<int>(i), state, now);
+      auto cb = [store = store, channel = static_cast<int>(i)](int, GpioState s, uint64_t timestampUs) {
+        store->append(channel, s, timestampUs);
+      };
+      listeners.listen(gpio, probe.pin, GpioEventCallback(cb));
+    }
+  }
+
+  void detach() { listeners.clear(); }
+
+  void advance(uint64_t simTimeUs) { store->advance(simTimeUs); }
+};
+
+} // namespace
+
+LogicAnalyzer::LogicAnalyzer(QObject *parent)
+    : QAbstractListModel(parent), m_throttle([this] { flush(); }) {
+  rebuild();
+}
+
+LogicAnalyzer::~LogicAnalyzer() {
+  detach();
+}
+
+void LogicAnalyzer::setController(SimulationController *controller) {
+  if (m_controller == controller) return;
+  detach();
+  m_controller = controller;
+  attach();
+  emit controllerChanged();
+}
+
+void LogicAnalyzer::setProbes(const QStringList &probes) {
+  if (m_probes == probes) return;
+  m_probes = probes;
+  rebuild();
+  emit probesChanged();
+}
+
+void LogicAnalyzer::rebuild() {
+  detach();
+  beginResetModel();
+  m_store = std::make_shared<EdgeStore>(static_cast<int>(m_probes.size()));
+  endResetModel();
+  attach();
+  flush();
+  emit decodersChanged();
+}
+
+void LogicAnalyzer::attach() {
+  if (!m_controller) return;
+  m_store->setNotifier([throttle = &m_throttle] { throttle->request(); });
+
+  auto feed = std::make_shared<EdgeFeed>();
+  feed->store = m_store;
+  for (const QString &probe : m_probes) {
+    qsizetype colon = probe.lastIndexOf(QLatin1Char(':'));
+    bool ok = false;
+    int pin = colon > 0 ? probe.mid(colon + 1).toInt(&ok) : -1;
+    feed->probes.push_back({probe.left(colon).toStdString(), ok ? pin : -1});
+  }
+  m_link.observe(m_controller, feed);
+}
+
+void LogicAnalyzer::detach() {
+  if (m_store) m_store->setNotifier(nullptr);
+  m_link.release();
+}
+
+int LogicAnalyzer::addUartDecoder(int channel, int baud) {
+  if (channel < 0 || channel >= m_store->channels() || baud <= 0) return -1;
+  int id = m_store->addDecoder(makeUartDecoder(channel, static_cast<uint32_t>(baud)));
+  emit decodersChanged();
+  return id;
+}
+
+int LogicAnalyzer::addSpiDecoder(int sck, int mosi, int miso, int cs, int mode) {
+  int n = m_store->channels();
+  if (sck < 0 || sck >= n || mosi < 0 || mosi >= n || miso >= n || cs >= n) return -1;
+  int id = m_store->addDecoder(makeSpiDecoder(sck, mosi, std::max(miso, -1), std::max(cs, -1), mode & 3));
+  emit decodersChanged();
+  return id;
+}
+
+int LogicAnalyzer::addI2cDecoder(int scl, int sda) {
+  int n = m_store->channels();
+  if (scl < 0 || scl >= n || sda < 0 || sda >= n) return -1;
+  int id = m_store->addDecoder(makeI2cDecoder(scl, sda));
+  emit decodersChanged();
+  return id;
+}
+
+void LogicAnalyzer::clearDecoders() {
+  m_store->clearDecoders();
+  emit decodersChanged();
+  emit captureChanged();
+}
+
+QVariantList LogicAnalyzer::annotations(double fromMs, double toMs, int maxCount) const {
+  std::vector<EdgeAnnotation> found;
+  m_store->annotations(toUs(fromMs), toUs(toMs), static_cast<size_t>(std::max(maxCount, 0)), found);
+  QVariantList list;
+  list.reserve(static_cast<qsizetype>(found.size()));
+  for (const auto &a : found) {
+    list.append(QVariantMap{
+        {QStringLiteral("decoder"), a.decoder},
+        {QStringLiteral("startMs"), static_cast<double>(a.startUs) / 1000.0},
+        {QStringLiteral("endMs"), static_cast<double>(a.endUs) / 1000.0},
+        {QStringLiteral("text"), QString::fromStdString(a.text)},
+    });
+  }
+  return list;
+}
+
+QVariantMap LogicAnalyzer::measure(int channel, double fromMs, double toMs) const {
+  if (toMs < fromMs) std::swap(fromMs, toMs);
+  uint64_t from = toUs(fromMs), to = toUs(toMs);
+  uint64_t edges = m_store->edgesBetween(channel, from, to);
+  uint64_t high = m_store->highTimeBetween(channel, from, to);
+  double spanMs = static_cast<double>(to - from) / 1000.0;
+  return {
+      {QStringLiteral("edges"), static_cast<double>(edges)},
+      {QStringLiteral("highMs"), static_cast<double>(high) / 1000.0},
+      {QStringLiteral("dutyCycle"), to > from ? static_cast<double>(high) / static_cast<double>(to - from) : 0.0},
+      // Two edges per period
+      {QStringLiteral("frequencyHz"), spanMs > 0.0 ? static_cast<double>(edges) / 2.0 / (spanMs / 1000.0) : 0.0},
+  };
+}
+
+double LogicAnalyzer::nextEdgeMs(int channel, double ms) const {
+  uint64_t edgeUs = 0;
+  return m_store->nextEdge(channel, toUs(ms), edgeUs) ? static_cast<double>(edgeUs) / 1000.0 : -1.0;
+}
+
+double LogicAnalyzer::previousEdgeMs(int channel, double ms) const {
+  uint64_t edgeUs = 0;
+  return m_store->previousEdge(channel, toUs(ms), edgeUs) ? static_cast<double>(edgeUs) / 1000.0 : -1.0;
+}
+
+int LogicAnalyzer::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid()) return 0;
+  return static_cast<int>(m_probes.size());
+}
+
+QVariant LogicAnalyzer::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= m_probes.size()) return {};
+  int row = index.row();
+  switch (role) {
+  case Qt::DisplayRole:
+  case ProbeRole: return m_probes.at(row);
+  case LevelRole: return static_cast<int>(m_store->levelAt(row, m_lastUs));
+  case EdgesRole: return static_cast<double>(m_store->edgeCount(row));
+  default: return {};
+  }
+}
+
+QHash<int, QByteArray> LogicAnalyzer::roleNames() const {
+  return {
+      {ProbeRole, "probe"},
+      {LevelRole, "level"},
+      {EdgesRole, "edges"},
+  };
+}
+
+// Runs at most once per display frame (FrameThrottle)
+void LogicAnalyzer::flush() {
+  uint64_t firstUs = 0, lastUs = 0;
+  m_store->timeRange(firstUs, lastUs);
+  if (!m_probes.isEmpty()) {
+    emit dataChanged(index(0), index(static_cast<int>(m_probes.size()) - 1), {LevelRole, EdgesRole});
+  }
+  // New edges and annotations can arrive without the capture growing
+  m_firstUs = firstUs;
+  m_lastUs = lastUs;
+  emit captureChanged();
+}
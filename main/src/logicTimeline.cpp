@@ -0,0 +1,209 @@
+// logicTimeline.cpp
+#include "logicTimeline.hpp"
+
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace renode;
+
+namespace {
+
+QSGGeometryNode *makeLineNode() {
+  auto *node = new QSGGeometryNode;
+  auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+  geometry->setDrawingMode(QSGGeometry::DrawLines);
+  geometry->setLineWidth(1);
+  node->setGeometry(geometry);
+  node->setFlag(QSGNode::OwnsGeometry);
+  node->setMaterial(new QSGFlatColorMaterial);
+  node->setFlag(QSGNode::OwnsMaterial);
+  return node;
+}
+
+void setLines(QSGGeometryNode *node, const std::vector<float> &xy, const QColor &color) {
+  auto *material = static_cast<QSGFlatColorMaterial *>(node->material());
+  if (material->color() != color) {
+    material->setColor(color);
+    node->markDirty(QSGNode::DirtyMaterial);
+  }
+  QSGGeometry *geometry = node->geometry();
+  geometry->allocate(static_cast<int>(xy.size() / 2));
+  if (!xy.empty()) std::memcpy(geometry->vertexData(), xy.data(), xy.size() * sizeof(float));
+  node->markDirty(QSGNode::DirtyGeometry);
+}
+
+} // namespace
+
+LogicTimeline::LogicTimeline(QQuickItem *parent) : QQuickItem(parent) {
+  setFlag(ItemHasContents, true);
+}
+
+void LogicTimeline::setAnalyzer(LogicAnalyzer *analyzer) {
+  if (m_analyzer == analyzer) return;
+  if (m_analyzer) disconnect(m_analyzer, nullptr, this, nullptr);
+  m_analyzer = analyzer;
+  if (m_analyzer) {
+    connect(m_analyzer, &LogicAnalyzer::captureChanged, this, &LogicTimeline::captureChanged);
+    connect(m_analyzer, &QAbstractItemModel::modelReset, this, &QQuickItem::update);
+  }
+  captureChanged();
+  emit analyzerChanged();
+}
+
+void LogicTimeline::setStartMs(double ms) {
+  if (m_startMs == ms) return;
+  m_startMs = ms;
+  update();
+  emit startMsChanged();
+}
+
+void LogicTimeline::setSpanMs(double ms) {
+  ms = std::max(ms, 1e-3);
+  if (m_spanMs == ms) return;
+  m_spanMs = ms;
+  if (m_follow) captureChanged();
+  update();
+  emit spanMsChanged();
+}
+
+void LogicTimeline::setFollow(bool follow) {
+  if (m_follow == follow) return;
+  m_follow = follow;
+  captureChanged();
+  emit followChanged();
+}
+
+void LogicTimeline::setRowHeight(double height) {
+  height = std::max(height, 4.0);
+  if (m_rowHeight == height) return;
+  m_rowHeight = height;
+  update();
+  emit rowHeightChanged();
+}
+
+void LogicTimeline::setCursorAMs(double ms) {
+  if (m_cursorAMs == ms) return;
+  m_cursorAMs = ms;
+  update();
+  emit cursorsChanged();
+}
+
+void LogicTimeline::setCursorBMs(double ms) {
+  if (m_cursorBMs == ms) return;
+  m_cursorBMs = ms;
+  update();
+  emit cursorsChanged();
+}
+
+void LogicTimeline::setTraceColor(const QColor &color) {
+  if (m_traceColor == color) return;
+  m_traceColor = color;
+  update();
+  emit colorsChanged();
+}
+
+void LogicTimeline::setCursorColor(const QColor &color) {
+  if (m_cursorColor == color) return;
+  m_cursorColor = color;
+  update();
+  emit colorsChanged();
+}
+
+double LogicTimeline::timeAt(double x) const {
+  return width() > 0.0 ? m_startMs + x / width() * m_spanMs : m_startMs;
+}
+
+double LogicTimeline::xAt(double ms) const {
+  return (ms - m_startMs) / m_spanMs * width();
+}
+
+void LogicTimeline::zoom(double factor, double x) {
+  if (factor <= 0.0) return;
+  double anchorMs = timeAt(x);
+  setSpanMs(m_spanMs * factor);
+  if (!m_follow) setStartMs(anchorMs - x / std::max(width(), 1.0) * m_spanMs);
+}
+
+void LogicTimeline::captureChanged() {
+  if (m_follow && m_analyzer) setStartMs(m_analyzer->captureEndMs() - m_spanMs);
+  update();
+}
+
+// Render thread, GUI thread blocked
+QSGNode *LogicTimeline::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
+  QSGNode *root = oldNode;
+  if (!root) {
+    root = new QSGNode;
+    root->appendChildNode(makeLineNode());  // traces
+    root->appendChildNode(makeLineNode());  // cursors
+  }
+  auto *traces = static_cast<QSGGeometryNode *>(root->firstChild());
+  auto *cursors = static_cast<QSGGeometryNode *>(root->lastChild());
+
+  const double w = width();
+  const double h = height();
+  m_vertices.clear();
+  auto line = [&](double x0, double y0, double x1, double y1) {
+    m_vertices.insert(m_vertices.end(), {static_cast<float>(x0), static_cast<float>(y0),
+                                         static_cast<float>(x1), static_cast<float>(y1)});
+  };
+
+  // Only the captured part of the view is drawn
+  double fromMs = std::max(m_startMs, 0.0);
+  double toMs = m_startMs + m_spanMs;
+  if (m_analyzer) toMs = std::min(toMs, m_analyzer->captureEndMs());
+  double x0 = xAt(fromMs);
+  double x1 = std::min(xAt(toMs), w);
+  int columns = static_cast<int>(std::ceil(x1 - x0));
+
+  if (m_analyzer && columns > 0 && h > 0.0) {
+    auto store = m_analyzer->store();
+    uint64_t fromUs = static_cast<uint64_t>(std::llround(fromMs * 1000.0));
+    uint64_t toUs = static_cast<uint64_t>(std::llround(toMs * 1000.0));
+    double columnWidth = (x1 - x0) / columns;
+
+    for (int row = 0; row < store->channels(); ++row) {
+      double top = row * m_rowHeight + m_rowHeight * 0.2;
+      double bottom = (row + 1) * m_rowHeight - m_rowHeight * 0.2;
+      if (top >= h) break;
+      auto y = [&](GpioState s) {
+        return s == GpioState::High ? top : s == GpioState::Low ? bottom : (top + bottom) / 2;
+      };
+
+      store->summarize(row, fromUs, toUs, columns, m_columns);
+      if (m_columns.empty()) continue;
+      GpioState endLevel = store->levelAt(row, toUs);
+      double runX = x0;
+      GpioState runLevel = m_columns.front().level;
+      for (size_t c = 0; c < m_columns.size(); ++c) {
+        const auto &col = m_columns[c];
+        if (col.edges == 0) continue;
+        GpioState next = c + 1 < m_columns.size() ? m_columns[c + 1].level : endLevel;
+        double x = x0 + (c + 0.5) * columnWidth;
+        line(runX, y(runLevel), x, y(runLevel));
+        if (col.edges == 1) {
+          line(x, y(col.level), x, y(next));
+        } else {
+          line(x, top, x, bottom);  // more edges than pixels
+        }
+        runX = x;
+        runLevel = next;
+      }
+      line(runX, y(runLevel), x1, y(runLevel));
+    }
+  }
+  setLines(traces, m_vertices, m_traceColor);
+
+  m_vertices.clear();
+  for (double cursorMs : {m_cursorAMs, m_cursorBMs}) {
+    if (cursorMs < 0.0) continue;
+    double x = xAt(cursorMs);
+    if (x >= 0.0 && x <= w) line(x, 0.0, x, h);
+  }
+  setLines(cursors, m_vertices, m_cursorColor);
+  return root;
+}
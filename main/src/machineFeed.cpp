@@ -0,0 +1,111 @@
+// machineFeed.cpp
+#include "machineFeed.hpp"
+
+#include <cctype>
+#include <map>
+
+#include "simulationController.hpp"
+
+using namespace renode;
+
+// ============================================================================
+// FeedNotifier
+// ============================================================================
+
+void FeedNotifier::set(std::function<void()> notify) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  m_notify = std::move(notify);
+}
+
+void FeedNotifier::notify() {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  if (m_notify) m_notify();
+}
+
+// ============================================================================
+// GpioListeners
+// ============================================================================
+
+std::string pinLabel(const std::string &port, int pin) {
+  size_t dot = port.rfind('.');
+  std::string leaf = dot == std::string::npos ? port : port.substr(dot + 1);
+  if (leaf.size() > 4 && leaf.compare(leaf.size() - 5, 4, "Port") == 0 && std::isalpha(static_cast<unsigned char>(leaf.back()))) {
+    return std::string("P") + static_cast<char>(std::toupper(static_cast<unsigned char>(leaf.back()))) + std::to_string(pin);
+  }
+  return leaf + "." + std::to_string(pin);
+}
+
+namespace {
+
+// Port handles per machine. Entries are dropped once their machine is gone;
+// the cache itself is never destroyed, so no handle outlives the
+// registries its destructor unregisters from at exit.
+struct GpioPortCache {
+  struct Entry {
+    std::weak_ptr<AMachine> machine;
+    std::map<std::string, std::shared_ptr<Gpio>> ports;
+  };
+  std::mutex mtx;
+  std::map<const AMachine *, Entry> machines;
+
+  static GpioPortCache &instance() {
+    static auto *cache = new GpioPortCache;
+    return *cache;
+  }
+
+  void purgeLocked() {
+    std::erase_if(machines, [](const auto &kv) { return kv.second.machine.expired(); });
+  }
+};
+
+} // namespace
+
+std::shared_ptr<Gpio> GpioListeners::port(const std::shared_ptr<AMachine> &machine,
+                                          const std::string &path) {
+  auto &cache = GpioPortCache::instance();
+  std::lock_guard<std::mutex> lk(cache.mtx);
+  cache.purgeLocked();
+  auto &entry = cache.machines[machine.get()];
+  entry.machine = machine;
+  auto it = entry.ports.find(path);
+  if (it != entry.ports.end()) return it->second;
+  Error err;
+  auto gpio = machine->getGpio(path, err);
+  if (gpio) entry.ports.emplace(path, gpio);
+  return gpio;
+}
+
+bool GpioListeners::listen(const std::shared_ptr<Gpio> &gpio, int pin, GpioEventCallback cb) {
+  int handle = -1;
+  if (gpio->registerStateChangeCallback(pin, std::move(cb), handle)) return false;
+  m_handles.emplace_back(gpio, handle);
+  return true;
+}
+
+void GpioListeners::clear() {
+  for (auto &[gpio, handle] : m_handles) gpio->unregisterStateChangeCallback(handle);
+  m_handles.clear();
+  // Typically called as the machine goes away: release its handles
+  auto &cache = GpioPortCache::instance();
+  std::lock_guard<std::mutex> lk(cache.mtx);
+  cache.purgeLocked();
+}
+
+// ============================================================================
+// MachineFeedLink
+// ============================================================================
+
+void MachineFeedLink::observe(SimulationController *controller,
+                              std::function<void(const std::shared_ptr<AMachine> &)> machineChanged,
+                              std::function<void(uint64_t)> advanced) {
+  release();
+  if (!controller) return;
+  m_controller = controller;
+  m_observerId = controller->observeMachine(std::move(machineChanged), std::move(advanced));
+}
+
+void MachineFeedLink::release() {
+  if (m_controller && m_observerId) m_controller->unobserveMachine(m_observerId);
+  m_controller = nullptr;
+  m_observerId = 0;
+}
@@ -0,0 +1,446 @@
+// memoryModel.cpp
+#include "memoryModel.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+
+using namespace renode;
+
+// ============================================================================
+// MemoryPageCache
+// ============================================================================
+
+MemoryPageCache::MemoryPageCache(size_t capacity) : m_capacity(std::max<size_t>(capacity, 1)) {}
+
+const MemoryPageCache::Page *MemoryPageCache::find(uint64_t page) const {
+  auto it = m_pages.find(page);
+  return it == m_pages.end() ? nullptr : &it->second.page;
+}
+
+void MemoryPageCache::touch(uint64_t page) {
+  auto it = m_pages.find(page);
+  if (it != m_pages.end()) m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+}
+
+void MemoryPageCache::store(uint64_t page, uint64_t generationUs, const uint8_t *bytes, bool valid) {
+  auto it = m_pages.find(page);
+  if (it == m_pages.end()) {
+    if (m_pages.size() >= m_capacity) {
+      m_pages.erase(m_lru.back());
+      m_lru.pop_back();
+    }
+    m_lru.push_front(page);
+    Page fresh;
+    fresh.bytes.assign(kPageSize, 0);
+    fresh.changed.assign(kPageSize, 0);
+    it = m_pages.emplace(page, Entry{std::move(fresh), m_lru.begin()}).first;
+  } else {
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+  }
+
+  Page &p = it->second.page;
+  if (!valid) {
+    std::fill(p.bytes.begin(), p.bytes.end(), 0);
+    std::fill(p.changed.begin(), p.changed.end(), 0);
+  } else if (p.valid && generationUs > p.generationUs) {
+    for (size_t i = 0; i < kPageSize; ++i) p.changed[i] = p.bytes[i] != bytes[i];
+    std::copy(bytes, bytes + kPageSize, p.bytes.begin());
+  } else {
+    if (!p.valid) std::fill(p.changed.begin(), p.changed.end(), 0);
+    std::copy(bytes, bytes + kPageSize, p.bytes.begin());
+  }
+  p.valid = valid;
+  p.generationUs = generationUs;
+}
+
+void MemoryPageCache::clear() {
+  m_pages.clear();
+  m_lru.clear();
+}
+
+// ============================================================================
+// MemoryFeed
+// ============================================================================
+
+// Worker side of a MemoryModel. Reads run on the worker thread and hand
+// their pages back through the mutex-guarded outbox.
+struct MemoryFeed {
+  struct Run {
+    uint64_t firstPage;
+    uint64_t pages;
+  };
+  struct Block {
+    uint64_t firstPage;
+    uint64_t generationUs;
+    bool valid;
+    std::vector<uint8_t> bytes;  // pages * kPageSize
+  };
+
+  // Fixed at construction
+  std::string busPath;
+  std::string busNode;
+  uint64_t begin = 0;  // [begin, end) is readable, the rest of a page stays zero
+  uint64_t end = 0;
+
+  // Worker thread only
+  std::shared_ptr<BusContext> bus;
+  uint64_t simTimeUs = 0;
+
+  // Shared with the GUI thread
+  std::mutex mtx;
+  FeedNotifier notifier;
+  std::vector<Block> blocks;
+  uint64_t publishedUs = 0;
+  bool reset = false;
+  bool completed = false;
+  bool hasBus = false;  // no reads are worth queuing while false
+  std::string error;
+
+  template <typename Fn> void publish(Fn &&update) {
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      update();
+    }
+    notifier.notify();
+  }
+
+  void attach(const std::shared_ptr<AMachine> &machine) {
+    simTimeUs = machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+    Error err;
+    if (auto sysbus = machine->getSysBus(busPath, err)) bus = sysbus->getBusContext(busNode, err);
+    std::string failure = bus ? std::string() : err.message;
+    publish([&] {
+      blocks.clear();
+      reset = true;
+      publishedUs = simTimeUs;
+      hasBus = bus != nullptr;
+      error = failure;
+    });
+  }
+
+  void detach() {
+    bus.reset();
+    publish([&] {
+      blocks.clear();
+      reset = true;
+      hasBus = false;
+      error.clear();
+    });
+  }
+
+  void advance(uint64_t us) {
+    simTimeUs = us;
+    publish([&] { publishedUs = us; });
+  }
+
+  void fetch(const std::vector<Run> &runs) {
+    std::vector<Block> read;
+    std::string failure;
+    for (const Run &run : runs) {
+      if (!bus) break;
+      Block block{run.firstPage, simTimeUs, false,
+                  std::vector<uint8_t>(run.pages * MemoryPageCache::kPageSize, 0)};
+      uint64_t from = std::max(run.firstPage << MemoryPageCache::kPageShift, begin);
+      uint64_t to = std::min((run.firstPage + run.pages) << MemoryPageCache::kPageShift, end);
+      std::vector<uint8_t> bytes;
+      if (to <= from) {
+        block.valid = true;
+      } else if (Error err = bus->readBlock(from, to - from, bytes)) {
+        failure = err.message;
+      } else {
+        std::copy(bytes.begin(), bytes.end(),
+                  block.bytes.begin() + (from - (run.firstPage << MemoryPageCache::kPageShift)));
+        block.valid = true;
+      }
+      read.push_back(std::move(block));
+    }
+    publish([&] {
+      for (auto &block : read) blocks.push_back(std::move(block));
+      completed = true;
+      if (bus) error = failure;
+    });
+  }
+};
+
+// ============================================================================
+// MemoryModel
+// ============================================================================
+
+MemoryModel::MemoryModel(QObject *parent)
+    : QAbstractListModel(parent), m_throttle([this] { flush(); }) {
+  rebuild();
+}
+
+MemoryModel::~MemoryModel() {
+  detach();
+}
+
+void MemoryModel::setController(SimulationController *controller) {
+  if (m_controller == controller) return;
+  detach();
+  m_controller = controller;
+  attach();
+  emit controllerChanged();
+}
+
+void MemoryModel::setBusPath(const QString &path) {
+  if (m_busPath == path) return;
+  m_busPath = path;
+  rebuild();
+  emit rangeChanged();
+}
+
+void MemoryModel::setBusNode(const QString &node) {
+  if (m_busNode == node) return;
+  m_busNode = node;
+  rebuild();
+  emit rangeChanged();
+}
+
+void MemoryModel::setBaseAddress(qulonglong address) {
+  if (m_baseAddress == address) return;
+  m_baseAddress = address;
+  rebuild();
+  emit rangeChanged();
+}
+
+void MemoryModel::setSize(int bytes) {
+  bytes = std::max(bytes, 0);
+  if (m_size == bytes) return;
+  m_size = bytes;
+  rebuild();
+  emit rangeChanged();
+}
+
+void MemoryModel::rebuild() {
+  detach();
+  beginResetModel();
+  m_cache.clear();
+  m_missed.clear();
+  endResetModel();
+  attach();
+}
+
+// Each attachment gets its own feed, so reads still queued for a previous
+// controller or range can never land in this one
+void MemoryModel::attach() {
+  if (!m_controller) return;
+  m_feed = std::make_shared<MemoryFeed>();
+  m_feed->busPath = m_busPath.toStdString();
+  m_feed->busNode = m_busNode.toStdString();
+  m_feed->begin = m_baseAddress;
+  m_feed->end = m_baseAddress + static_cast<uint64_t>(m_size);
+  m_feed->notifier.set([throttle = &m_throttle] { throttle->request(); });
+  m_link.observe(m_controller, m_feed);
+}
+
+void MemoryModel::detach() {
+  if (m_feed) m_feed->notifier.set(nullptr);
+  m_link.release();
+  m_feed.reset();
+  m_inFlight = false;
+  m_hasBus = false;
+}
+
+uint64_t MemoryModel::firstPage() const {
+  return m_baseAddress >> MemoryPageCache::kPageShift;
+}
+
+uint64_t MemoryModel::lastPage() const {
+  if (m_size == 0) return firstPage();
+  return (m_baseAddress + static_cast<uint64_t>(m_size) - 1) >> MemoryPageCache::kPageShift;
+}
+
+void MemoryModel::setVisibleRows(int first, int last) {
+  first = std::max(first, 0);
+  last = std::min(last, rowCount() - 1);
+  if (first > last) return;
+  if (first != m_firstRow) m_direction = first > m_firstRow ? 1 : -1;
+  m_firstRow = first;
+  m_lastRow = last;
+  uint64_t from = (m_baseAddress + static_cast<uint64_t>(first) * kBytesPerRow) >> MemoryPageCache::kPageShift;
+  uint64_t to = (m_baseAddress + static_cast<uint64_t>(last) * kBytesPerRow + kBytesPerRow - 1)
+                >> MemoryPageCache::kPageShift;
+  for (uint64_t page = from; page <= to; ++page) m_cache.touch(page);
+  schedule();
+}
+
+int MemoryModel::rowForAddress(qulonglong address) const {
+  if (address < m_baseAddress) return 0;
+  return std::min(static_cast<int>((address - m_baseAddress) / kBytesPerRow), std::max(rowCount() - 1, 0));
+}
+
+// Queues at most one batch of reads; the next one goes out once flush() has
+// applied its results, so a slow link never builds up a backlog. Without a
+// bus nothing is queued until the feed attaches to a machine that has one.
+void MemoryModel::schedule() {
+  if (!m_controller || !m_feed || !m_hasBus || m_inFlight || m_size == 0) return;
+
+  std::vector<uint64_t> wanted;
+  auto want = [&](uint64_t page, bool refresh) {
+    if (page < firstPage() || page > lastPage()) return;
+    const auto *cached = m_cache.find(page);
+    if (!cached || (refresh && cached->generationUs < m_simTimeUs)) wanted.push_back(page);
+  };
+
+  if (m_lastRow >= m_firstRow) {
+    uint64_t from = (m_baseAddress + static_cast<uint64_t>(m_firstRow) * kBytesPerRow) >> MemoryPageCache::kPageShift;
+    uint64_t to = (m_baseAddress + static_cast<uint64_t>(m_lastRow) * kBytesPerRow + kBytesPerRow - 1)
+                  >> MemoryPageCache::kPageShift;
+    for (uint64_t page = from; page <= to; ++page) want(page, true);
+    for (uint64_t page : m_missed) want(page, false);
+    // Prefetch in the scroll direction; pages before the range wrap to huge
+    // values and are dropped by want()
+    uint64_t ahead = m_direction > 0 ? to : from;
+    uint64_t behind = m_direction > 0 ? from : to;
+    for (int i = 1; i <= kPrefetchAhead; ++i) want(ahead + static_cast<uint64_t>(i * m_direction), false);
+    for (int i = 1; i <= kPrefetchBehind; ++i) want(behind - static_cast<uint64_t>(i * m_direction), false);
+  } else {
+    for (uint64_t page : m_missed) want(page, false);
+  }
+  m_missed.clear();
+  if (wanted.empty()) return;
+
+  std::sort(wanted.begin(), wanted.end());
+  wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+  if (wanted.size() > static_cast<size_t>(kMaxFetchPages)) wanted.resize(kMaxFetchPages);
+  std::vector<MemoryFeed::Run> runs;
+  for (uint64_t page : wanted) {
+    if (!runs.empty() && runs.back().firstPage + runs.back().pages == page &&
+        runs.back().pages < static_cast<uint64_t>(kMaxRunPages)) {
+      ++runs.back().pages;
+    } else {
+      runs.push_back({page, 1});
+    }
+  }
+
+  m_inFlight = true;
+  m_controller->withMachine([feed = m_feed, runs = std::move(runs)](const std::shared_ptr<AMachine> &) {
+    feed->fetch(runs);
+  });
+}
+
+int MemoryModel::rowCount(const QModelIndex &parent) const {
+  if (parent.isValid()) return 0;
+  return (m_size + kBytesPerRow - 1) / kBytesPerRow;
+}
+
+QVariant MemoryModel::data(const QModelIndex &index, int role) const {
+  if (!index.isValid() || index.row() >= rowCount()) return {};
+  uint64_t address = m_baseAddress + static_cast<uint64_t>(index.row()) * kBytesPerRow;
+  int count = std::min(kBytesPerRow, m_size - index.row() * kBytesPerRow);
+  if (role == AddressRole) return QStringLiteral("%1").arg(static_cast<qulonglong>(address), 8, 16, QLatin1Char('0'));
+
+  // A row can straddle two pages when the base is not 16-byte aligned
+  uint8_t bytes[kBytesPerRow] = {};
+  int changed = 0;
+  bool loaded = true;
+  for (int i = 0; i < count; ++i) {
+    uint64_t page = (address + i) >> MemoryPageCache::kPageShift;
+    const auto *cached = m_cache.find(page);
+    if (!cached) {
+      if (m_feed && (m_missed.empty() || m_missed.back() != page) && m_missed.size() < 64) {
+        m_missed.push_back(page);
+        m_throttle.request();
+      }
+      loaded = false;
+      continue;
+    }
+    size_t offset = (address + i) & (MemoryPageCache::kPageSize - 1);
+    bytes[i] = cached->bytes[offset];
+    if (cached->changed[offset]) changed |= 1 << i;
+    loaded = loaded && cached->valid;
+  }
+
+  switch (role) {
+  case Qt::DisplayRole:
+  case HexRole: {
+    static const char digits[] = "0123456789abcdef";
+    QString hex(count * 3 - 1, QLatin1Char(' '));
+    for (int i = 0; i < count; ++i) {
+      hex[i * 3] = loaded ? QLatin1Char(digits[bytes[i] >> 4]) : QLatin1Char('-');
+      hex[i * 3 + 1] = loaded ? QLatin1Char(digits[bytes[i] & 15]) : QLatin1Char('-');
+    }
+    return hex;
+  }
+  case AsciiRole: {
+    QString text(count, QLatin1Char('.'));
+    for (int i = 0; i < count; ++i) {
+      if (loaded && bytes[i] >= 0x20 && bytes[i] < 0x7f) text[i] = QLatin1Char(static_cast<char>(bytes[i]));
+    }
+    return text;
+  }
+  case ChangedRole: return changed;
+  case LoadedRole: return loaded;
+  default: return {};
+  }
+}
+
+QHash<int, QByteArray> MemoryModel::roleNames() const {
+  return {
+      {AddressRole, "address"},
+      {HexRole, "hex"},
+      {AsciiRole, "ascii"},
+      {ChangedRole, "changed"},
+      {LoadedRole, "loaded"},
+  };
+}
+
+void MemoryModel::emitPages(uint64_t first, uint64_t last) {
+  int rows = rowCount();
+  if (rows == 0) return;
+  auto rowOf = [&](uint64_t address) {
+    if (address <= m_baseAddress) return 0;
+    return static_cast<int>(std::min<uint64_t>((address - m_baseAddress) / kBytesPerRow, rows - 1));
+  };
+  int from = rowOf(first << MemoryPageCache::kPageShift);
+  int to = rowOf(((last + 1) << MemoryPageCache::kPageShift) - 1);
+  emit dataChanged(index(from), index(to), {Qt::DisplayRole, HexRole, AsciiRole, ChangedRole, LoadedRole});
+}
+
+// Runs at most once per display frame (FrameThrottle)
+void MemoryModel::flush() {
+  if (!m_feed) return;
+  std::vector<MemoryFeed::Block> blocks;
+  uint64_t simTimeUs = 0;
+  bool reset = false, completed = false;
+  QString error;
+  {
+    std::lock_guard<std::mutex> lk(m_feed->mtx);
+    blocks.swap(m_feed->blocks);
+    simTimeUs = m_feed->publishedUs;
+    reset = std::exchange(m_feed->reset, false);
+    completed = std::exchange(m_feed->completed, false);
+    m_hasBus = m_feed->hasBus;
+    error = QString::fromStdString(m_feed->error);
+  }
+
+  if (reset) {
+    // Another machine (or none): everything cached is from the old one
+    m_cache.clear();
+    if (rowCount() > 0) {
+      emit dataChanged(index(0), index(rowCount() - 1),
+                       {Qt::DisplayRole, HexRole, AsciiRole, ChangedRole, LoadedRole});
+    }
+  }
+  m_simTimeUs = simTimeUs;
+
+  for (const auto &block : blocks) {
+    uint64_t pages = block.bytes.size() / MemoryPageCache::kPageSize;
+    for (uint64_t i = 0; i < pages; ++i) {
+      m_cache.store(block.firstPage + i, block.generationUs,
+                    block.bytes.data() + i * MemoryPageCache::kPageSize, block.valid);
+    }
+    if (pages > 0) emitPages(block.firstPage, block.firstPage + pages - 1);
+  }
+  if (completed) m_inFlight = false;
+
+  if (m_error != error) {
+    m_error = error;
+    emit errorChanged();
+  }
+  schedule();
+}
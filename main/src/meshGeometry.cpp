@@ -0,0 +1,474 @@
+// meshGeometry.cpp
+#include "meshGeometry.hpp"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMatrix4x4>
+#include <QPointer>
+#include <QQuaternion>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// ============================================================================
+// Shared helpers
+// ============================================================================
+
+// Fills in area-weighted smooth normals for vertices that have none
+void computeNormals(MeshData &mesh, size_t firstVertex) {
+  float *v = mesh.vertices.data();
+  size_t count = mesh.vertices.size() / MeshData::kFloatsPerVertex;
+  for (size_t i = firstVertex; i < count; ++i) std::fill_n(v + i * 6 + 3, 3, 0.0f);
+  for (size_t t = 0; t + 2 < mesh.indices.size(); t += 3) {
+    uint32_t a = mesh.indices[t], b = mesh.indices[t + 1], c = mesh.indices[t + 2];
+    if (a < firstVertex && b < firstVertex && c < firstVertex) continue;
+    QVector3D pa(v[a * 6], v[a * 6 + 1], v[a * 6 + 2]);
+    QVector3D pb(v[b * 6], v[b * 6 + 1], v[b * 6 + 2]);
+    QVector3D pc(v[c * 6], v[c * 6 + 1], v[c * 6 + 2]);
+    QVector3D n = QVector3D::crossProduct(pb - pa, pc - pa);
+    for (uint32_t i : {a, b, c}) {
+      if (i < firstVertex) continue;
+      v[i * 6 + 3] += n.x();
+      v[i * 6 + 4] += n.y();
+      v[i * 6 + 5] += n.z();
+    }
+  }
+  for (size_t i = firstVertex; i < count; ++i) {
+    QVector3D n = QVector3D(v[i * 6 + 3], v[i * 6 + 4], v[i * 6 + 5]).normalized();
+    v[i * 6 + 3] = n.x();
+    v[i * 6 + 4] = n.y();
+    v[i * 6 + 5] = n.z();
+  }
+}
+
+void computeBounds(MeshData &mesh) {
+  constexpr float inf = std::numeric_limits<float>::infinity();
+  QVector3D lo(inf, inf, inf), hi(-inf, -inf, -inf);
+  for (size_t i = 0; i < mesh.vertices.size(); i += MeshData::kFloatsPerVertex) {
+    QVector3D p(mesh.vertices[i], mesh.vertices[i + 1], mesh.vertices[i + 2]);
+    lo = QVector3D(std::min(lo.x(), p.x()), std::min(lo.y(), p.y()), std::min(lo.z(), p.z()));
+    hi = QVector3D(std::max(hi.x(), p.x()), std::max(hi.y(), p.y()), std::max(hi.z(), p.z()));
+  }
+  mesh.boundsMin = mesh.vertices.empty() ? QVector3D() : lo;
+  mesh.boundsMax = mesh.vertices.empty() ? QVector3D() : hi;
+}
+
+// ============================================================================
+// Wavefront .obj
+// ============================================================================
+
+const char *skipSpace(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t')) ++p;
+  return p;
+}
+
+bool parseFloats(const char *&p, const char *end, float *out, int n) {
+  for (int i = 0; i < n; ++i) {
+    p = skipSpace(p, end);
+    auto [next, ec] = std::from_chars(p, end, out[i]);
+    if (ec != std::errc()) return false;
+    p = next;
+  }
+  return true;
+}
+
+// Positions and normals are deduplicated per (v, vn) pair; polygons are
+// fanned into triangles. Texture coordinates are not used by the scene.
+bool parseObj(const char *p, const char *end, MeshData &mesh, QString &error) {
+  std::vector<float> positions, normals;
+  std::unordered_map<uint64_t, uint32_t> corners;
+  std::vector<uint32_t> face;
+  bool missingNormals = false;
+  int line = 0;
+
+  while (p < end) {
+    ++line;
+    const char *eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    if (!eol) eol = end;
+    p = skipSpace(p, eol);
+
+    if (eol - p > 2 && p[0] == 'v' && p[1] == ' ') {
+      p += 2;
+      float xyz[3];
+      if (!parseFloats(p, eol, xyz, 3)) {
+        error = QStringLiteral("Bad vertex on line %1").arg(line);
+        return false;
+      }
+      positions.insert(positions.end(), xyz, xyz + 3);
+    } else if (eol - p > 3 && p[0] == 'v' && p[1] == 'n' && p[2] == ' ') {
+      p += 3;
+      float xyz[3];
+      if (!parseFloats(p, eol, xyz, 3)) {
+        error = QStringLiteral("Bad normal on line %1").arg(line);
+        return false;
+      }
+      normals.insert(normals.end(), xyz, xyz + 3);
+    } else if (eol - p > 2 && p[0] == 'f' && p[1] == ' ') {
+      p += 2;
+      face.clear();
+      while ((p = skipSpace(p, eol)) < eol && *p != '\r') {
+        long v = 0, vt = 0, vn = 0;
+        auto [next, ec] = std::from_chars(p, eol, v);
+        if (ec != std::errc()) break;
+        p = next;
+        if (p < eol && *p == '/') {
+          ++p;
+          if (p < eol && *p != '/') p = std::from_chars(p, eol, vt).ptr;
+          if (p < eol && *p == '/') p = std::from_chars(p + 1, eol, vn).ptr;
+        }
+        // 1-based, negative counts back from the latest
+        long vCount = static_cast<long>(positions.size() / 3), nCount = static_cast<long>(normals.size() / 3);
+        long vi = v < 0 ? vCount + v : v - 1;
+        long ni = vn < 0 ? nCount + vn : vn - 1;
+        if (vi < 0 || vi >= vCount || ni >= nCount) {
+          error = QStringLiteral("Bad face index on line %1").arg(line);
+          return false;
+        }
+        if (vn == 0) missingNormals = true;
+
+        uint64_t key = (static_cast<uint64_t>(vi) << 32) | static_cast<uint32_t>(vn == 0 ? -1 : ni);
+        auto [it, inserted] = corners.try_emplace(key, static_cast<uint32_t>(mesh.vertices.size() / 6));
+        if (inserted) {
+          mesh.vertices.insert(mesh.vertices.end(), positions.begin() + vi * 3, positions.begin() + vi * 3 + 3);
+          if (vn != 0) {
+            mesh.vertices.insert(mesh.vertices.end(), normals.begin() + ni * 3, normals.begin() + ni * 3 + 3);
+          } else {
+            mesh.vertices.insert(mesh.vertices.end(), 3, 0.0f);
+          }
+        }
+        face.push_back(it->second);
+      }
+      for (size_t i = 2; i < face.size(); ++i) {
+        mesh.indices.insert(mesh.indices.end(), {face[0], face[i - 1], face[i]});
+      }
+    }
+    p = eol + 1;
+  }
+
+  // Files that omit normals on any face get smooth normals throughout
+  if (missingNormals) computeNormals(mesh, 0);
+  return true;
+}
+
+// ============================================================================
+// glTF 2.0
+// ============================================================================
+
+struct Gltf {
+  QJsonObject json;
+  std::vector<QByteArray> buffers;
+};
+
+bool loadGltf(const QString &path, const QByteArray &file, Gltf &gltf, QString &error) {
+  QByteArray jsonChunk;
+  QByteArray binChunk;
+  if (file.startsWith("glTF")) {
+    // Binary container: 12-byte header, then JSON and optional BIN chunks
+    qsizetype offset = 12;
+    while (offset + 8 <= file.size()) {
+      uint32_t length = 0, type = 0;
+      std::memcpy(&length, file.constData() + offset, 4);
+      std::memcpy(&type, file.constData() + offset + 4, 4);
+      if (offset + 8 + length > static_cast<uint64_t>(file.size())) break;
+      QByteArray chunk = file.mid(offset + 8, length);
+      if (type == 0x4E4F534A) jsonChunk = chunk;        // "JSON"
+      else if (type == 0x004E4942) binChunk = chunk;    // "BIN\0"
+      offset += 8 + ((length + 3) & ~3u);
+    }
+  } else {
+    jsonChunk = file;
+  }
+
+  QJsonParseError parseError;
+  QJsonDocument doc = QJsonDocument::fromJson(jsonChunk, &parseError);
+  if (!doc.isObject()) {
+    error = QStringLiteral("Invalid glTF JSON: %1").arg(parseError.errorString());
+    return false;
+  }
+  gltf.json = doc.object();
+
+  QDir dir = QFileInfo(path).absoluteDir();
+  for (const QJsonValue &value : gltf.json.value(QLatin1String("buffers")).toArray()) {
+    QString uri = value.toObject().value(QLatin1String("uri")).toString();
+    if (uri.isEmpty()) {
+      gltf.buffers.push_back(binChunk);
+    } else if (uri.startsWith(QLatin1String("data:"))) {
+      qsizetype comma = uri.indexOf(QLatin1Char(','));
+      gltf.buffers.push_back(QByteArray::fromBase64(uri.mid(comma + 1).toLatin1()));
+    } else {
+      QFile buffer(dir.filePath(QUrl::fromPercentEncoding(uri.toUtf8())));
+      if (!buffer.open(QIODevice::ReadOnly)) {
+        error = QStringLiteral("Cannot open glTF buffer %1").arg(uri);
+        return false;
+      }
+      gltf.buffers.push_back(buffer.readAll());
+    }
+  }
+  return true;
+}
+
+// Reads accessor `index` as floats (components per element in `width`) or,
+// for index accessors, as uint32; false on anything out of range
+template <typename T>
+bool readAccessor(const Gltf &gltf, int index, int width, std::vector<T> &out) {
+  QJsonObject accessor = gltf.json.value(QLatin1String("accessors")).toArray().at(index).toObject();
+  if (accessor.isEmpty() || !accessor.contains(QLatin1String("bufferView"))) return false;
+  QJsonObject view = gltf.json.value(QLatin1String("bufferViews")).toArray()
+                         .at(accessor.value(QLatin1String("bufferView")).toInt()).toObject();
+  int buffer = view.value(QLatin1String("buffer")).toInt();
+  if (buffer < 0 || buffer >= static_cast<int>(gltf.buffers.size())) return false;
+  const QByteArray &data = gltf.buffers[buffer];
+
+  int componentType = accessor.value(QLatin1String("componentType")).toInt();
+  int componentSize = componentType == 5126 || componentType == 5125 ? 4
+                    : componentType == 5123 || componentType == 5122 ? 2 : 1;
+  qint64 count = accessor.value(QLatin1String("count")).toInteger();
+  qint64 offset = view.value(QLatin1String("byteOffset")).toInteger() +
+                  accessor.value(QLatin1String("byteOffset")).toInteger();
+  qint64 stride = view.value(QLatin1String("byteStride")).toInteger(width * componentSize);
+  if (count <= 0 || offset < 0 || offset + (count - 1) * stride + width * componentSize > data.size()) return false;
+
+  out.resize(static_cast<size_t>(count * width));
+  const char *base = data.constData() + offset;
+  for (qint64 i = 0; i < count; ++i) {
+    for (int c = 0; c < width; ++c) {
+      const char *src = base + i * stride + c * componentSize;
+      T value{};
+      switch (componentType) {
+      case 5126: { float f; std::memcpy(&f, src, 4); value = static_cast<T>(f); break; }
+      case 5125: { uint32_t u; std::memcpy(&u, src, 4); value = static_cast<T>(u); break; }
+      case 5123: { uint16_t u; std::memcpy(&u, src, 2); value = static_cast<T>(u); break; }
+      case 5121: value = static_cast<T>(static_cast<uint8_t>(*src)); break;
+      default: return false;
+      }
+      out[static_cast<size_t>(i * width + c)] = value;
+    }
+  }
+  return true;
+}
+
+QMatrix4x4 nodeMatrix(const QJsonObject &node) {
+  QMatrix4x4 m;
+  QJsonArray matrix = node.value(QLatin1String("matrix")).toArray();
+  if (matrix.size() == 16) {
+    float values[16];
+    for (int i = 0; i < 16; ++i) values[i] = static_cast<float>(matrix.at(i).toDouble());
+    return QMatrix4x4(values).transposed();  // glTF is column-major
+  }
+  QJsonArray t = node.value(QLatin1String("translation")).toArray();
+  QJsonArray r = node.value(QLatin1String("rotation")).toArray();
+  QJsonArray s = node.value(QLatin1String("scale")).toArray();
+  if (t.size() == 3) m.translate(t.at(0).toDouble(), t.at(1).toDouble(), t.at(2).toDouble());
+  if (r.size() == 4) {
+    m.rotate(QQuaternion(static_cast<float>(r.at(3).toDouble()), static_cast<float>(r.at(0).toDouble()),
+                         static_cast<float>(r.at(1).toDouble()), static_cast<float>(r.at(2).toDouble())));
+  }
+  if (s.size() == 3) m.scale(s.at(0).toDouble(), s.at(1).toDouble(), s.at(2).toDouble());
+  return m;
+}
+
+bool appendMesh(const Gltf &gltf, int meshIndex, const QMatrix4x4 &world, MeshData &mesh, QString &error) {
+  QJsonObject gltfMesh = gltf.json.value(QLatin1String("meshes")).toArray().at(meshIndex).toObject();
+  QMatrix3x3 normalMatrix = world.normalMatrix();
+  for (const QJsonValue &value : gltfMesh.value(QLatin1String("primitives")).toArray()) {
+    QJsonObject primitive = value.toObject();
+    if (primitive.value(QLatin1String("mode")).toInt(4) != 4) continue;  // triangles only
+    QJsonObject attributes = primitive.value(QLatin1String("attributes")).toObject();
+
+    std::vector<float> positions, normals;
+    std::vector<uint32_t> indices;
+    if (!readAccessor(gltf, attributes.value(QLatin1String("POSITION")).toInt(-1), 3, positions)) {
+      error = QStringLiteral("Unreadable POSITION in mesh %1").arg(meshIndex);
+      return false;
+    }
+    bool hasNormals = attributes.contains(QLatin1String("NORMAL")) &&
+                      readAccessor(gltf, attributes.value(QLatin1String("NORMAL")).toInt(), 3, normals) &&
+                      normals.size() == positions.size();
+    size_t count = positions.size() / 3;
+    if (primitive.contains(QLatin1String("indices"))) {
+      if (!readAccessor(gltf, primitive.value(QLatin1String("indices")).toInt(), 1, indices)) {
+        error = QStringLiteral("Unreadable indices in mesh %1").arg(meshIndex);
+        return false;
+      }
+    } else {
+      indices.resize(count);
+      for (size_t i = 0; i < count; ++i) indices[i] = static_cast<uint32_t>(i);
+    }
+
+    size_t first = mesh.vertices.size() / MeshData::kFloatsPerVertex;
+    mesh.vertices.reserve(mesh.vertices.size() + count * MeshData::kFloatsPerVertex);
+    for (size_t i = 0; i < count; ++i) {
+      QVector3D p = world.map(QVector3D(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2]));
+      QVector3D n;
+      if (hasNormals) {
+        const float *src = &normals[i * 3];
+        n = QVector3D(normalMatrix(0, 0) * src[0] + normalMatrix(0, 1) * src[1] + normalMatrix(0, 2) * src[2],
+                      normalMatrix(1, 0) * src[0] + normalMatrix(1, 1) * src[1] + normalMatrix(1, 2) * src[2],
+                      normalMatrix(2, 0) * src[0] + normalMatrix(2, 1) * src[1] + normalMatrix(2, 2) * src[2])
+                .normalized();
+      }
+      mesh.vertices.insert(mesh.vertices.end(), {p.x(), p.y(), p.z(), n.x(), n.y(), n.z()});
+    }
+    for (uint32_t index : indices) {
+      if (index >= count) {
+        error = QStringLiteral("Index out of range in mesh %1").arg(meshIndex);
+        return false;
+      }
+      mesh.indices.push_back(static_cast<uint32_t>(first) + index);
+    }
+    if (!hasNormals) computeNormals(mesh, first);
+  }
+  return true;
+}
+
+bool parseGltf(const QString &path, const QByteArray &file, MeshData &mesh, QString &error) {
+  Gltf gltf;
+  if (!loadGltf(path, file, gltf, error)) return false;
+
+  QJsonArray nodes = gltf.json.value(QLatin1String("nodes")).toArray();
+  QJsonArray scenes = gltf.json.value(QLatin1String("scenes")).toArray();
+  QJsonArray roots = scenes.at(gltf.json.value(QLatin1String("scene")).toInt(0))
+                         .toObject().value(QLatin1String("nodes")).toArray();
+
+  // Iterative walk; the depth guard stops malformed cyclic hierarchies
+  std::vector<std::pair<int, QMatrix4x4>> stack;
+  for (const QJsonValue &root : roots) stack.emplace_back(root.toInt(), QMatrix4x4());
+  size_t visited = 0;
+  while (!stack.empty()) {
+    auto [index, parent] = stack.back();
+    stack.pop_back();
+    if (index < 0 || index >= nodes.size() || ++visited > 100000) continue;
+    QJsonObject node = nodes.at(index).toObject();
+    QMatrix4x4 world = parent * nodeMatrix(node);
+    if (node.contains(QLatin1String("mesh")) &&
+        !appendMesh(gltf, node.value(QLatin1String("mesh")).toInt(), world, mesh, error)) {
+      return false;
+    }
+    for (const QJsonValue &child : node.value(QLatin1String("children")).toArray()) {
+      stack.emplace_back(child.toInt(), world);
+    }
+  }
+  return true;
+}
+
+// Parsed meshes stay shared while any geometry uses them
+std::mutex g_cacheMtx;
+std::map<QString, std::weak_ptr<const MeshData>> g_cache;
+
+} // namespace
+
+std::shared_ptr<const MeshData> importMesh(const QString &path, QString &error) {
+  QString key = QFileInfo(path).canonicalFilePath();
+  if (key.isEmpty()) {
+    error = QStringLiteral("No such file: %1").arg(path);
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> lk(g_cacheMtx);
+    // Drop entries whose meshes are gone so the map does not grow with
+    // every file ever opened
+    std::erase_if(g_cache, [](const auto &kv) { return kv.second.expired(); });
+    auto it = g_cache.find(key);
+    if (it != g_cache.end()) return it->second.lock();
+  }
+
+  QFile file(key);
+  if (!file.open(QIODevice::ReadOnly)) {
+    error = QStringLiteral("Cannot open %1: %2").arg(path, file.errorString());
+    return nullptr;
+  }
+  QByteArray bytes = file.readAll();
+
+  auto mesh = std::make_shared<MeshData>();
+  QString suffix = QFileInfo(key).suffix().toLower();
+  bool ok = false;
+  if (suffix == QLatin1String("obj")) {
+    ok = parseObj(bytes.constData(), bytes.constData() + bytes.size(), *mesh, error);
+  } else if (suffix == QLatin1String("gltf") || suffix == QLatin1String("glb")) {
+    ok = parseGltf(key, bytes, *mesh, error);
+  } else {
+    error = QStringLiteral("Unsupported mesh format: %1").arg(suffix);
+  }
+  if (!ok) return nullptr;
+  if (mesh->indices.empty()) {
+    error = QStringLiteral("No triangles in %1").arg(path);
+    return nullptr;
+  }
+  computeBounds(*mesh);
+
+  std::lock_guard<std::mutex> lk(g_cacheMtx);
+  // Another thread may have parsed the same file meanwhile; keep one copy
+  auto &slot = g_cache[key];
+  if (auto cached = slot.lock()) return cached;
+  slot = mesh;
+  return mesh;
+}
+
+// ============================================================================
+// MeshGeometry
+// ============================================================================
+
+MeshGeometry::MeshGeometry(QQuick3DObject *parent) : QQuick3DGeometry(parent) {}
+
+void MeshGeometry::setSource(const QUrl &source) {
+  if (m_source == source) return;
+  m_source = source;
+  emit sourceChanged();
+
+  uint64_t request = ++m_request;
+  if (source.isEmpty()) {
+    apply(nullptr, QString());
+    return;
+  }
+  m_status = Loading;
+  emit statusChanged();
+
+  QString path = source.isLocalFile() ? source.toLocalFile() : source.toString();
+  QPointer<MeshGeometry> self(this);
+  QThreadPool::globalInstance()->start([self, path, request] {
+    QString error;
+    auto mesh = importMesh(path, error);
+    // Hand the result to the GUI thread; dropped if the geometry is gone or
+    // its source changed meanwhile
+    QMetaObject::invokeMethod(QCoreApplication::instance(), [self, mesh, error, request] {
+      if (self && self->m_request == request) self->apply(mesh, error);
+    }, Qt::QueuedConnection);
+  });
+}
+
+void MeshGeometry::apply(const std::shared_ptr<const MeshData> &mesh, const QString &error) {
+  clear();
+  if (mesh) {
+    setStride(MeshData::kFloatsPerVertex * sizeof(float));
+    setPrimitiveType(PrimitiveType::Triangles);
+    setVertexData(QByteArray(reinterpret_cast<const char *>(mesh->vertices.data()),
+                             static_cast<qsizetype>(mesh->vertices.size() * sizeof(float))));
+    setIndexData(QByteArray(reinterpret_cast<const char *>(mesh->indices.data()),
+                            static_cast<qsizetype>(mesh->indices.size() * sizeof(uint32_t))));
+    addAttribute(Attribute::PositionSemantic, 0, Attribute::F32Type);
+    addAttribute(Attribute::NormalSemantic, 3 * sizeof(float), Attribute::F32Type);
+    addAttribute(Attribute::IndexSemantic, 0, Attribute::U32Type);
+    setBounds(mesh->boundsMin, mesh->boundsMax);
+  }
+  update();
+
+  m_status = mesh ? Ready : m_source.isEmpty() ? Null : Error;
+  m_error = error;
+  m_triangles = mesh ? static_cast<int>(mesh->indices.size() / 3) : 0;
+  emit statusChanged();
+}
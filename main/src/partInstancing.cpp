@@ -0,0 +1,183 @@
+// partInstancing.cpp
+#include "partInstancing.hpp"
+
+#include <QQuaternion>
+#include <QVariantMap>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+QVector3D toVector(const QVariant &value, const QVector3D &fallback) {
+  if (!value.isValid()) return fallback;
+  if (value.canConvert<QVector3D>() && value.metaType() != QMetaType::fromType<double>() &&
+      value.metaType() != QMetaType::fromType<int>()) {
+    return value.value<QVector3D>();
+  }
+  bool ok = false;
+  float uniform = value.toFloat(&ok);
+  return ok ? QVector3D(uniform, uniform, uniform) : fallback;
+}
+
+QColor blend(const QColor &a, const QColor &b, float t) {
+  return QColor::fromRgbF(a.redF() + (b.redF() - a.redF()) * t, a.greenF() + (b.greenF() - a.greenF()) * t,
+                          a.blueF() + (b.blueF() - a.blueF()) * t, a.alphaF() + (b.alphaF() - a.alphaF()) * t);
+}
+
+} // namespace
+
+PartInstancing::PartInstancing(QQuick3DObject *parent) : QQuick3DInstancing(parent) {}
+
+void PartInstancing::setGpio(GpioModel *gpio) {
+  if (m_gpio == gpio) return;
+  if (m_gpio) disconnect(m_gpio, nullptr, this, nullptr);
+  m_gpio = gpio;
+  if (m_gpio) {
+    connect(m_gpio, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &first, const QModelIndex &last) {
+              rowsChanged(Source::Gpio, first.row(), last.row());
+            });
+    connect(m_gpio, &QAbstractItemModel::modelReset, this, &PartInstancing::resolve);
+  }
+  resolve();
+  emit gpioChanged();
+}
+
+void PartInstancing::setAdc(AdcModel *adc) {
+  if (m_adc == adc) return;
+  if (m_adc) disconnect(m_adc, nullptr, this, nullptr);
+  m_adc = adc;
+  if (m_adc) {
+    connect(m_adc, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &first, const QModelIndex &last) {
+              rowsChanged(Source::Adc, first.row(), last.row());
+            });
+    connect(m_adc, &QAbstractItemModel::modelReset, this, &PartInstancing::resolve);
+  }
+  resolve();
+  emit adcChanged();
+}
+
+void PartInstancing::setParts(const QVariantList &parts) {
+  if (m_partList == parts) return;
+  m_partList = parts;
+
+  m_parts.clear();
+  m_parts.reserve(static_cast<size_t>(parts.size()));
+  for (const QVariant &value : parts) {
+    QVariantMap map = value.toMap();
+    Part part;
+    part.position = toVector(map.value(QStringLiteral("position")), part.position);
+    part.rotation = toVector(map.value(QStringLiteral("rotation")), part.rotation);
+    part.scale = toVector(map.value(QStringLiteral("scale")), part.scale);
+    if (map.contains(QStringLiteral("color"))) part.color = map.value(QStringLiteral("color")).value<QColor>();
+    part.activeColor = map.contains(QStringLiteral("activeColor"))
+                           ? map.value(QStringLiteral("activeColor")).value<QColor>()
+                           : part.color;
+    part.signal = map.value(QStringLiteral("signal")).toString();
+    if (part.signal.startsWith(QLatin1String("adc:"))) {
+      part.source = Source::Adc;
+    } else if (!part.signal.isEmpty()) {
+      part.source = Source::Gpio;
+    }
+    part.activeRotation = toVector(map.value(QStringLiteral("activeRotation")), part.activeRotation);
+    part.axis = toVector(map.value(QStringLiteral("axis")), part.axis).normalized();
+    part.minAngle = map.value(QStringLiteral("minAngle"), part.minAngle).toFloat();
+    part.maxAngle = map.value(QStringLiteral("maxAngle"), part.maxAngle).toFloat();
+    part.minValue = map.value(QStringLiteral("minValue"), part.minValue).toFloat();
+    part.maxValue = map.value(QStringLiteral("maxValue"), part.maxValue).toFloat();
+    m_parts.push_back(part);
+  }
+  resolve();
+  emit partsChanged();
+}
+
+// Binds parts to model rows; runs when the parts or a model's rows change
+void PartInstancing::resolve() {
+  m_gpioParts.assign(m_gpio ? static_cast<size_t>(m_gpio->rowCount()) : 0, {});
+  m_adcParts.assign(m_adc ? static_cast<size_t>(m_adc->rowCount()) : 0, {});
+
+  for (size_t i = 0; i < m_parts.size(); ++i) {
+    Part &part = m_parts[i];
+    part.row = -1;
+    if (part.source == Source::Gpio && m_gpio && m_gpio->rowCount() > 0) {
+      QModelIndexList found = m_gpio->match(m_gpio->index(0), GpioModel::LabelRole, part.signal, 1,
+                                            Qt::MatchExactly);
+      if (!found.isEmpty()) part.row = found.first().row();
+    } else if (part.source == Source::Adc && m_adc) {
+      bool ok = false;
+      int channel = part.signal.mid(4).toInt(&ok);
+      if (ok && channel >= 0 && channel < m_adc->rowCount()) part.row = channel;
+    }
+    auto &bound = part.source == Source::Gpio ? m_gpioParts : m_adcParts;
+    if (part.row >= 0) bound[static_cast<size_t>(part.row)].push_back(static_cast<int>(i));
+    updateActivation(part);
+  }
+  m_rebuild = true;
+  markDirty();
+}
+
+void PartInstancing::rowsChanged(Source source, int first, int last) {
+  const auto &bound = source == Source::Gpio ? m_gpioParts : m_adcParts;
+  first = std::max(first, 0);
+  last = std::min(last, static_cast<int>(bound.size()) - 1);
+  bool changed = false;
+  for (int row = first; row <= last; ++row) {
+    for (int i : bound[static_cast<size_t>(row)]) {
+      Part &part = m_parts[static_cast<size_t>(i)];
+      float before = part.activation;
+      updateActivation(part);
+      if (part.activation == before) continue;
+      m_dirty.push_back(i);
+      changed = true;
+    }
+  }
+  if (changed) markDirty();
+}
+
+void PartInstancing::updateActivation(Part &part) const {
+  part.activation = 0.0f;
+  if (part.row < 0) return;
+  if (part.source == Source::Gpio && m_gpio) {
+    int state = m_gpio->data(m_gpio->index(part.row), GpioModel::StateRole).toInt();
+    part.activation = state == static_cast<int>(renode::GpioState::High) ? 1.0f : 0.0f;
+  } else if (part.source == Source::Adc && m_adc) {
+    float value = m_adc->data(m_adc->index(part.row), AdcModel::ValueRole).toFloat();
+    float span = part.maxValue - part.minValue;
+    part.activation = span != 0.0f ? std::clamp((value - part.minValue) / span, 0.0f, 1.0f) : 0.0f;
+  }
+}
+
+PartInstancing::InstanceTableEntry PartInstancing::entry(const Part &part) const {
+  QVector3D euler = part.rotation;
+  if (part.source == Source::Gpio) euler += part.activeRotation * part.activation;
+  QQuaternion rotation = QQuaternion::fromEulerAngles(euler);
+  if (part.source == Source::Adc && !part.axis.isNull()) {
+    // Spin about the model's own axis; adding it to the Euler angles would
+    // only be right for axes aligned with the last-applied Euler axis
+    float angle = part.minAngle + (part.maxAngle - part.minAngle) * part.activation;
+    rotation = rotation * QQuaternion::fromAxisAndAngle(part.axis, angle);
+  }
+  return calculateTableEntryFromQuaternion(part.position, part.scale, rotation,
+                                           blend(part.color, part.activeColor, part.activation),
+                                           QVector4D(part.activation, 0, 0, 0));
+}
+
+// Render thread, GUI thread blocked
+QByteArray PartInstancing::getInstanceBuffer(int *instanceCount) {
+  constexpr qsizetype kEntrySize = sizeof(InstanceTableEntry);
+  if (m_rebuild) {
+    m_buffer.resize(static_cast<qsizetype>(m_parts.size()) * kEntrySize);
+    auto *entries = reinterpret_cast<InstanceTableEntry *>(m_buffer.data());
+    for (size_t i = 0; i < m_parts.size(); ++i) entries[i] = entry(m_parts[i]);
+    m_rebuild = false;
+  } else if (!m_dirty.empty()) {
+    // Detaches once if the renderer still holds the previous buffer
+    auto *entries = reinterpret_cast<InstanceTableEntry *>(m_buffer.data());
+    for (int i : m_dirty) entries[i] = entry(m_parts[static_cast<size_t>(i)]);
+  }
+  m_dirty.clear();
+  if (instanceCount) *instanceCount = static_cast<int>(m_parts.size());
+  return m_buffer;
+}
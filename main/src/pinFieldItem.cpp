@@ -0,0 +1,204 @@
+// pinFieldItem.cpp
+#include "pinFieldItem.hpp"
+
+#include <QMouseEvent>
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace renode;
+
+namespace {
+
+constexpr int kVerticesPerPin = 6;  // two triangles
+
+} // namespace
+
+PinFieldItem::PinFieldItem(QQuickItem *parent) : QQuickItem(parent) {
+  setFlag(ItemHasContents, true);
+  setAcceptedMouseButtons(Qt::LeftButton);
+}
+
+void PinFieldItem::setModel(GpioModel *model) {
+  if (m_model == model) return;
+  if (m_model) disconnect(m_model, nullptr, this, nullptr);
+  m_model = model;
+  if (m_model) {
+    connect(m_model, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex &first, const QModelIndex &last) { rowsChanged(first.row(), last.row()); });
+    connect(m_model, &QAbstractItemModel::modelReset, this, &PinFieldItem::relayout);
+  }
+  relayout();
+  emit modelChanged();
+}
+
+void PinFieldItem::setColumns(int columns) {
+  columns = std::max(columns, 1);
+  if (m_columns == columns) return;
+  m_columns = columns;
+  relayout();
+  emit layoutChanged();
+}
+
+void PinFieldItem::setCellSize(double size) {
+  size = std::max(size, 1.0);
+  if (m_cellSize == size) return;
+  m_cellSize = size;
+  relayout();
+  emit layoutChanged();
+}
+
+void PinFieldItem::setSpacing(double spacing) {
+  spacing = std::max(spacing, 0.0);
+  if (m_spacing == spacing) return;
+  m_spacing = spacing;
+  relayout();
+  emit layoutChanged();
+}
+
+void PinFieldItem::setInteractive(bool interactive) {
+  if (m_interactive == interactive) return;
+  m_interactive = interactive;
+  setAcceptedMouseButtons(interactive ? Qt::LeftButton : Qt::NoButton);
+  emit interactiveChanged();
+}
+
+void PinFieldItem::setLowColor(const QColor &color) {
+  if (m_lowColor == color) return;
+  m_lowColor = color;
+  m_rebuild = true;
+  update();
+  emit colorsChanged();
+}
+
+void PinFieldItem::setHighColor(const QColor &color) {
+  if (m_highColor == color) return;
+  m_highColor = color;
+  m_rebuild = true;
+  update();
+  emit colorsChanged();
+}
+
+void PinFieldItem::setHighZColor(const QColor &color) {
+  if (m_highZColor == color) return;
+  m_highZColor = color;
+  m_rebuild = true;
+  update();
+  emit colorsChanged();
+}
+
+void PinFieldItem::relayout() {
+  int pins = m_model ? m_model->rowCount() : 0;
+  int lines = (pins + m_columns - 1) / m_columns;
+  double pitch = m_cellSize + m_spacing;
+  setImplicitWidth(pins > 0 ? std::min(pins, m_columns) * pitch - m_spacing : 0.0);
+  setImplicitHeight(lines > 0 ? lines * pitch - m_spacing : 0.0);
+  m_dirtyRows.clear();
+  m_rebuild = true;
+  update();
+}
+
+void PinFieldItem::rowsChanged(int first, int last) {
+  if (m_rebuild) return;
+  for (int row = std::max(first, 0); row <= last; ++row) m_dirtyRows.push_back(row);
+  // Hidden items are not synced; past one entry per pin a full pass is cheaper
+  if (m_model && m_dirtyRows.size() > static_cast<size_t>(m_model->rowCount())) {
+    m_dirtyRows.clear();
+    m_rebuild = true;
+  }
+  update();
+}
+
+int PinFieldItem::pinAt(double x, double y) const {
+  if (!m_model || x < 0.0 || y < 0.0) return -1;
+  double pitch = m_cellSize + m_spacing;
+  int column = static_cast<int>(x / pitch);
+  int line = static_cast<int>(y / pitch);
+  if (column >= m_columns) return -1;
+  if (x - column * pitch >= m_cellSize || y - line * pitch >= m_cellSize) return -1;
+  int row = line * m_columns + column;
+  return row < m_model->rowCount() ? row : -1;
+}
+
+void PinFieldItem::mousePressEvent(QMouseEvent *event) {
+  m_pressedPin = pinAt(event->position().x(), event->position().y());
+  if (m_pressedPin < 0) {
+    event->ignore();
+    return;
+  }
+  event->accept();
+}
+
+// Toggles on release over the pressed cell, like a button
+void PinFieldItem::mouseReleaseEvent(QMouseEvent *event) {
+  int pin = pinAt(event->position().x(), event->position().y());
+  if (m_model && pin >= 0 && pin == m_pressedPin) {
+    auto state = m_model->table()->state(pin);
+    m_model->setPinState(pin, state == GpioState::High ? 0 : 1);
+  }
+  m_pressedPin = -1;
+}
+
+// Render thread, GUI thread blocked
+QSGNode *PinFieldItem::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
+  auto *node = static_cast<QSGGeometryNode *>(oldNode);
+  if (!node) {
+    node = new QSGGeometryNode;
+    auto *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    node->setMaterial(new QSGVertexColorMaterial);
+    node->setFlag(QSGNode::OwnsMaterial);
+    m_rebuild = true;
+  }
+
+  QSGGeometry *geometry = node->geometry();
+  auto table = m_model ? m_model->table() : nullptr;
+  int pins = table ? std::min(table->size(), m_model->rowCount()) : 0;
+  auto colorOf = [&](int row) {
+    switch (table->state(row)) {
+    case GpioState::High: return m_highColor;
+    case GpioState::HighZ: return m_highZColor;
+    default: return m_lowColor;
+    }
+  };
+  auto paint = [&](int row) {
+    QColor c = colorOf(row);
+    // Vertex colors are premultiplied
+    auto a = static_cast<uchar>(c.alpha());
+    auto r = static_cast<uchar>(c.red() * a / 255), g = static_cast<uchar>(c.green() * a / 255),
+         b = static_cast<uchar>(c.blue() * a / 255);
+    auto *v = geometry->vertexDataAsColoredPoint2D() + row * kVerticesPerPin;
+    for (int i = 0; i < kVerticesPerPin; ++i) v[i].set(v[i].x, v[i].y, r, g, b, a);
+  };
+
+  if (m_rebuild) {
+    geometry->allocate(pins * kVerticesPerPin);
+    auto *v = geometry->vertexDataAsColoredPoint2D();
+    double pitch = m_cellSize + m_spacing;
+    for (int row = 0; row < pins; ++row) {
+      auto x0 = static_cast<float>((row % m_columns) * pitch);
+      auto y0 = static_cast<float>((row / m_columns) * pitch);
+      auto x1 = x0 + static_cast<float>(m_cellSize), y1 = y0 + static_cast<float>(m_cellSize);
+      QSGGeometry::ColoredPoint2D *quad = v + row * kVerticesPerPin;
+      quad[0].x = x0; quad[0].y = y0;
+      quad[1].x = x1; quad[1].y = y0;
+      quad[2].x = x0; quad[2].y = y1;
+      quad[3].x = x1; quad[3].y = y0;
+      quad[4].x = x1; quad[4].y = y1;
+      quad[5].x = x0; quad[5].y = y1;
+      paint(row);
+    }
+    m_rebuild = false;
+  } else {
+    for (int row : m_dirtyRows) {
+      if (row < pins) paint(row);
+    }
+  }
+  m_dirtyRows.clear();
+  node->markDirty(QSGNode::DirtyGeometry);
+  return node;
+}
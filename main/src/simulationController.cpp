@@ -0,0 +1,343 @@
+// simulationController.cpp
+#include "simulationController.hpp"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+
+using namespace renode;
+
+// ============================================================================
+// SimulationWorker
+// ============================================================================
+
+SimulationWorker::SimulationWorker(std::mutex &stateMtx, SimulationState &state,
+                                   FrameThrottle &throttle, std::atomic<bool> &runRequested)
+    : m_stateMtx(stateMtx), m_state(state), m_throttle(throttle),
+      m_runRequested(runRequested) {}
+
+// Runs on the worker thread. Observers drop their peripheral handles before
+// the client goes (and terminates an owned Renode).
+SimulationWorker::~SimulationWorker() {
+  disconnectFromRenode();
+}
+
+template <typename Fn> void SimulationWorker::publish(Fn &&update) {
+  {
+    std::lock_guard<std::mutex> lk(m_stateMtx);
+    update(m_state);
+  }
+  m_throttle.request();
+}
+
+void SimulationWorker::notifyObservers() {
+  for (auto &kv : m_observers) kv.second.machine(m_machine);
+}
+
+void SimulationWorker::addObserver(int id, MachineObserver observer, AdvanceObserver advanced) {
+  auto it = m_observers.insert_or_assign(id, Observer{std::move(observer), std::move(advanced)}).first;
+  if (m_machine) it->second.machine(m_machine);
+}
+
+void SimulationWorker::removeObserver(int id) {
+  auto it = m_observers.find(id);
+  if (it == m_observers.end()) return;
+  if (m_machine) it->second.machine(nullptr);
+  m_observers.erase(it);
+}
+
+void SimulationWorker::runTask(const MachineObserver &task) {
+  task(m_machine);
+}
+
+void SimulationWorker::connectToRenode(const SimulationSettings &settings) {
+  disconnectFromRenode();
+  publish([](SimulationState &s) { s.status = QStringLiteral("Launching Renode..."); });
+
+  RenodeConfig config;
+  config.renode_path = settings.renodePath.toStdString();
+  config.script_path = settings.scriptPath.toStdString();
+  config.port = settings.port;
+  config.monitor_port = settings.monitorPort;
+  config.startup_timeout_ms = 15000;
+
+  try {
+    m_client = ExternalControlClient::launchAndConnect(config);
+  } catch (const std::exception &) {
+    // Fall back to a Renode that is already running
+    try {
+      m_client = ExternalControlClient::connect(config.host, config.port);
+    } catch (const std::exception &e) {
+      QString message = QStringLiteral("Connection failed: %1").arg(QString::fromUtf8(e.what()));
+      publish([&](SimulationState &s) { s.status = message; });
+      return;
+    }
+  }
+
+  if (!m_client->performHandshake()) {
+    m_client.reset();
+    publish([](SimulationState &s) { s.status = QStringLiteral("Handshake failed"); });
+    return;
+  }
+  m_client->connectMonitor(config.host, config.monitor_port);
+
+  Error err;
+  m_machine = m_client->getMachine(settings.machineName.toStdString(), err);
+  if (!m_machine) {
+    m_client.reset();
+    QString message = QStringLiteral("Machine '%1' unavailable: %2")
+                          .arg(settings.machineName, QString::fromStdString(err.message));
+    publish([&](SimulationState &s) { s.status = message; });
+    return;
+  }
+
+  // Time advances only through the run loop's RUN_FOR quanta
+  m_machine->pause();
+  uint64_t now = m_machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+  publish([&](SimulationState &s) {
+    s.connected = true;
+    s.running = false;
+    s.simTimeUs = now;
+    s.realTimeFactor = 0.0;
+    s.status = QStringLiteral("Connected");
+  });
+  notifyObservers();
+}
+
+void SimulationWorker::disconnectFromRenode() {
+  m_runRequested = false;
+  if (!m_client) return;
+  if (m_machine) {
+    m_machine.reset();
+    notifyObservers();
+  }
+  m_client.reset();
+  publish([](SimulationState &s) {
+    s.connected = false;
+    s.running = false;
+    s.realTimeFactor = 0.0;
+    s.status = QStringLiteral("Disconnected");
+  });
+}
+
+void SimulationWorker::startRunning(quint64 quantumUs) {
+  m_quantumUs = std::max<quint64>(quantumUs, 1);
+  if (!m_machine) {
+    m_runRequested = false;
+    return;
+  }
+  publish([](SimulationState &s) {
+    s.running = true;
+    s.status = QStringLiteral("Running");
+  });
+  if (!m_stepQueued) {
+    m_stepQueued = true;
+    QMetaObject::invokeMethod(this, &SimulationWorker::step, Qt::QueuedConnection);
+  }
+}
+
+// One quantum of the run loop. The next one is queued behind whatever the
+// GUI posted meanwhile, so pause and reset never wait for the whole run.
+void SimulationWorker::step() {
+  m_stepQueued = false;
+  if (!m_machine || !m_runRequested) {
+    publish([](SimulationState &s) {
+      if (s.running) s.status = QStringLiteral("Paused");
+      s.running = false;
+    });
+    return;
+  }
+
+  uint64_t startUs = m_machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+  QElapsedTimer wall;
+  wall.start();
+  if (Error err = m_machine->runFor(m_quantumUs, TimeUnit::TU_MICROSECONDS)) {
+    m_runRequested = false;
+    QString message = QString::fromStdString(err.message);
+    publish([&](SimulationState &s) {
+      s.running = false;
+      s.status = message;
+    });
+    return;
+  }
+  refreshTime(static_cast<double>(wall.nsecsElapsed()) / 1e9, startUs);
+
+  m_stepQueued = true;
+  QMetaObject::invokeMethod(this, &SimulationWorker::step, Qt::QueuedConnection);
+}
+
+void SimulationWorker::runFor(quint64 durationUs) {
+  if (!m_machine) return;
+  uint64_t startUs = m_machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+  QElapsedTimer wall;
+  wall.start();
+  if (Error err = m_machine->runFor(durationUs, TimeUnit::TU_MICROSECONDS)) {
+    QString message = QString::fromStdString(err.message);
+    publish([&](SimulationState &s) { s.status = message; });
+    return;
+  }
+  refreshTime(static_cast<double>(wall.nsecsElapsed()) / 1e9, startUs);
+}
+
+void SimulationWorker::reset() {
+  if (!m_machine) return;
+  Error err = m_machine->reset();
+  // Reset restarts the machine; keep it under run-loop control
+  m_machine->pause();
+  uint64_t now = m_machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+  QString status = err ? QString::fromStdString(err.message) : QStringLiteral("Reset");
+  publish([&](SimulationState &s) {
+    s.simTimeUs = now;
+    s.realTimeFactor = 0.0;
+    s.status = status;
+  });
+}
+
+void SimulationWorker::refreshTime(double wallSeconds, uint64_t startUs) {
+  // Served from the machine's cached clock, no round trip
+  uint64_t now = m_machine->getTime(TimeUnit::TU_MICROSECONDS).value;
+  double factor = wallSeconds > 0.0 ? static_cast<double>(now - startUs) / 1e6 / wallSeconds : 0.0;
+  publish([&](SimulationState &s) {
+    s.simTimeUs = now;
+    s.realTimeFactor = factor;
+  });
+  for (auto &kv : m_observers) {
+    if (kv.second.advanced) kv.second.advanced(now);
+  }
+}
+
+// ============================================================================
+// SimulationController
+// ============================================================================
+
+SimulationController::SimulationController(QObject *parent)
+    : QObject(parent), m_throttle([this] { flush(); }) {
+  m_settings.renodePath = qEnvironmentVariable("RENODE_PATH", QStringLiteral("renode"));
+  m_settings.machineName = QStringLiteral("stm32-machine");
+  m_view.status = QStringLiteral("Disconnected");
+  m_events.setStatsListener([this] { emit eventStatsChanged(); });
+
+  m_worker = new SimulationWorker(m_stateMtx, m_state, m_throttle, m_runRequested);
+  m_worker->moveToThread(&m_thread);
+  connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+
+  m_thread.setObjectName(QStringLiteral("renode-worker"));
+  m_thread.start();
+}
+
+SimulationController::~SimulationController() {
+  // The worker finishes its current quantum, then is deleted on its thread
+  m_runRequested = false;
+  m_thread.quit();
+  m_thread.wait();
+}
+
+void SimulationController::setWindow(QQuickWindow *window) {
+  if (m_window == window) return;
+  m_window = window;
+  m_events.setWindow(window);
+  emit windowChanged();
+}
+
+void SimulationController::setRenodePath(const QString &path) {
+  if (m_settings.renodePath == path) return;
+  m_settings.renodePath = path;
+  emit renodePathChanged();
+}
+
+void SimulationController::setScriptPath(const QString &path) {
+  if (m_settings.scriptPath == path) return;
+  m_settings.scriptPath = path;
+  emit scriptPathChanged();
+}
+
+void SimulationController::setMachineName(const QString &name) {
+  if (m_settings.machineName == name) return;
+  m_settings.machineName = name;
+  emit machineNameChanged();
+}
+
+void SimulationController::setQuantumMs(int ms) {
+  ms = std::max(ms, 1);
+  if (m_quantumMs == ms) return;
+  m_quantumMs = ms;
+  emit quantumMsChanged();
+}
+
+void SimulationController::connectToRenode() {
+  QMetaObject::invokeMethod(m_worker, [worker = m_worker, settings = m_settings] {
+    worker->connectToRenode(settings);
+  }, Qt::QueuedConnection);
+}
+
+void SimulationController::disconnectFromRenode() {
+  m_runRequested = false;
+  QMetaObject::invokeMethod(m_worker, &SimulationWorker::disconnectFromRenode,
+                            Qt::QueuedConnection);
+}
+
+void SimulationController::run() {
+  if (!m_view.connected) return;
+  m_runRequested = true;
+  quint64 quantumUs = static_cast<quint64>(m_quantumMs) * 1000;
+  QMetaObject::invokeMethod(m_worker, [worker = m_worker, quantumUs] {
+    worker->startRunning(quantumUs);
+  }, Qt::QueuedConnection);
+}
+
+void SimulationController::pause() {
+  // Seen by the worker at the next quantum boundary, ahead of any queue
+  m_runRequested = false;
+}
+
+void SimulationController::reset() {
+  m_runRequested = false;
+  QMetaObject::invokeMethod(m_worker, &SimulationWorker::reset, Qt::QueuedConnection);
+}
+
+void SimulationController::runFor(int milliseconds) {
+  if (milliseconds <= 0) return;
+  quint64 durationUs = static_cast<quint64>(milliseconds) * 1000;
+  QMetaObject::invokeMethod(m_worker, [worker = m_worker, durationUs] {
+    worker->runFor(durationUs);
+  }, Qt::QueuedConnection);
+}
+
+int SimulationController::observeMachine(SimulationWorker::MachineObserver observer,
+                                         SimulationWorker::AdvanceObserver advanced) {
+  int id = m_nextObserverId++;
+  QMetaObject::invokeMethod(m_worker, [worker = m_worker, id, observer = std::move(observer),
+                                       advanced = std::move(advanced)]() mutable {
+    worker->addObserver(id, std::move(observer), std::move(advanced));
+  }, Qt::QueuedConnection);
+  return id;
+}
+
+void SimulationController::unobserveMachine(int id) {
+  QMetaObject::invokeMethod(m_worker, [worker = m_worker, id] {
+    worker->removeObserver(id);
+  }, Qt::QueuedConnection);
+}
+
+void SimulationController::withMachine(SimulationWorker::MachineObserver task) {
+  QMetaObject::invokeMethod(m_worker, [worker = m_worker, task = std::move(task)] {
+    worker->runTask(task);
+  }, Qt::QueuedConnection);
+}
+
+// Runs at most once per display frame (FrameThrottle)
+void SimulationController::flush() {
+  SimulationState next;
+  {
+    std::lock_guard<std::mutex> lk(m_stateMtx);
+    next = m_state;
+  }
+
+  SimulationState prev = m_view;
+  m_view = next;
+  if (prev.connected != next.connected) emit connectedChanged();
+  if (prev.running != next.running) emit runningChanged();
+  if (prev.simTimeUs != next.simTimeUs) emit simTimeMsChanged();
+  if (prev.realTimeFactor != next.realTimeFactor) emit realTimeFactorChanged();
+  if (prev.status != next.status) emit statusChanged();
+}
@@ -39,6 +39,10 @@ enum class GpioState : uint8_t { Low = 0, High = 1, HighZ = 2 };
 
 using GpioCallback = std::function<void(int pin, GpioState newState)>;
 
+// GPIO callback carrying the virtual time (microseconds) of the edge
+using GpioEventCallback =
+    std::function<void(int pin, GpioState newState, uint64_t timestampUs)>;
+
 // Peripheral descriptor (type + path + optional metadata)
 struct PeripheralDescriptor {
     std::string type;
@@ -171,7 +175,7 @@ static void write_string(std::vector<uint8_t> &buf, const std::string &s) {
 static bool write_all(int fd, const uint8_t *buf, size_t len) {
   size_t sent = 0;
   while (sent < len) {
-    ssize_t r = send(fd, buf + sent, len - sent, 0);
+    ssize_t r = send(fd, buf + sent, len - sent, MSG_NOSIGNAL);  // EPIPE, not SIGPIPE, if Renode died
     if (r <= 0)
       return false;
     sent += static_cast<size_t>(r);
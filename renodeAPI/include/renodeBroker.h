@@ -0,0 +1,69 @@
+// renodeBroker.h
+// Shares one Renode external-control connection among many local clients.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "renodeInterface.h"
+
+namespace renode {
+
+struct BrokerConfig {
+  // Unix socket downstream clients connect to (ExternalControlClient::connectUnix).
+  // A stale socket file at this path is replaced.
+  std::string socket_path = "/tmp/digitwin-broker.sock";
+  // Pending output per client before further events to it are dropped.
+  // Command replies are never dropped.
+  size_t max_client_buffer = 4u << 20;
+};
+
+// Renode's control server talks to a single client. The broker holds that
+// connection and serves any number of downstream clients speaking the same
+// protocol over a Unix socket, from one I/O thread:
+//  - commands from all clients are serialized onto the upstream connection;
+//    identical GET_TIME / GET_MACHINE requests that queue up while another
+//    command is in flight are answered by a single upstream round trip
+//  - GPIO event subscriptions for the same (instance, pin) share one upstream
+//    registration, and every ASYNC_EVENT is fanned out to all subscribers
+//    under their own event descriptors
+//  - events are read even while no command is in flight, so observers that
+//    only listen cost nothing upstream
+class RenodeBroker {
+public:
+  struct Stats {
+    uint64_t clients = 0;            // currently connected
+    uint64_t accepted = 0;           // connections accepted in total
+    uint64_t requests = 0;           // commands received from clients
+    uint64_t upstream_commands = 0;  // commands sent to Renode
+    uint64_t coalesced = 0;          // requests answered by another's round trip
+    uint64_t events_in = 0;          // ASYNC_EVENTs received from Renode
+    uint64_t events_out = 0;         // ASYNC_EVENTs queued to clients
+    uint64_t events_dropped = 0;     // not queued: client buffer full
+  };
+
+  // Take over a connected, handshaken client and start serving socket_path
+  static std::unique_ptr<RenodeBroker> start(std::unique_ptr<ExternalControlClient> upstream,
+                                             const BrokerConfig &config, Error &err) noexcept;
+
+  // Stops the I/O thread, disconnects clients and removes the socket file
+  ~RenodeBroker();
+  RenodeBroker(const RenodeBroker &) = delete;
+  RenodeBroker &operator=(const RenodeBroker &) = delete;
+
+  const std::string &socketPath() const noexcept;
+
+  // The upstream monitor connection, if any (safe to use from any thread).
+  // The control connection itself belongs to the broker thread.
+  Monitor *monitor() noexcept;
+
+  Stats stats() const;
+
+private:
+  struct Impl;
+  explicit RenodeBroker(std::unique_ptr<Impl> impl) noexcept;
+  std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace renode
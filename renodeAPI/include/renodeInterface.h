@@ -1,11 +1,14 @@
 // renodeInterface.h
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sys/types.h>
 
@@ -16,6 +19,8 @@ namespace renode {
 // Forward declarations
 class AMachine;
 class Monitor;
+class StimulusRecorder;
+class LogStream;
 
 // Configuration for launching Renode subprocess
 struct RenodeConfig {
@@ -23,10 +28,27 @@ struct RenodeConfig {
   std::string script_path;         // .resc script to load (optional)
   std::string host = "127.0.0.1";  // Host to connect to
   uint16_t port = 5555;            // External control port
-  uint16_t monitor_port = 5556;    // Monitor telnet port (0 to disable)
+  uint16_t monitor_port = 5556;    // Monitor telnet port (0 to disable;
+                                   // required by start_control_server)
   bool console_mode = false;        // --console flag
   bool disable_gui = false;         // --disable-gui flag
   int startup_timeout_ms = 10000;  // Max time to wait for Renode to start
+  bool start_control_server = false; // create the external control server on
+                                     // `port` via the monitor (SERVER_START_COMMAND)
+                                     // instead of relying on the script
+  size_t log_capacity = 4096;      // Renode output lines kept in RenodeProcess::log()
+                                   // (0 = read and discard)
+};
+
+// Per-phase startup timings of a launched Renode, in ns since launch() began.
+// Phases that did not happen (e.g. no monitor port) stay 0.
+struct RenodeStartupTimings {
+  uint64_t spawnNs = 0;          // fork + exec returned in the parent
+  uint64_t firstOutputNs = 0;    // first line on Renode's stdout/stderr
+  uint64_t monitorReadyNs = 0;   // monitor port accepted a connection
+  uint64_t serverStartNs = 0;    // SERVER_START_COMMAND completed (start_control_server)
+  uint64_t controlReadyNs = 0;   // external control port accepted a connection
+  uint64_t totalNs = 0;          // launch() returned
 };
 
 // RAII wrapper for Renode subprocess
@@ -45,6 +67,10 @@ public:
 
   // Launch Renode with given config. Returns nullptr on failure.
   static std::unique_ptr<RenodeProcess> launch(const RenodeConfig &config);
+  // Same, appending Renode's output to an existing log (e.g. the one of a
+  // process being replaced) so its subscribers and cursors carry over
+  static std::unique_ptr<RenodeProcess> launch(const RenodeConfig &config,
+                                               std::shared_ptr<LogStream> log);
 
   // Check if process is still running
   bool isRunning() const noexcept;
@@ -58,10 +84,47 @@ public:
   // Get the port Renode is listening on
   uint16_t port() const noexcept { return port_; }
 
+  // Captured stdout/stderr lines (nullptr when RenodeConfig::log_capacity is 0)
+  const std::shared_ptr<LogStream> &log() const noexcept { return log_; }
+
+  // How long each startup phase took
+  const RenodeStartupTimings &startupTimings() const noexcept { return timings_; }
+
+  // Hand over the control connection opened while probing readiness, so the
+  // client does not need to reconnect. Returns -1 if already taken.
+  int takeControlSocket() noexcept;
+  // Same for the monitor; nullptr if taken or monitor_port is 0
+  std::unique_ptr<Monitor> takeMonitor() noexcept;
+
 private:
   explicit RenodeProcess(pid_t pid, uint16_t port) noexcept;
+  void startOutputReader(std::string pending) noexcept;
+  void stopOutputReader() noexcept;
+
   pid_t pid_ = -1;
   uint16_t port_ = 5555;
+  int outputFd_ = -1;   // read end of the child's stdout/stderr pipe
+  int controlFd_ = -1;  // connected control socket until taken
+  std::unique_ptr<Monitor> monitor_;  // readiness probe connection until taken
+  std::shared_ptr<LogStream> log_;
+  std::shared_ptr<std::atomic<bool>> readerStop_;
+  std::thread readerThread_;
+  RenodeStartupTimings timings_;
+};
+
+// Supervised session (ExternalControlClient::supervise): how to rebuild the
+// emulation after the owned Renode process dies.
+struct SupervisionConfig {
+  // Emulation state to relaunch from, written by checkpoint(). Empty: a file
+  // in /tmp named after the process and control port, deleted together with
+  // the client.
+  std::string checkpoint_path;
+  // Monitor commands rebuilding the session while no checkpoint exists yet
+  std::vector<std::string> setup_commands;
+  // After this many relaunches failures reach the caller again
+  int max_restarts = 3;
+  // Called after each successful recovery with the restart count
+  std::function<void(int restarts)> on_restart;
 };
 
 // Fatal exception for unrecoverable errors
@@ -88,6 +151,10 @@ public:
   static std::unique_ptr<ExternalControlClient>
   connect(const std::string &host = "127.0.0.1", uint16_t port = 5555);
 
+  // Connect to a RenodeBroker's Unix socket; behaves like a direct
+  // connection to the broker's Renode. Throws RenodeException on failure.
+  static std::unique_ptr<ExternalControlClient> connectUnix(const std::string &socketPath);
+
   // Launch Renode and connect. Owns the Renode process (kills on destruction).
   static std::unique_ptr<ExternalControlClient>
   launchAndConnect(const RenodeConfig &config);
@@ -95,9 +162,17 @@ public:
   // *Disconnect explicitly, Destructor will disconnect.
   void disconnect() noexcept;
 
+  // Shut the control and monitor sockets down without closing them, so a
+  // command blocked on another thread fails promptly. Safe to call while
+  // another thread uses the client; the client is unusable afterwards.
+  void interrupt() noexcept;
+
   // Get the Monitor connection (if available). Returns nullptr if not connected.
   Monitor* getMonitor() noexcept;
 
+  // The owned Renode process (launchAndConnect only), nullptr otherwise
+  const RenodeProcess* process() const noexcept { return process_.get(); }
+
   // Connect to monitor socket (call after handshake succeeds)
   bool connectMonitor(const std::string &host = "127.0.0.1", uint16_t port = 5556);
 
@@ -112,6 +187,20 @@ public:
   // Get machine or throw if not found.
   std::shared_ptr<AMachine> getMachineOrThrow(const std::string &name);
 
+  // Create a machine through the monitor ("mach create"), run setupCommands
+  // with it selected (one pipelined batch) and return its handle.
+  std::shared_ptr<AMachine> createMachine(const std::string &name,
+                                          const std::vector<std::string> &setupCommands,
+                                          Error &err) noexcept;
+
+  // Remove a machine ("mach rem") and verify over the control connection
+  // that it is gone. Handles to it are invalidated.
+  Error removeMachine(const std::string &name) noexcept;
+
+  // Names of every machine in the emulation, in Renode's order, from the
+  // monitor's "mach" listing
+  Result<std::vector<std::string>> listMachines() noexcept;
+
   // Run emulation for `duration` in given unit. Returns Error on failure.
   Error runFor(uint64_t duration, TimeUnit unit) noexcept;
 
@@ -123,8 +212,36 @@ public:
 
   // Get current emulation time with unit conversion helper
   Result<uint64_t> getCurrentTime(uint64_t &outValue, TimeUnit unit) noexcept;
-  
+
+  // Forget cached machines and invalidate every handle vended so far, e.g.
+  // after the server-side emulation was cleared. The connection is kept.
+  void resetSessionState() noexcept;
+
+  // Capture every GPIO/ADC/bus stimulus and monitor command issued through
+  // this client. Pass nullptr to stop recording.
+  void setRecorder(std::shared_ptr<StimulusRecorder> recorder) noexcept;
+
+  // Survive Renode crashes (launchAndConnect clients with a monitor only).
+  // When the process exits or the control socket fails, Renode is relaunched,
+  // the handshake and monitor connection are redone, the last checkpoint is
+  // restored (or setup_commands rerun), machines, peripherals and GPIO event
+  // subscriptions are re-registered and the process log keeps its
+  // subscribers. Subscriptions made before supervise() are only re-registered
+  // when their Gpio is next used. RUN_FOR and GET_TIME are retried;
+  // any other command interrupted by the crash fails once and works again on
+  // the next call. A restart replaces the Monitor returned by getMonitor().
+  // The client must not be moved while supervised.
+  Error supervise(SupervisionConfig config) noexcept;
+
+  // Save the current emulation as the state to relaunch from
+  Error checkpoint() noexcept;
+
+  // Relaunches performed so far in supervised mode
+  int restartCount() const noexcept { return restarts_; }
+
 private:
+  friend class RenodeBroker;  // drives the upstream connection directly
+  bool recover(const std::string &reason) noexcept;
   void send_bytes(const uint8_t *data, size_t len);
   std::vector<uint8_t> recv_response(ApiCommand expected_command);
   std::vector<uint8_t> send_command(ApiCommand commandId, const std::vector<uint8_t> &payload);
@@ -134,6 +251,8 @@ private:
   std::unique_ptr<Impl> pimpl_;
   std::unique_ptr<RenodeProcess> process_;  // Optional: owned Renode subprocess
   std::unique_ptr<Monitor> monitor_;        // Optional: monitor connection
+  std::optional<SupervisionConfig> supervision_;
+  int restarts_ = 0;
   explicit ExternalControlClient(std::unique_ptr<Impl> impl) noexcept;
   ExternalControlClient(std::unique_ptr<Impl> impl,
                         std::unique_ptr<RenodeProcess> process,
@@ -141,6 +260,10 @@ private:
 };
 
 
+// Renode's monitor reports failures as text rather than a status code: true
+// when a command's output contains one of its error messages
+bool monitorReportedError(const std::string &output) noexcept;
+
 // Monitor: execute Renode monitor commands via telnet socket
 class Monitor {
 public:
@@ -157,10 +280,41 @@ public:
   // Connect to Renode monitor socket
   static std::unique_ptr<Monitor> connect(const std::string &host = "127.0.0.1",
                                           uint16_t port = 5556);
+  // Take over an already connected blocking socket (closed on failure);
+  // host and port are only used in messages
+  static std::unique_ptr<Monitor> adopt(int fd, const std::string &host, uint16_t port);
 
   // Execute a monitor command and return the output
   Result<std::string> execute(const std::string &command) noexcept;
 
+  // Pipeline several single-line commands: they are written in one send and
+  // the output is split back per command, so the batch costs one round trip
+  // instead of one per line. Results are in command order; monitor-reported
+  // errors show up in the output text, as with execute().
+  std::vector<Result<std::string>>
+  executeBatch(const std::vector<std::string> &commands) noexcept;
+
+  // The connection is served by its own I/O thread: these only queue the
+  // command and return. Commands queued while another is in flight are
+  // pipelined together; execution order is submission order. execute() and
+  // executeBatch() are the same calls waiting on the result. Because of the
+  // pipelining every command must be a single line (error code 2 otherwise).
+  std::future<Result<std::string>> executeAsync(std::string command);
+  std::future<std::vector<Result<std::string>>>
+  executeBatchAsync(std::vector<std::string> commands);
+  // Callback form; done runs on the monitor I/O thread and may queue further
+  // commands (they run inline there). Exceptions thrown by done are logged
+  // and dropped.
+  void executeAsync(std::string command, std::function<void(Result<std::string>)> done);
+
+  // Machine selected by the last reply's prompt ("" when none). Another
+  // thread's queued "mach set" may change it before your next command runs.
+  std::string selectedMachine() const;
+
+  // Shut the socket down so queued and in-flight commands fail (see
+  // ExternalControlClient::interrupt)
+  void interrupt() noexcept;
+
   // Convenience methods
   Error loadPlatformDescription(const std::string &path) noexcept;
   Error loadELF(const std::string &path) noexcept;
@@ -168,6 +322,15 @@ public:
   Error start() noexcept;
   Error reset() noexcept;
 
+  // Emulation checkpoint to/from a file ("Save @path" / "Load @path").
+  // Prefer AMachine::saveSnapshot/restoreSnapshot, which also invalidate
+  // client-side handles.
+  Error saveSnapshot(const std::string &path) noexcept;
+  Error loadSnapshot(const std::string &path) noexcept;
+
+  // Record executed commands into a stimulus log (nullptr disables)
+  void setRecorder(std::shared_ptr<StimulusRecorder> recorder) noexcept;
+
 private:
   struct Impl;
   std::unique_ptr<Impl> pimpl_;
@@ -0,0 +1,66 @@
+// renodeLoadCache.h
+// Content-addressed cache of loaded platform/firmware states.
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+
+namespace renode {
+
+class AMachine;
+
+struct LoadCacheConfig {
+  // Where snapshots and mirrored firmware live. Empty: $XDG_CACHE_HOME/digitwin
+  // or ~/.cache/digitwin.
+  std::string directory;
+  // Download http(s) files into the cache (with curl) and load the local copy
+  bool mirror_remote = true;
+  // Never download; remote files must already be mirrored
+  bool offline = false;
+};
+
+// Brings a machine to the state "freshly created, then these .repl/.elf files
+// loaded in order". The key is a SHA-256 over the machine name and the
+// contents of every file, including .repl files pulled in with `using`.
+// On a miss the files are loaded normally and an emulation snapshot is saved
+// under the key; on a hit the snapshot is restored instead, skipping
+// platform parsing and ELF loading. Snapshots hold the whole emulation, so
+// use this on an emulation that contains just this machine.
+class LoadCache {
+public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t uncacheable = 0;  // remote files without mirroring
+    uint64_t mirrored = 0;     // files downloaded into the cache
+  };
+
+  explicit LoadCache(LoadCacheConfig config = {});
+
+  // Returns true in value on a cache hit
+  Result<bool> load(AMachine &machine, const std::vector<std::string> &files) noexcept;
+
+  // Local path for a file or URL, downloading into the mirror if needed
+  Result<std::string> resolve(const std::string &pathOrUrl) noexcept;
+
+  // Hex cache key for machine + files, empty with error if a file is unreadable
+  Result<std::string> key(const std::string &machineName,
+                          const std::vector<std::string> &localFiles) noexcept;
+
+  const std::string &directory() const noexcept { return dir_; }
+  Stats stats() const;
+
+  static bool isRemote(const std::string &pathOrUrl) noexcept;
+
+private:
+  LoadCacheConfig config_;
+  std::string dir_;
+  mutable std::mutex mtx_;
+  Stats stats_;
+};
+
+} // namespace renode
@@ -0,0 +1,109 @@
+// renodeLog.h
+// Captured Renode stdout/stderr log stream.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace renode {
+
+enum class LogLevel : uint8_t { Noisy, Debug, Info, Warning, Error, Unknown };
+
+struct LogEntry {
+  uint64_t seq = 0;        // position in the stream, starts at 0
+  uint64_t wallNs = 0;     // steady-clock time the line was read
+  LogLevel level = LogLevel::Unknown;
+  bool truncated = false;  // line was longer than LogStream::kMaxLineBytes
+  std::string source;      // e.g. "stm32-machine/sysbus.usart2", may be empty
+  std::string text;        // message after level and source
+};
+
+struct LogFilter {
+  LogLevel minLevel = LogLevel::Noisy;  // Unknown-level lines always pass
+  std::string sourcePrefix;             // empty = any source
+  std::string contains;                 // empty = any text
+
+  bool matches(const LogEntry &entry) const noexcept;
+};
+
+// Bounded ring of recent log lines with a single producer (the process
+// output reader). Readers never block the producer: slots are versioned
+// like a seqlock and the producer simply overwrites the oldest one, so a
+// slow reader sees a gap, reported through its cursor, instead of stalling
+// Renode.
+class LogStream {
+public:
+  static constexpr size_t kMaxLineBytes = 240;
+
+  // Per-reader position; dropped counts entries overwritten before they
+  // could be read through this cursor
+  struct Cursor {
+    uint64_t next = 0;
+    uint64_t dropped = 0;
+  };
+
+  struct Stats {
+    uint64_t produced = 0;     // lines pushed
+    uint64_t overwritten = 0;  // lines evicted by newer ones
+    uint64_t truncated = 0;    // lines cut to kMaxLineBytes
+  };
+
+  using Subscriber = std::function<void(const LogEntry &)>;
+
+  // capacity is rounded up to a power of two
+  explicit LogStream(size_t capacity = 4096);
+  ~LogStream();
+  LogStream(const LogStream &) = delete;
+  LogStream &operator=(const LogStream &) = delete;
+
+  // Producer side: parse one raw output line and append it
+  void push(std::string_view line) noexcept;
+
+  // Copy out entries after cursor that match filter, at most maxEntries
+  std::vector<LogEntry> read(Cursor &cursor, const LogFilter &filter = {},
+                             size_t maxEntries = SIZE_MAX) const;
+  // Cursor positioned at the oldest entry still held / past the newest one
+  Cursor oldest() const noexcept;
+  Cursor latest() const noexcept;
+
+  // Call fn on the producer thread for every future matching line. Keep it
+  // short: it delays reading Renode's output. Returns an id for unsubscribe.
+  // A line being delivered while unsubscribe() runs may still reach fn.
+  int subscribe(LogFilter filter, Subscriber fn);
+  void unsubscribe(int id) noexcept;
+
+  Stats stats() const noexcept;
+  size_t capacity() const noexcept { return mask_ + 1; }
+
+  // Parse "[LEVEL] source: text" (optionally preceded by a timestamp)
+  static LogEntry parse(std::string_view line);
+
+private:
+  struct Slot;
+  bool load(uint64_t seq, LogEntry &out) const noexcept;
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+  std::atomic<uint64_t> head_{0};  // next sequence number to write
+  std::atomic<uint64_t> truncated_{0};
+
+  struct Subscription {
+    int id;
+    LogFilter filter;
+    Subscriber fn;
+  };
+  mutable std::mutex subMtx_;  // guards swapping subscribers_
+  // Copied on (un)subscribe; push() calls a snapshot outside subMtx_
+  std::shared_ptr<const std::vector<Subscription>> subscribers_ =
+      std::make_shared<const std::vector<Subscription>>();
+  std::atomic<bool> hasSubscribers_{false};
+  int nextSubscriberId_ = 1;
+};
+
+} // namespace renode
@@ -16,6 +16,64 @@ class Adc;
 class Gpio;
 class SysBus;
 class BusContext;
+class PeripheralTree;
+
+// Edge selector for GPIO stop conditions
+enum class GpioEdge : uint8_t { Rising, Falling, Any };
+
+// A condition that ends AMachine::runUntil(conditions, ...) early.
+// GPIO edges are event-driven (server-side REGISTER_EVENT, made once per Gpio
+// and pin and reused by later calls) and timestamped exactly; memory watches
+// and UART patterns are evaluated at every quantum boundary. Either way the
+// run only ends at the boundary of the quantum the trigger fell in.
+struct StopCondition {
+  enum class Kind : uint8_t { GpioEdge, MemoryWatch, UartPattern };
+  Kind kind = Kind::GpioEdge;
+
+  // GpioEdge
+  std::shared_ptr<Gpio> gpio;
+  int pin = 0;
+  GpioEdge edge = GpioEdge::Any;
+
+  // MemoryWatch: stop when (value & mask) == equals, or on any change of
+  // (value & mask) when equals is empty
+  std::shared_ptr<BusContext> bus;
+  uint64_t address = 0;
+  AccessWidth width = AccessWidth::AW_DWord;
+  uint64_t mask = ~uint64_t(0);
+  std::optional<uint64_t> equals;
+
+  // UartPattern: UART output is tapped through a Renode server-socket
+  // terminal listening on terminalPort
+  std::string uartPath;
+  std::string pattern;
+  uint16_t terminalPort = 0;
+
+  static StopCondition onGpioEdge(std::shared_ptr<Gpio> gpio, int pin,
+                                  GpioEdge edge = GpioEdge::Any);
+  static StopCondition onMemory(std::shared_ptr<BusContext> bus, uint64_t address,
+                                AccessWidth width,
+                                std::optional<uint64_t> equals = std::nullopt,
+                                uint64_t mask = ~uint64_t(0));
+  static StopCondition onUartPattern(const std::string &uartPath,
+                                     const std::string &pattern,
+                                     uint16_t terminalPort);
+};
+
+// In-memory emulation checkpoint (contents of a Renode Save file)
+struct EmulationSnapshot {
+  std::vector<uint8_t> data;
+  explicit operator bool() const noexcept { return !data.empty(); }
+};
+
+// Outcome of a condition-driven run
+struct StopInfo {
+  bool conditionMet = false;  // false: timeout elapsed first
+  size_t conditionIndex = 0;  // index into the conditions vector
+  uint64_t stopTimeUs = 0;    // virtual time the machine stopped at
+  uint64_t triggerTimeUs = 0; // virtual time of the trigger (exact for GPIO)
+  uint64_t observedValue = 0; // GPIO state or masked memory value
+};
 
 
 class AMachine : public std::enable_shared_from_this<AMachine> {
@@ -35,6 +93,11 @@ public:
 
   // Lifecycle controls
   Error loadConfiguration(const std::string &config) noexcept;
+  // Load several .repl/.elf files in one pipelined monitor round trip, in order
+  Error loadConfiguration(const std::vector<std::string> &configs) noexcept;
+  // Monitor command loadConfiguration issues for one file: "sysbus LoadELF"
+  // for ELF images, "machine LoadPlatformDescription" otherwise
+  static std::string loadCommand(const std::string &config);
   Error reset() noexcept;
   Error pause() noexcept;
   Error resume() noexcept;
@@ -43,6 +106,13 @@ public:
   // Ownership / query
   Result<std::vector<PeripheralDescriptor>> listPeripherals() noexcept;
 
+  // Cached, indexed peripheral inventory (tree, types, bus ranges). Fetched
+  // on first use and kept until the platform is reloaded through this
+  // machine or a snapshot is restored; pass refresh=true after changing the
+  // platform through the raw Monitor. Fetching selects this machine on the
+  // monitor and then restores the previous selection.
+  Result<std::shared_ptr<const PeripheralTree>> peripheralTree(bool refresh = false) noexcept;
+
   // Templated peripheral getter:
   // - T must be one of Adc, Gpio, SysBus, etc.
   template <typename T>
@@ -76,10 +146,31 @@ public:
   // Time conveniences
   Error runUntil(uint64_t timestampMicroseconds) noexcept; // run until absolute
                                                            // simulation time
+  // Run until any condition fires or timeoutUs of virtual time elapses.
+  // The machine advances in steps of at most quantumUs, which bounds the
+  // overshoot past the triggering event. quantumUs = 0 picks the step: the
+  // whole timeout when every condition is a GPIO edge (one round trip; the
+  // machine stops at the timeout and only triggerTimeUs marks the edge),
+  // otherwise kDefaultQuantumUs.
+  static constexpr uint64_t kDefaultQuantumUs = 1000;
+  Result<StopInfo> runUntil(const std::vector<StopCondition> &conditions,
+                            uint64_t timeoutUs,
+                            uint64_t quantumUs = 0) noexcept;
   Error stepInstructions(
-      uint64_t count) noexcept; // step N instructions on CPU (if supported)
+      uint64_t count) noexcept; // step N instructions on CPU (monitor "Step");
+                                // CPU path from metadata("cpu"), default sysbus.cpu
   Result<uint64_t> getTime(TimeUnit unit) const noexcept;
 
+  // Emulation checkpoints via the monitor's Save/Load. Take one after boot
+  // and restore it before each test instead of relaunching Renode. A restore
+  // invalidates server-side ids: the machine descriptor, cached clock and every
+  // Adc/Gpio/SysBus/BusContext handle (including GPIO event subscriptions)
+  // are re-established lazily on next use.
+  Error saveSnapshot(const std::string &path) noexcept;
+  Error restoreSnapshot(const std::string &path) noexcept;
+  Result<EmulationSnapshot> captureSnapshot() noexcept;
+  Error restoreSnapshot(const EmulationSnapshot &snapshot) noexcept;
+
   // Convenience: boolean validity
   explicit operator bool() const noexcept;
 
@@ -124,9 +215,14 @@ public:
   Error setState(int pin, GpioState state) noexcept;
 
   // Register callback for specific pin; returns a handle id to later unregister.
-  // Callback invoked on state change. This registers with Renode server for async events.
+  // Callback invoked on state change. The first callback on a pin subscribes
+  // to the server's async events; the subscription is shared by later
+  // callbacks on the pin and kept until this Gpio is destroyed.
   Error registerStateChangeCallback(int pin, GpioCallback cb, int &outHandle) noexcept;
 
+  // Same as above, but the callback also receives the edge's virtual timestamp
+  Error registerStateChangeCallback(int pin, GpioEventCallback cb, int &outHandle) noexcept;
+
   // Legacy overload (local-only callback, not registered with server)
   Error registerStateChangeCallback(GpioCallback cb, int &outHandle) noexcept;
   Error unregisterStateChangeCallback(int handle) noexcept;
@@ -170,6 +266,10 @@ public:
   Error read(uint64_t address, AccessWidth width, uint64_t &outValue) noexcept;
   Error write(uint64_t address, AccessWidth width, uint64_t value) noexcept;
 
+  // Read `size` bytes starting at address as multi-byte transfers, one
+  // round trip per 64 KiB instead of one per word
+  Error readBlock(uint64_t address, size_t size, std::vector<uint8_t> &out) noexcept;
+
   explicit operator bool() const noexcept;
 
 private:
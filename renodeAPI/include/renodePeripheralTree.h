@@ -0,0 +1,90 @@
+// renodePeripheralTree.h
+// Immutable, indexed view of a machine's peripherals as reported by the
+// monitor "peripherals" command.
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "defs.h"
+
+namespace renode {
+
+// Parsed once per platform load and shared read-only afterwards. Strings are
+// interned into one arena; nodes, children and address ranges are flat
+// arrays addressed by 32-bit indices.
+class PeripheralTree {
+public:
+  using NodeId = uint32_t;
+  static constexpr NodeId kNone = UINT32_MAX;
+
+  struct AddressRange {
+    uint64_t start;
+    uint64_t end;  // inclusive, as printed by Renode
+    NodeId node;
+  };
+
+  // Parse the output of the "peripherals" command. Understands Renode's tree
+  // drawing (├──/└── with indentation, "<0xstart, 0xend>" range lines) and
+  // the flat "bus:" / "  name (Type)" form.
+  static PeripheralTree parse(std::string_view monitorOutput);
+
+  size_t size() const noexcept { return nodes_.size(); }
+  bool empty() const noexcept { return nodes_.empty(); }
+
+  std::string_view name(NodeId node) const noexcept { return str(nodes_[node].name); }
+  std::string_view type(NodeId node) const noexcept { return str(nodes_[node].type); }
+  // Full dotted path, e.g. "sysbus.gpioPortA.led"
+  std::string_view path(NodeId node) const noexcept { return str(nodes_[node].path); }
+  NodeId parent(NodeId node) const noexcept { return nodes_[node].parent; }
+  NodeId firstChild(NodeId node) const noexcept { return nodes_[node].firstChild; }
+  NodeId nextSibling(NodeId node) const noexcept { return nodes_[node].nextSibling; }
+  // Top-level peripherals (normally just "sysbus")
+  NodeId firstRoot() const noexcept { return nodes_.empty() ? kNone : 0; }
+
+  // Ranges registered for one node
+  std::vector<AddressRange> ranges(NodeId node) const;
+
+  // O(log n) lookups
+  std::optional<NodeId> findByPath(std::string_view path) const noexcept;
+  // Peripheral whose registration covers addr (innermost when nested)
+  std::optional<NodeId> findByAddress(uint64_t addr) const noexcept;
+
+  // Flat list in tree order, for AMachine::listPeripherals. Untyped header
+  // nodes such as "sysbus" are left out. Address ranges are reported as
+  // metadata "range", "range1", ... ("0xstart-0xend").
+  std::vector<PeripheralDescriptor> toDescriptors() const;
+
+private:
+  struct Node {
+    uint32_t name;  // string ids into strings_
+    uint32_t type;
+    uint32_t path;
+    NodeId parent = kNone;
+    NodeId firstChild = kNone;
+    NodeId nextSibling = kNone;
+  };
+  struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  std::string_view str(uint32_t id) const noexcept {
+    const StringRef &ref = strings_[id];
+    return std::string_view(arena_).substr(ref.offset, ref.length);
+  }
+  uint32_t intern(std::string_view s, std::unordered_map<std::string, uint32_t> &ids);
+
+  std::string arena_;
+  std::vector<StringRef> strings_;
+  std::vector<Node> nodes_;
+  std::vector<NodeId> byPath_;          // node ids sorted by path
+  std::vector<AddressRange> byAddress_; // sorted by start
+  std::vector<uint64_t> maxEnd_;        // running max of byAddress_[0..i].end
+};
+
+} // namespace renode
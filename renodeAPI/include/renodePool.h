@@ -0,0 +1,105 @@
+// renodePool.h
+// Warm pool of pre-launched Renode instances for short-lived CI sessions.
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "renodeInterface.h"
+
+namespace renode {
+
+struct RenodePoolConfig {
+  RenodeConfig base;            // executable, flags, host, startup timeout
+  size_t size = 4;              // number of instances kept ready
+  uint16_t base_port = 5600;    // slot i: control base_port+2i, monitor base_port+2i+1
+  // Monitor commands run once after an instance comes up (e.g. mach create,
+  // LoadPlatformDescription, LoadELF)
+  std::vector<std::string> setup_commands;
+  // Monitor commands run when an instance is returned, before it is reused
+  std::vector<std::string> scrub_commands{"pause", "mach clear"};
+  // Re-run setup_commands after scrubbing
+  bool setup_after_scrub = true;
+};
+
+class RenodePool {
+public:
+  // RAII handle on one ready instance; returns it to the pool when destroyed
+  class Lease {
+  public:
+    Lease() = default;
+    Lease(Lease &&other) noexcept;
+    Lease &operator=(Lease &&other) noexcept;
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+    ~Lease();
+
+    // Connected, handshaken client with its monitor attached
+    ExternalControlClient *client() const noexcept { return client_; }
+    ExternalControlClient *operator->() const noexcept { return client_; }
+    explicit operator bool() const noexcept { return client_ != nullptr; }
+
+    uint16_t port() const noexcept;
+    uint16_t monitorPort() const noexcept;
+
+    // Give the instance back early
+    void release() noexcept;
+
+  private:
+    friend class RenodePool;
+    Lease(RenodePool *pool, size_t slot, ExternalControlClient *client) noexcept
+        : pool_(pool), slot_(slot), client_(client) {}
+    RenodePool *pool_ = nullptr;
+    size_t slot_ = 0;
+    ExternalControlClient *client_ = nullptr;
+  };
+
+  // Start the pool; instances are launched in the background
+  static std::unique_ptr<RenodePool> create(const RenodePoolConfig &config);
+
+  ~RenodePool();
+  RenodePool(const RenodePool &) = delete;
+  RenodePool &operator=(const RenodePool &) = delete;
+
+  // Wait up to `timeout` for a ready instance. Empty lease with err set on timeout.
+  Lease acquire(std::chrono::milliseconds timeout, Error &err);
+
+  size_t readyCount() const;
+  size_t capacity() const noexcept { return slots_.size(); }
+
+  // Block until every slot is ready (or timeout); true if all are ready
+  bool waitUntilFull(std::chrono::milliseconds timeout);
+
+private:
+  enum class SlotState : uint8_t { Empty, Launching, Ready, Leased, Scrubbing };
+  struct Slot {
+    SlotState state = SlotState::Empty;
+    RenodeConfig config;
+    std::unique_ptr<ExternalControlClient> client;
+    unsigned failures = 0;  // consecutive launch failures, for backoff
+    std::chrono::steady_clock::time_point retry_at{};
+  };
+
+  explicit RenodePool(const RenodePoolConfig &config);
+  void giveBack(size_t slot) noexcept;
+  void slotLoop(size_t index);
+  std::unique_ptr<ExternalControlClient> launchInstance(const RenodeConfig &config);
+  bool scrubInstance(ExternalControlClient &client);
+  bool runSetup(ExternalControlClient &client);
+
+  RenodePoolConfig config_;
+  std::vector<Slot> slots_;
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;       // wakes the slot workers
+  std::condition_variable readyCv_;  // wakes acquirers
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;  // one per slot
+};
+
+} // namespace renode
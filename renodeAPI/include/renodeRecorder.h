@@ -0,0 +1,114 @@
+// renodeRecorder.h
+// Deterministic stimulus capture and headless replay.
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "defs.h"
+
+namespace renode {
+
+class ExternalControlClient;
+
+// One recorded stimulus, stamped with the virtual time it was applied at
+struct StimulusRecord {
+  enum class Kind : uint8_t { GpioSet, AdcSet, BusWrite, MonitorCommand, End };
+  Kind kind = Kind::End;
+  uint64_t timeUs = 0;
+  std::string machine;
+  std::string path;     // peripheral path (Gpio/Adc) or SysBus path
+  std::string node;     // BusContext node path
+  std::string command;  // monitor command line
+  int index = 0;        // GPIO pin or ADC channel
+  GpioState state = GpioState::Low;
+  AdcValue adcValue = 0;
+  AccessWidth width = AccessWidth::AW_DWord;
+  uint64_t address = 0;
+  uint64_t value = 0;
+};
+
+// Append-only binary stimulus log.
+//
+// Layout: "RNSL" + version byte, then records of
+//   tag (1B) + varint time delta (us) + tag-specific fields.
+// Strings used for machine/peripheral paths are interned once through
+// DefineString records and referenced by varint id afterwards.
+class StimulusRecorder {
+public:
+  ~StimulusRecorder();
+
+  StimulusRecorder(const StimulusRecorder &) = delete;
+  StimulusRecorder &operator=(const StimulusRecorder &) = delete;
+
+  // Create (truncate) a log file. Returns nullptr with err populated on failure.
+  static std::shared_ptr<StimulusRecorder> create(const std::string &path, Error &err) noexcept;
+
+  // Track virtual time progress between stimuli (called after RUN_FOR/GET_TIME)
+  void noteTime(const std::string &machine, uint64_t timeUs) noexcept;
+
+  void recordGpio(const std::string &machine, const std::string &path, int pin,
+                  GpioState state, uint64_t timeUs) noexcept;
+  void recordAdc(const std::string &machine, const std::string &path, int channel,
+                 AdcValue value, uint64_t timeUs) noexcept;
+  void recordBusWrite(const std::string &machine, const std::string &busPath,
+                      const std::string &node, uint64_t address, AccessWidth width,
+                      uint64_t value, uint64_t timeUs) noexcept;
+  // Stamped with the last noted time of the last active machine. Only
+  // state-changing commands are kept: queries, "mach set" (tracked as the
+  // active machine instead) and snapshot/UART-tap plumbing are dropped.
+  void recordMonitorCommand(const std::string &command) noexcept;
+
+  // Flush buffered records to disk
+  Error flush() noexcept;
+  // Write the End marker at the last noted time and close the file
+  Error close() noexcept;
+
+  size_t recordCount() const noexcept;
+
+private:
+  StimulusRecorder() = default;
+
+  void beginRecord(uint8_t tag, uint64_t timeUs);
+  uint32_t intern(const std::string &s);
+  void commit();
+
+  mutable std::mutex mtx_;
+  std::FILE *file_ = nullptr;
+  std::vector<uint8_t> buf_;
+  std::map<std::string, uint32_t> strings_;
+  uint64_t lastRecordTimeUs_ = 0;
+  uint64_t lastNotedTimeUs_ = 0;
+  std::string lastMachine_;
+  size_t records_ = 0;
+};
+
+// Reads a stimulus log and drives it back through the public API, running
+// the machine in one RUN_FOR per gap between consecutive stimuli.
+class StimulusReplayer {
+public:
+  struct Stats {
+    size_t applied = 0;       // stimuli re-applied
+    size_t runCalls = 0;      // RUN_FOR commands issued
+    uint64_t virtualUs = 0;   // virtual time covered
+    uint64_t wallNs = 0;      // wall time spent
+  };
+
+  static Result<std::vector<StimulusRecord>> load(const std::string &path) noexcept;
+
+  // Replay against a connected, handshaken client. With rebaseToNow the log is
+  // shifted so its first record lands on the machine's current time; otherwise
+  // recorded times are absolute and the run must start from the same state.
+  // Monitor "start"/"pause" are not replayed: they only toggle free-running
+  // execution, which would break determinism.
+  static Result<Stats> replay(ExternalControlClient &client,
+                              const std::vector<StimulusRecord> &records,
+                              bool rebaseToNow = false) noexcept;
+};
+
+} // namespace renode
@@ -0,0 +1,93 @@
+// renodeServer.h
+// Long-lived Renode instance hosting many sequential sessions.
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "renodeInterface.h"
+
+namespace renode {
+
+struct RenodeServerConfig {
+  RenodeConfig renode;   // launch parameters, or where to attach
+  bool attach = false;   // connect to an already running Renode instead of launching
+  // Monitor commands run for every session after "mach create", e.g.
+  // "machine LoadPlatformDescription @..." and "sysbus LoadELF @..."
+  std::vector<std::string> session_setup;
+  // Relaunch the owned Renode after this many sessions (0 = never), to bound
+  // whatever state leaks past "mach rem"
+  size_t recycle_after_sessions = 0;
+};
+
+// Keeps one Renode process, connection and handshake across sessions. Each
+// session creates its machine through the monitor and removes it again on
+// end(); teardown is verified so no machine survives into the next session.
+// A failed teardown relaunches an owned process; attached servers report it.
+class RenodeServer {
+public:
+  class Session {
+  public:
+    Session() = default;
+    Session(Session &&other) noexcept;
+    Session &operator=(Session &&other) noexcept;
+    Session(const Session &) = delete;
+    Session &operator=(const Session &) = delete;
+    ~Session();
+
+    const std::shared_ptr<AMachine> &machine() const noexcept { return machine_; }
+    ExternalControlClient *client() const noexcept;
+    const std::string &name() const noexcept { return name_; }
+    explicit operator bool() const noexcept { return server_ != nullptr; }
+
+    // Pause and remove the machine; called by the destructor if needed
+    Error end() noexcept;
+
+  private:
+    friend class RenodeServer;
+    Session(RenodeServer *server, std::string name, std::shared_ptr<AMachine> machine) noexcept
+        : server_(server), name_(std::move(name)), machine_(std::move(machine)) {}
+    RenodeServer *server_ = nullptr;
+    std::string name_;
+    std::shared_ptr<AMachine> machine_;
+  };
+
+  struct Stats {
+    uint64_t sessions = 0;           // sessions started
+    uint64_t teardown_failures = 0;  // end() could not verify removal
+    uint64_t relaunches = 0;         // process restarts (recycling or failures)
+    uint64_t last_setup_ns = 0;      // wall time of the last beginSession
+    uint64_t last_teardown_ns = 0;   // wall time of the last end()
+  };
+
+  // Launch (or attach to) Renode, handshake and connect the monitor; any
+  // failure is reported as ERR_NOT_CONNECTED
+  static std::unique_ptr<RenodeServer> start(const RenodeServerConfig &config, Error &err) noexcept;
+
+  ~RenodeServer();
+  RenodeServer(const RenodeServer &) = delete;
+  RenodeServer &operator=(const RenodeServer &) = delete;
+
+  // One session at a time; the previous one must have ended
+  Session beginSession(const std::string &machineName, Error &err) noexcept;
+  Session beginSession(const std::string &machineName,
+                       const std::vector<std::string> &setupCommands, Error &err) noexcept;
+
+  ExternalControlClient *client() const noexcept { return client_.get(); }
+  const Stats &stats() const noexcept { return stats_; }
+
+private:
+  explicit RenodeServer(const RenodeServerConfig &config) : config_(config) {}
+  Error connect() noexcept;
+  Error endSession(const std::string &name) noexcept;
+
+  RenodeServerConfig config_;
+  std::unique_ptr<ExternalControlClient> client_;
+  bool sessionActive_ = false;
+  size_t sessionsSinceLaunch_ = 0;
+  Stats stats_;
+};
+
+} // namespace renode
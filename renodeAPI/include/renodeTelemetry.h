@@ -0,0 +1,132 @@
+// renodeTelemetry.h
+// Built-in instrumentation for the external-control and monitor links.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "defs.h"
+
+namespace renode {
+
+// HDR-style log-linear histogram. Values are bucketed with 7 bits of
+// sub-bucket precision (< 1% relative error) over [0, 2^44); larger values are
+// clamped. Recording is a handful of relaxed atomic operations, so the owning
+// thread never blocks and snapshot() may read concurrently.
+class HdrHistogram {
+public:
+  static constexpr unsigned kSubBucketBits = 7;
+  static constexpr unsigned kMaxValueBits = 44;
+  static constexpr size_t kHalfSubBuckets = size_t(1) << (kSubBucketBits - 1);
+  static constexpr size_t kBucketCount =
+      (kMaxValueBits - kSubBucketBits + 2) * kHalfSubBuckets;
+
+  void record(uint64_t value) noexcept;
+  void reset() noexcept;
+  // Add another histogram's counts (the other one must not be recording)
+  void mergeFrom(const HdrHistogram &other) noexcept;
+
+  // Bucket index helpers (exposed for snapshot merging)
+  static size_t indexOf(uint64_t value) noexcept;
+  static uint64_t lowestEquivalent(size_t index) noexcept;
+  static uint64_t highestEquivalent(size_t index) noexcept;
+
+private:
+  friend class Telemetry;
+  std::array<std::atomic<uint64_t>, kBucketCount> counts_{};
+  std::atomic<uint64_t> total_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> min_{UINT64_MAX};
+  std::atomic<uint64_t> max_{0};
+};
+
+// Merged, immutable view of one histogram
+struct HistogramSnapshot {
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  uint64_t min = 0;
+  uint64_t max = 0;
+  // Non-empty buckets as (highest equivalent value, count), ascending
+  std::vector<std::pair<uint64_t, uint64_t>> buckets;
+
+  double mean() const noexcept { return count ? double(sum) / double(count) : 0.0; }
+  // p in [0, 100]
+  uint64_t percentile(double p) const noexcept;
+};
+
+// Non-per-command metrics
+enum class TelemetryMetric : uint8_t {
+  RunForWallNs = 0,       // wall time of AMachine::runFor
+  GetTimeWallNs,          // wall time of AMachine::getTime
+  EventsPerTick,          // ASYNC_EVENTs dispatched during one runFor
+  RealTimeFactorPermille, // virtual time / wall time, x1000
+  CallbackNs,             // time spent inside user event callbacks
+  MonitorRttNs,           // monitor command round trip
+  Count_
+};
+
+// Commands are indexed by their ApiCommand value (ANY_COMMAND..SYSTEM_BUS)
+constexpr size_t kTelemetryCommandSlots = 7;
+
+struct TelemetrySnapshot {
+  std::array<HistogramSnapshot, kTelemetryCommandSlots> commandRttNs;
+  std::array<uint64_t, kTelemetryCommandSlots> bytesSent{};
+  std::array<uint64_t, kTelemetryCommandSlots> bytesReceived{};
+  std::array<HistogramSnapshot, size_t(TelemetryMetric::Count_)> metrics;
+
+  const HistogramSnapshot &metric(TelemetryMetric m) const noexcept {
+    return metrics[size_t(m)];
+  }
+
+  std::string toJson() const;
+  std::string toPrometheus() const;
+};
+
+// Process-wide telemetry sink. Each recording thread lazily gets its own
+// shard, so hot paths never contend; snapshot() merges all shards. A thread's
+// shard is folded into a retired total when the thread exits and reused by
+// the next new thread, so short-lived threads do not grow the registry.
+class Telemetry {
+public:
+  static Telemetry &instance();
+
+  void setEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+  bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  void recordCommand(ApiCommand command, uint64_t rttNs, size_t bytesSent,
+                     size_t bytesReceived) noexcept;
+  void record(TelemetryMetric metric, uint64_t value) noexcept;
+
+  TelemetrySnapshot snapshot() const;
+  void reset() noexcept;
+
+  static const char *commandName(ApiCommand command) noexcept;
+  static const char *metricName(TelemetryMetric metric) noexcept;
+
+  // Monotonic nanosecond clock used by all instrumentation points
+  static uint64_t nowNs() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  Telemetry(const Telemetry &) = delete;
+  Telemetry &operator=(const Telemetry &) = delete;
+
+private:
+  struct Shard;
+  Telemetry();
+  ~Telemetry();
+  Shard &localShard();
+  void retireShard(Shard *shard) noexcept;
+
+  std::atomic<bool> enabled_{true};
+  struct Registry;
+  Registry *registry_;
+};
+
+} // namespace renode
@@ -0,0 +1,454 @@
+// renodeBroker.cpp
+#include "renodeBroker.h"
+#include "renodeInternal.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace renode {
+
+namespace {
+
+constexpr size_t kHeaderBytes = 7;                 // 'R','E', command, u32 size
+constexpr uint32_t kMaxPayloadBytes = 64u << 20;   // larger frames mean a broken client
+constexpr uint8_t kGpioRegisterEvent = 2;
+constexpr size_t kGpioRegisterBytes = 13;          // id(4) + sub(1) + pin(4) + ed(4)
+
+// Reply frame laid out exactly as Renode would send it
+std::vector<uint8_t> encodeReply(uint8_t code, uint8_t command, const std::vector<uint8_t> &data) {
+  std::vector<uint8_t> frame;
+  frame.reserve(10 + data.size());
+  frame.push_back(code);
+  switch (code) {
+  case COMMAND_FAILED:
+  case SUCCESS_WITH_DATA:
+    frame.push_back(command);
+    [[fallthrough]];
+  case FATAL_ERROR:
+    write_u32_le(frame, static_cast<uint32_t>(data.size()));
+    frame.insert(frame.end(), data.begin(), data.end());
+    break;
+  default:  // INVALID_COMMAND, SUCCESS_WITHOUT_DATA
+    frame.push_back(command);
+  }
+  return frame;
+}
+
+bool isSuccess(const std::vector<uint8_t> &frame) {
+  return !frame.empty() && (frame[0] == SUCCESS_WITH_DATA || frame[0] == SUCCESS_WITHOUT_DATA);
+}
+
+} // namespace
+
+struct RenodeBroker::Impl {
+  struct Client {
+    int fd = -1;
+    bool handshaken = false;
+    bool closing = false;
+    std::vector<uint8_t> in;
+    std::vector<uint8_t> out;
+    size_t outPos = 0;
+
+    size_t pending() const noexcept { return out.size() - outPos; }
+  };
+
+  struct Request {
+    uint64_t client;
+    uint8_t command;
+    std::vector<uint8_t> payload;
+  };
+
+  // One upstream GPIO event registration shared by every client watching
+  // the same pin; each subscriber keeps its own event descriptor
+  struct Subscription {
+    uint32_t upstreamEd = 0;
+    std::vector<uint8_t> reply;  // upstream's answer, replayed to late subscribers
+    std::vector<std::pair<uint64_t, uint32_t>> subscribers;  // client id, client ed
+  };
+  using PinKey = std::pair<int32_t, int32_t>;  // instance id, pin
+
+  BrokerConfig config;
+  std::unique_ptr<ExternalControlClient> upstream;
+  ExternalControlClient::Impl *up = nullptr;
+  bool upstreamOk = true;
+
+  int listenFd = -1;
+  int wakeFds[2] = {-1, -1};
+  std::atomic<bool> stopping{false};
+  std::thread thread;
+
+  // Broker-thread state
+  std::map<uint64_t, Client> clients;
+  uint64_t nextClientId = 1;
+  std::vector<Request> pending;
+  std::map<PinKey, Subscription> subscriptions;
+
+  mutable std::mutex statsMtx;
+  Stats stats;
+
+  ~Impl() {
+    if (thread.joinable()) {
+      stopping = true;
+      uint8_t b = 0;
+      (void)!write(wakeFds[1], &b, 1);
+      thread.join();
+    }
+    for (auto &kv : clients) close(kv.second.fd);
+    for (auto &kv : subscriptions) {
+      EventCallbackRegistry::instance().unregisterCallback(kv.second.upstreamEd);
+    }
+    if (listenFd >= 0) {
+      close(listenFd);
+      unlink(config.socket_path.c_str());
+    }
+    for (int fd : wakeFds) {
+      if (fd >= 0) close(fd);
+    }
+  }
+
+  void count(uint64_t Stats::*field, uint64_t n = 1) {
+    std::lock_guard<std::mutex> lk(statsMtx);
+    stats.*field += n;
+  }
+
+  Error listen() noexcept {
+    struct sockaddr_un addr{};
+    const std::string &path = config.socket_path;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+      return {1, "RenodeBroker: invalid socket path '" + path + "'"};
+    }
+    // Replace a socket left behind by a previous broker, never a regular file
+    struct stat st{};
+    if (lstat(path.c_str(), &st) == 0) {
+      if (!S_ISSOCK(st.st_mode)) {
+        return {2, "RenodeBroker: " + path + " exists and is not a socket"};
+      }
+      unlink(path.c_str());
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0 ||
+        bind(listenFd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd, 64) != 0) {
+      std::string reason = strerror(errno);
+      if (listenFd >= 0) close(listenFd);
+      listenFd = -1;
+      return {3, "RenodeBroker: cannot listen on " + path + ": " + reason};
+    }
+    if (pipe2(wakeFds, O_CLOEXEC) != 0) {
+      return {4, std::string("RenodeBroker: pipe2: ") + strerror(errno)};
+    }
+    return {0, ""};
+  }
+
+  void run() {
+    std::vector<struct pollfd> fds;
+    std::vector<uint64_t> ids;
+    while (!stopping) {
+      fds.clear();
+      ids.clear();
+      fds.push_back({wakeFds[0], POLLIN, 0});
+      fds.push_back({listenFd, POLLIN, 0});
+      fds.push_back({upstreamOk ? up->sock_fd : -1, POLLIN, 0});
+      for (const auto &[id, c] : clients) {
+        short events = POLLIN;
+        if (c.pending()) events |= POLLOUT;
+        fds.push_back({c.fd, events, 0});
+        ids.push_back(id);
+      }
+
+      if (poll(fds.data(), fds.size(), -1) < 0) {
+        if (errno == EINTR) continue;
+        std::cerr << "RenodeBroker: poll: " << strerror(errno) << "\n";
+        break;
+      }
+      if (fds[0].revents) break;  // stop requested
+      if (fds[1].revents & POLLIN) acceptClients();
+      if (fds[2].revents) drainUpstream();
+      for (size_t i = 0; i < ids.size(); ++i) {
+        auto it = clients.find(ids[i]);
+        short revents = fds[i + 3].revents;
+        if (revents & (POLLIN | POLLHUP | POLLERR)) readClient(ids[i], it->second);
+        if (revents & POLLOUT) flush(it->second);
+      }
+
+      // Everything read this round is one batch: requests that piled up
+      // behind a long RUN_FOR are coalesced here
+      if (!pending.empty()) execute();
+
+      for (auto it = clients.begin(); it != clients.end();) {
+        it = it->second.closing ? drop(it) : std::next(it);
+      }
+    }
+  }
+
+  void acceptClients() {
+    while (true) {
+      int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0) return;
+      clients[nextClientId++].fd = fd;
+      std::lock_guard<std::mutex> lk(statsMtx);
+      ++stats.accepted;
+      stats.clients = clients.size();
+    }
+  }
+
+  std::map<uint64_t, Client>::iterator drop(std::map<uint64_t, Client>::iterator it) {
+    // Upstream registrations stay: Renode has no way to cancel them, and a
+    // later client watching the same pin reuses them
+    for (auto &kv : subscriptions) {
+      auto &subs = kv.second.subscribers;
+      for (size_t i = subs.size(); i-- > 0;) {
+        if (subs[i].first == it->first) subs.erase(subs.begin() + i);
+      }
+    }
+    close(it->second.fd);
+    it = clients.erase(it);
+    std::lock_guard<std::mutex> lk(statsMtx);
+    stats.clients = clients.size();
+    return it;
+  }
+
+  void readClient(uint64_t id, Client &c) {
+    uint8_t buf[64 * 1024];
+    while (true) {
+      ssize_t r = recv(c.fd, buf, sizeof(buf), MSG_DONTWAIT);
+      if (r > 0) {
+        c.in.insert(c.in.end(), buf, buf + r);
+        continue;
+      }
+      if (r < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+      if (r < 0 && errno == EINTR) continue;
+      c.closing = true;  // EOF or error
+      return;
+    }
+    parse(id, c);
+  }
+
+  void parse(uint64_t id, Client &c) {
+    size_t pos = 0;
+    if (!c.handshaken) {
+      // u16 count + (command, version) pairs; the upstream connection has
+      // already negotiated with Renode, so any client list is accepted
+      if (c.in.size() < 2) return;
+      size_t need = 2 + 2 * (size_t(c.in[0]) | size_t(c.in[1]) << 8);
+      if (c.in.size() < need) return;
+      pos = need;
+      c.handshaken = true;
+      queue(c, {OK_HANDSHAKE}, false);
+    }
+    while (c.in.size() - pos >= kHeaderBytes) {
+      const uint8_t *h = c.in.data() + pos;
+      uint32_t size = read_u32_le(h + 3);
+      if (h[0] != 'R' || h[1] != 'E' || size > kMaxPayloadBytes) {
+        std::cerr << "RenodeBroker: malformed frame from client " << id << "\n";
+        c.closing = true;
+        return;
+      }
+      if (c.in.size() - pos < kHeaderBytes + size) break;
+      pending.push_back({id, h[2], {h + kHeaderBytes, h + kHeaderBytes + size}});
+      pos += kHeaderBytes + size;
+      count(&Stats::requests);
+    }
+    c.in.erase(c.in.begin(), c.in.begin() + pos);
+  }
+
+  // False if the frame was dropped
+  bool queue(Client &c, const std::vector<uint8_t> &frame, bool droppable) {
+    if (c.closing) return false;
+    if (droppable && c.pending() + frame.size() > config.max_client_buffer) return false;
+    c.out.insert(c.out.end(), frame.begin(), frame.end());
+    flush(c);
+    return true;
+  }
+
+  void flush(Client &c) {
+    while (c.pending()) {
+      ssize_t w = send(c.fd, c.out.data() + c.outPos, c.pending(), MSG_NOSIGNAL | MSG_DONTWAIT);
+      if (w > 0) {
+        c.outPos += static_cast<size_t>(w);
+      } else if (w < 0 && errno == EINTR) {
+        continue;
+      } else {
+        if (w < 0 && errno != EAGAIN && errno != EWOULDBLOCK) c.closing = true;
+        break;
+      }
+    }
+    if (c.outPos == c.out.size()) {
+      c.out.clear();
+      c.outPos = 0;
+    } else if (c.outPos > (1u << 20)) {
+      c.out.erase(c.out.begin(), c.out.begin() + c.outPos);
+      c.outPos = 0;
+    }
+  }
+
+  void execute() {
+    std::vector<Request> batch;
+    batch.swap(pending);
+
+    // Replies to read-only commands, reusable until a command runs that may
+    // change emulation state
+    std::map<std::pair<uint8_t, std::vector<uint8_t>>, std::vector<uint8_t>> shared;
+    for (const Request &req : batch) {
+      if (clients.find(req.client) == clients.end()) continue;  // hung up
+      bool readOnly = req.command == GET_TIME || req.command == GET_MACHINE;
+      std::pair<uint8_t, std::vector<uint8_t>> key{req.command, req.payload};
+      std::vector<uint8_t> reply;
+      if (readOnly) {
+        auto it = shared.find(key);
+        if (it != shared.end()) {
+          count(&Stats::coalesced);
+          reply = it->second;
+        }
+      } else {
+        shared.clear();
+      }
+      if (reply.empty()) {
+        reply = isGpioRegistration(req) ? subscribe(req) : roundTrip(req.command, req.payload);
+        if (readOnly) shared.emplace(std::move(key), reply);
+      }
+      // Events fanned out during the round trip may have closed clients
+      auto it = clients.find(req.client);
+      if (it != clients.end()) queue(it->second, reply, false);
+    }
+  }
+
+  std::vector<uint8_t> roundTrip(uint8_t command, const std::vector<uint8_t> &payload) {
+    count(&Stats::upstream_commands);
+    try {
+      uint8_t code = SUCCESS_WITHOUT_DATA;
+      auto data = up->send_command(static_cast<ApiCommand>(command), payload, &code);
+      return encodeReply(code, command, data);
+    } catch (const std::exception &ex) {
+      std::string msg = std::string("RenodeBroker: ") + ex.what();
+      return encodeReply(FATAL_ERROR, command, {msg.begin(), msg.end()});
+    }
+  }
+
+  static bool isGpioRegistration(const Request &req) {
+    return req.command == GPIO && req.payload.size() == kGpioRegisterBytes &&
+           req.payload[4] == kGpioRegisterEvent;
+  }
+
+  std::vector<uint8_t> subscribe(const Request &req) {
+    const uint8_t *p = req.payload.data();
+    PinKey key{static_cast<int32_t>(read_u32_le(p)), static_cast<int32_t>(read_u32_le(p + 5))};
+    uint32_t clientEd = read_u32_le(p + 9);
+
+    auto it = subscriptions.find(key);
+    if (it == subscriptions.end()) {
+      Subscription sub;
+      sub.upstreamEd = EventCallbackRegistry::instance().registerCallback(
+          [this, key](const uint8_t *data, size_t size) { fanOut(key, data, size); });
+      std::vector<uint8_t> payload(p, p + 9);
+      write_u32_le(payload, sub.upstreamEd);
+      sub.reply = roundTrip(req.command, payload);
+      if (!isSuccess(sub.reply)) {
+        EventCallbackRegistry::instance().unregisterCallback(sub.upstreamEd);
+        return sub.reply;
+      }
+      it = subscriptions.emplace(key, std::move(sub)).first;
+    } else {
+      count(&Stats::coalesced);
+    }
+    it->second.subscribers.emplace_back(req.client, clientEd);
+    return it->second.reply;
+  }
+
+  // Runs inside EventCallbackRegistry::invokeCallback on the broker thread
+  void fanOut(const PinKey &key, const uint8_t *data, size_t size) {
+    count(&Stats::events_in);
+    auto it = subscriptions.find(key);
+    if (it == subscriptions.end()) return;
+    std::vector<uint8_t> frame;
+    frame.reserve(10 + size);
+    for (const auto &[clientId, ed] : it->second.subscribers) {
+      auto c = clients.find(clientId);
+      if (c == clients.end()) continue;
+      frame.clear();
+      frame.push_back(ASYNC_EVENT);
+      frame.push_back(GPIO);
+      write_u32_le(frame, ed);
+      write_u32_le(frame, static_cast<uint32_t>(size));
+      frame.insert(frame.end(), data, data + size);
+      count(queue(c->second, frame, true) ? &Stats::events_out : &Stats::events_dropped);
+    }
+  }
+
+  // Events Renode sends while no command is in flight
+  void drainUpstream() {
+    uint8_t peek = 0;
+    try {
+      do {
+        uint8_t code = 0;
+        if (!read_byte(up->sock_fd, code)) throw std::runtime_error("connection closed");
+        if (code != ASYNC_EVENT) {
+          throw std::runtime_error("unsolicited reply code " + std::to_string(code));
+        }
+        up->recv_event();
+      } while (recv(up->sock_fd, &peek, 1, MSG_PEEK | MSG_DONTWAIT) > 0);
+    } catch (const std::exception &ex) {
+      // Stop watching; commands will report the failure to their clients
+      std::cerr << "RenodeBroker: upstream: " << ex.what() << "\n";
+      upstreamOk = false;
+    }
+  }
+};
+
+RenodeBroker::RenodeBroker(std::unique_ptr<Impl> impl) noexcept : pimpl_(std::move(impl)) {}
+
+RenodeBroker::~RenodeBroker() = default;
+
+std::unique_ptr<RenodeBroker> RenodeBroker::start(std::unique_ptr<ExternalControlClient> upstream,
+                                                  const BrokerConfig &config,
+                                                  Error &err) noexcept {
+  if (!upstream || !upstream->pimpl_ || !upstream->pimpl_->connected) {
+    err = {ERR_NOT_CONNECTED, "RenodeBroker: upstream client not connected"};
+    return nullptr;
+  }
+  auto impl = std::make_unique<Impl>();
+  impl->config = config;
+  impl->up = upstream->pimpl_.get();
+  impl->upstream = std::move(upstream);
+  if ((err = impl->listen())) return nullptr;
+  try {
+    impl->thread = std::thread([p = impl.get()] { p->run(); });
+  } catch (const std::exception &ex) {
+    err = {5, std::string("RenodeBroker: ") + ex.what()};
+    return nullptr;
+  }
+  err = {0, ""};
+  return std::unique_ptr<RenodeBroker>(new RenodeBroker(std::move(impl)));
+}
+
+const std::string &RenodeBroker::socketPath() const noexcept {
+  return pimpl_->config.socket_path;
+}
+
+Monitor *RenodeBroker::monitor() noexcept {
+  return pimpl_->upstream->getMonitor();
+}
+
+RenodeBroker::Stats RenodeBroker::stats() const {
+  std::lock_guard<std::mutex> lk(pimpl_->statsMtx);
+  return pimpl_->stats;
+}
+
+} // namespace renode
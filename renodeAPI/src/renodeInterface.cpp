@@ -2,6 +2,8 @@
 #include "renodeInterface.h"
 #include "renodeMachine.h"
 #include "renodeInternal.h"
+#include "renodeLog.h"
+#include "renodeTelemetry.h"
 #include "defs.h"
 
 #include <arpa/inet.h>
@@ -10,14 +12,19 @@
 #include <memory>
 #include <netdb.h>
 #include <string>
+#include <string_view>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <signal.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstring>
 #include <iostream>
@@ -26,6 +33,10 @@
 #include <thread>
 #include <vector>
 #include <map>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 
 namespace renode {
 
@@ -37,22 +48,108 @@ RenodeProcess::RenodeProcess(pid_t pid, uint16_t port) noexcept
     : pid_(pid), port_(port) {}
 
 RenodeProcess::RenodeProcess(RenodeProcess &&other) noexcept
-    : pid_(other.pid_), port_(other.port_) {
+    : pid_(other.pid_), port_(other.port_), outputFd_(other.outputFd_),
+      controlFd_(other.controlFd_), monitor_(std::move(other.monitor_)),
+      log_(std::move(other.log_)),
+      readerStop_(std::move(other.readerStop_)),
+      readerThread_(std::move(other.readerThread_)), timings_(other.timings_) {
   other.pid_ = -1;
+  other.outputFd_ = -1;
+  other.controlFd_ = -1;
 }
 
 RenodeProcess &RenodeProcess::operator=(RenodeProcess &&other) noexcept {
   if (this != &other) {
     terminate();
+    stopOutputReader();
+    if (controlFd_ >= 0) close(controlFd_);
     pid_ = other.pid_;
     port_ = other.port_;
+    outputFd_ = other.outputFd_;
+    controlFd_ = other.controlFd_;
+    monitor_ = std::move(other.monitor_);
+    log_ = std::move(other.log_);
+    readerStop_ = std::move(other.readerStop_);
+    readerThread_ = std::move(other.readerThread_);
+    timings_ = other.timings_;
     other.pid_ = -1;
+    other.outputFd_ = -1;
+    other.controlFd_ = -1;
   }
   return *this;
 }
 
 RenodeProcess::~RenodeProcess() {
+  if (controlFd_ >= 0) close(controlFd_);
+  monitor_.reset();
   terminate();
+  stopOutputReader();
+}
+
+int RenodeProcess::takeControlSocket() noexcept {
+  int fd = controlFd_;
+  controlFd_ = -1;
+  return fd;
+}
+
+std::unique_ptr<Monitor> RenodeProcess::takeMonitor() noexcept {
+  return std::move(monitor_);
+}
+
+// Keep the child's output pipe flowing so Renode never blocks on a full
+// pipe, feeding complete lines into the log ring when capture is enabled
+void RenodeProcess::startOutputReader(std::string pending) noexcept {
+  if (outputFd_ < 0) return;
+  readerStop_ = std::make_shared<std::atomic<bool>>(false);
+  try {
+    readerThread_ = std::thread([fd = outputFd_, stop = readerStop_, log = log_,
+                                 partial = std::move(pending)]() mutable {
+      char buf[4096];
+      while (!stop->load(std::memory_order_relaxed)) {
+        struct pollfd pfd{fd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) continue;
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) break;
+        if (n < 0 || !log) continue;
+
+        std::string_view chunk(buf, static_cast<size_t>(n));
+        size_t pos;
+        while ((pos = chunk.find('\n')) != std::string_view::npos) {
+          std::string_view line = chunk.substr(0, pos);
+          chunk.remove_prefix(pos + 1);
+          if (!partial.empty()) {
+            partial.append(line);
+            line = partial;
+          }
+          if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+          log->push(line);
+          partial.clear();
+        }
+        // Bound the carry-over: a runaway line is pushed in pieces
+        partial.append(chunk);
+        if (partial.size() >= LogStream::kMaxLineBytes * 4) {
+          log->push(partial);
+          partial.clear();
+        }
+      }
+      if (log && !partial.empty()) log->push(partial);
+    });
+  } catch (const std::system_error &) {
+    // Without a reader thread the pipe is closed; Renode then gets EPIPE on
+    // output, which it tolerates
+    close(outputFd_);
+    outputFd_ = -1;
+  }
+}
+
+void RenodeProcess::stopOutputReader() noexcept {
+  if (readerStop_) readerStop_->store(true, std::memory_order_relaxed);
+  if (readerThread_.joinable()) readerThread_.join();
+  readerStop_.reset();
+  if (outputFd_ >= 0) {
+    close(outputFd_);
+    outputFd_ = -1;
+  }
 }
 
 bool RenodeProcess::isRunning() const noexcept {
@@ -83,7 +180,115 @@ void RenodeProcess::terminate() noexcept {
   pid_ = -1;
 }
 
+namespace {
+
+// Non-blocking connect whose completion is picked up by poll(POLLOUT)
+struct ConnectProbe {
+  uint16_t port = 0;
+  int fd = -1;
+  bool ready = false;
+  bool wanted = false;
+  std::chrono::steady_clock::time_point nextAttempt{};
+  std::chrono::milliseconds backoff{5};
+  // Addresses the host resolved to; a failed attempt moves on to the next
+  std::vector<std::pair<struct sockaddr_storage, socklen_t>> addrs;
+  size_t nextAddr = 0;
+
+  bool resolve(const std::string &host) {
+    struct addrinfo hints{};
+    struct addrinfo *res = nullptr;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_family = AF_UNSPEC;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0) return false;
+    for (struct addrinfo *ai = res; ai != nullptr; ai = ai->ai_next) {
+      struct sockaddr_storage addr{};
+      std::memcpy(&addr, ai->ai_addr, ai->ai_addrlen);
+      addrs.emplace_back(addr, ai->ai_addrlen);
+    }
+    freeaddrinfo(res);
+    return !addrs.empty();
+  }
+
+  void start() {
+    const auto &[addr, len] = addrs[nextAddr];
+    fd = socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+      fail();
+      return;
+    }
+    if (::connect(fd, reinterpret_cast<const struct sockaddr*>(&addr), len) == 0) {
+      ready = true;
+    } else if (errno != EINPROGRESS) {
+      fail();
+    }
+  }
+
+  // Called once poll reports the socket writable or in error
+  void finish() {
+    int soerr = 0;
+    socklen_t len = sizeof(soerr);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &soerr, &len) == 0 && soerr == 0) {
+      ready = true;
+    } else {
+      fail();
+    }
+  }
+
+  void fail() {
+    if (fd >= 0) close(fd);
+    fd = -1;
+    nextAttempt = std::chrono::steady_clock::now() + backoff;
+    backoff = std::min(backoff * 2, std::chrono::milliseconds(200));
+    nextAddr = (nextAddr + 1) % addrs.size();
+  }
+
+  // A readiness marker was printed: try again right away
+  void kick() {
+    if (!ready && fd < 0) {
+      nextAttempt = {};
+      backoff = std::chrono::milliseconds(5);
+    }
+  }
+
+  int release() {
+    int out = fd;
+    fd = -1;
+    return out;
+  }
+
+  ~ConnectProbe() {
+    if (fd >= 0) close(fd);
+  }
+};
+
+bool containsIgnoreCase(const std::string &line, const char *needle) {
+  auto it = std::search(line.begin(), line.end(), needle, needle + strlen(needle),
+                        [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) ==
+                                                    std::tolower(static_cast<unsigned char>(b)); });
+  return it != line.end();
+}
+
+} // namespace
+
 std::unique_ptr<RenodeProcess> RenodeProcess::launch(const RenodeConfig &config) {
+  return launch(config, nullptr);
+}
+
+std::unique_ptr<RenodeProcess> RenodeProcess::launch(const RenodeConfig &config,
+                                                     std::shared_ptr<LogStream> log) {
+  using Clock = std::chrono::steady_clock;
+  const auto start = Clock::now();
+  auto sinceStart = [&start]() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - start).count());
+  };
+
+  // The server is started through the monitor, so there must be one
+  if (config.start_control_server && config.monitor_port == 0) {
+    std::cerr << "RenodeProcess: start_control_server needs a monitor_port\n";
+    return nullptr;
+  }
+
   // Build command arguments
   std::vector<std::string> args_storage;
   args_storage.push_back(config.renode_path);
@@ -109,21 +314,25 @@ std::unique_ptr<RenodeProcess> RenodeProcess::launch(const RenodeConfig &config)
   }
   argv.push_back(nullptr);
 
+  // Renode's stdout/stderr are read back to detect readiness
+  int out_pipe[2];
+  if (pipe2(out_pipe, O_CLOEXEC) != 0) {
+    std::cerr << "RenodeProcess: pipe() failed: " << strerror(errno) << "\n";
+    return nullptr;
+  }
+
   pid_t pid = fork();
   if (pid < 0) {
     std::cerr << "RenodeProcess: fork() failed: " << strerror(errno) << "\n";
+    close(out_pipe[0]);
+    close(out_pipe[1]);
     return nullptr;
   }
 
   if (pid == 0) {
-    // Child process
-    // Redirect stdout/stderr to /dev/null or keep for debugging
-    int devnull = open("/dev/null", O_WRONLY);
-    if (devnull >= 0) {
-      dup2(devnull, STDOUT_FILENO);
-      dup2(devnull, STDERR_FILENO);
-      close(devnull);
-    }
+    // Child process: dup2 clears O_CLOEXEC on the new descriptors
+    dup2(out_pipe[1], STDOUT_FILENO);
+    dup2(out_pipe[1], STDERR_FILENO);
 
     execvp(argv[0], argv.data());
     // If execvp returns, it failed
@@ -132,16 +341,82 @@ std::unique_ptr<RenodeProcess> RenodeProcess::launch(const RenodeConfig &config)
   }
 
   // Parent process - wait for Renode to start listening
+  close(out_pipe[1]);
+  fcntl(out_pipe[0], F_SETFL, fcntl(out_pipe[0], F_GETFL) | O_NONBLOCK);
   auto process = std::unique_ptr<RenodeProcess>(new RenodeProcess(pid, config.port));
+  process->outputFd_ = out_pipe[0];
+  RenodeStartupTimings &timings = process->timings_;
+  timings.spawnNs = sinceStart();
+
+  ConnectProbe monitor_probe;
+  monitor_probe.port = config.monitor_port;
+  monitor_probe.wanted = config.monitor_port > 0;
+  ConnectProbe control_probe;
+  control_probe.port = config.port;
+  // A script-created server can come up any time; ours only after the command
+  control_probe.wanted = !config.start_control_server;
+  if (!control_probe.resolve(config.host) ||
+      (monitor_probe.wanted && !monitor_probe.resolve(config.host))) {
+    std::cerr << "RenodeProcess: cannot resolve " << config.host << "\n";
+    process->terminate();
+    return nullptr;
+  }
 
-  // Poll until we can connect or timeout
-  auto start = std::chrono::steady_clock::now();
-  while (true) {
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now() - start);
+  const std::string monitor_port_str = std::to_string(config.monitor_port);
+  const std::string control_port_str = std::to_string(config.port);
+  std::string line_buf;
+  std::vector<std::string> tail;  // last output lines, reported on failure
+  auto reportTail = [&tail]() {
+    for (const auto &l : tail) std::cerr << "  renode: " << l << "\n";
+  };
 
-    if (elapsed.count() >= config.startup_timeout_ms) {
+  // Markers only shortcut the connect backoff; a probe still confirms readiness
+  if (log) {
+    process->log_ = std::move(log);
+  } else if (config.log_capacity > 0) {
+    process->log_ = std::make_shared<LogStream>(config.log_capacity);
+  }
+  auto onLine = [&](const std::string &line) {
+    if (process->log_) process->log_->push(line);
+    if (timings.firstOutputNs == 0) timings.firstOutputNs = sinceStart();
+    if (tail.size() == 8) tail.erase(tail.begin());
+    tail.push_back(line);
+    if (containsIgnoreCase(line, "monitor available") ||
+        (containsIgnoreCase(line, "telnet") && line.find(monitor_port_str) != std::string::npos)) {
+      monitor_probe.kick();
+    }
+    if (containsIgnoreCase(line, "external control") ||
+        (containsIgnoreCase(line, "listening") && line.find(control_port_str) != std::string::npos)) {
+      control_probe.kick();
+    }
+  };
+
+  auto markReady = [&](ConnectProbe &probe) {
+    if (&probe == &monitor_probe) {
+      // The probe connection becomes the monitor handed out by takeMonitor()
+      int fd = probe.release();
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+      try {
+        process->monitor_ = Monitor::adopt(fd, config.host, config.monitor_port);
+      } catch (const std::exception &) {
+        // Accepted but closed before the prompt: not ready after all
+        probe.ready = false;
+        probe.fail();
+        return;
+      }
+      timings.monitorReadyNs = sinceStart();
+    } else {
+      timings.controlReadyNs = sinceStart();
+    }
+  };
+
+  const auto deadline = start + std::chrono::milliseconds(config.startup_timeout_ms);
+  bool output_open = true;
+  while (true) {
+    auto now = Clock::now();
+    if (now >= deadline) {
       std::cerr << "RenodeProcess: timeout waiting for Renode to start\n";
+      reportTail();
       process->terminate();
       return nullptr;
     }
@@ -149,41 +424,94 @@ std::unique_ptr<RenodeProcess> RenodeProcess::launch(const RenodeConfig &config)
     // Check if process died
     if (!process->isRunning()) {
       std::cerr << "RenodeProcess: Renode process exited unexpectedly\n";
+      reportTail();
       return nullptr;
     }
 
-    // Try to connect to the external control port
-    int test_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (test_fd >= 0) {
-      struct sockaddr_in addr{};
-      addr.sin_family = AF_INET;
-      addr.sin_port = htons(config.port);
-      inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr);
-
-      if (::connect(test_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0) {
-        close(test_fd);
-
-        // Also check monitor port if configured
-        bool monitor_ready = true;
-        if (config.monitor_port > 0) {
-          int mon_fd = socket(AF_INET, SOCK_STREAM, 0);
-          if (mon_fd >= 0) {
-            addr.sin_port = htons(config.monitor_port);
-            monitor_ready = (::connect(mon_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) == 0);
-            close(mon_fd);
-          }
-        }
+    // No script-created server: create it on our port once the monitor is up
+    if (config.start_control_server && monitor_probe.ready && !control_probe.wanted) {
+      std::string cmd = SERVER_START_COMMAND;
+      cmd.replace(cmd.find("NAME"), 4, "api-server-" + std::to_string(config.port));
+      cmd.replace(cmd.find("PORT"), 4, std::to_string(config.port));
+      auto started = process->monitor_->execute(cmd);
+      if (started.error || monitorReportedError(started.value)) {
+        std::cerr << "RenodeProcess: cannot start control server: "
+                  << (started.error ? started.error.message : started.value) << "\n";
+        process->terminate();
+        return nullptr;
+      }
+      timings.serverStartNs = sinceStart();
+      control_probe.wanted = true;
+    }
 
-        if (monitor_ready) {
-          std::cout << "RenodeProcess: Renode started successfully (pid=" << pid << ")\n";
-          return process;
-        }
+    if (control_probe.ready && (!monitor_probe.wanted || monitor_probe.ready)) {
+      process->controlFd_ = control_probe.release();
+      timings.totalNs = sinceStart();
+      process->startOutputReader(std::move(line_buf));
+      std::cerr << "RenodeProcess: Renode started successfully (pid=" << pid
+                << ", " << timings.totalNs / 1000000 << " ms)\n";
+      return process;
+    }
+
+    // Start due probes and gather what to wait on
+    auto wake = deadline;
+    bool progressed = false;
+    std::vector<struct pollfd> pfds;
+    std::vector<ConnectProbe*> polled;
+    if (output_open) pfds.push_back({process->outputFd_, POLLIN, 0});
+    for (ConnectProbe *probe : {&monitor_probe, &control_probe}) {
+      if (!probe->wanted || probe->ready) continue;
+      if (probe->fd < 0 && probe->nextAttempt <= now) probe->start();
+      if (probe->ready) {
+        markReady(*probe);
+        progressed = true;
+      } else if (probe->fd >= 0) {
+        pfds.push_back({probe->fd, POLLOUT, 0});
+        polled.push_back(probe);
       } else {
-        close(test_fd);
+        wake = std::min(wake, probe->nextAttempt);
       }
     }
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (progressed) continue;
+
+    int wait_ms = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        wake - Clock::now()).count()) + 1;
+    // Bounded so a silent exit is still noticed through waitpid
+    int rc = poll(pfds.data(), pfds.size(), std::clamp(wait_ms, 0, 250));
+    if (rc < 0 && errno != EINTR) {
+      std::cerr << "RenodeProcess: poll failed: " << strerror(errno) << "\n";
+      process->terminate();
+      return nullptr;
+    }
+    if (rc <= 0) continue;
+
+    size_t idx = 0;
+    if (output_open) {
+      if (pfds[idx].revents & (POLLIN | POLLHUP | POLLERR)) {
+        char buf[4096];
+        ssize_t n;
+        while ((n = read(process->outputFd_, buf, sizeof(buf))) > 0) {
+          line_buf.append(buf, static_cast<size_t>(n));
+          size_t pos;
+          while ((pos = line_buf.find('\n')) != std::string::npos) {
+            std::string line = line_buf.substr(0, pos);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            line_buf.erase(0, pos + 1);
+            onLine(line);
+          }
+        }
+        // EOF: the child closed its output, which usually means it is exiting
+        if (n == 0) output_open = false;
+      }
+      ++idx;
+    }
+    for (ConnectProbe *probe : polled) {
+      if (pfds[idx].revents & (POLLOUT | POLLERR | POLLHUP)) {
+        probe->finish();
+        if (probe->ready) markReady(*probe);
+      }
+      ++idx;
+    }
   }
 }
 
@@ -191,45 +519,59 @@ std::unique_ptr<RenodeProcess> RenodeProcess::launch(const RenodeConfig &config)
 // ExternalControlClient Implementation
 // ============================================================================
 
-std::unique_ptr<ExternalControlClient>
-ExternalControlClient::launchAndConnect(const RenodeConfig &config) {
-  // Launch Renode process
-  auto process = RenodeProcess::launch(config);
-  if (!process) {
-    throw RenodeException("Failed to launch Renode process");
+namespace {
+
+// Blocking control connection to a freshly launched Renode: the socket that
+// probed readiness if there is one, otherwise a new connection. -1 on failure.
+int openControlSocket(RenodeProcess &process, const std::string &host, uint16_t port) {
+  int fd = process.takeControlSocket();
+  if (fd >= 0) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    return fd;
   }
 
-  // Connect to it
-  auto impl = std::make_unique<Impl>(config.host, config.port);
   struct addrinfo hints{};
   struct addrinfo *res = nullptr;
-
   hints.ai_socktype = SOCK_STREAM;
   hints.ai_family = AF_UNSPEC;
-
-  int rc = getaddrinfo(config.host.c_str(), std::to_string(config.port).c_str(), &hints, &res);
+  int rc = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res);
   if (rc != 0 || !res) {
-    throw RenodeException(std::string("getaddrinfo: ") + gai_strerror(rc));
+    std::cerr << "getaddrinfo: " << gai_strerror(rc) << "\n";
+    return -1;
   }
-
   for (struct addrinfo *ai = res; ai != nullptr; ai = ai->ai_next) {
-    impl->sock_fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
-    if (impl->sock_fd < 0)
-      continue;
-    if (::connect(impl->sock_fd, ai->ai_addr, ai->ai_addrlen) == 0) {
-      impl->connected = true;
-      freeaddrinfo(res);
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) continue;
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  return fd;
+}
 
-      // Return client without monitor - connectMonitor() should be called after handshake
-      return std::unique_ptr<ExternalControlClient>(
-          new ExternalControlClient(std::move(impl), std::move(process), nullptr));
-    }
-    close(impl->sock_fd);
-    impl->sock_fd = -1;
+} // namespace
+
+std::unique_ptr<ExternalControlClient>
+ExternalControlClient::launchAndConnect(const RenodeConfig &config) {
+  // Launch Renode process
+  auto process = RenodeProcess::launch(config);
+  if (!process) {
+    throw RenodeException("Failed to launch Renode process");
   }
 
-  freeaddrinfo(res);
-  throw RenodeException("launchAndConnect: unable to connect to Renode");
+  // Reuse the connection that confirmed readiness
+  auto impl = std::make_unique<Impl>(config.host, config.port);
+  impl->launchConfig = config;
+  impl->sock_fd = openControlSocket(*process, config.host, config.port);
+  if (impl->sock_fd < 0) {
+    throw RenodeException("launchAndConnect: unable to connect to Renode");
+  }
+  impl->connected = true;
+
+  // Return client without monitor - connectMonitor() should be called after handshake
+  return std::unique_ptr<ExternalControlClient>(
+      new ExternalControlClient(std::move(impl), std::move(process), nullptr));
 }
 
 std::unique_ptr<ExternalControlClient>
@@ -270,6 +612,27 @@ ExternalControlClient::connect(const std::string &host, uint16_t port) {
   return nullptr;
 }
 
+std::unique_ptr<ExternalControlClient>
+ExternalControlClient::connectUnix(const std::string &socketPath) {
+  struct sockaddr_un addr{};
+  if (socketPath.size() >= sizeof(addr.sun_path)) {
+    throw RenodeException("connectUnix: socket path too long: " + socketPath);
+  }
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+  auto impl = std::make_unique<Impl>(socketPath, 0);
+  impl->sock_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (impl->sock_fd < 0 ||
+      ::connect(impl->sock_fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+    std::string reason = strerror(errno);
+    if (impl->sock_fd >= 0) close(impl->sock_fd);
+    throw RenodeException("connectUnix: " + socketPath + ": " + reason);
+  }
+  impl->connected = true;
+  return std::unique_ptr<ExternalControlClient>(new ExternalControlClient(std::move(impl)));
+}
+
 ExternalControlClient::ExternalControlClient(
     std::unique_ptr<Impl> impl) noexcept
     : pimpl_(std::move(impl)) {}
@@ -288,6 +651,7 @@ ExternalControlClient::ExternalControlClient(
 ExternalControlClient::~ExternalControlClient() {
   disconnect();
   // process_ destructor will terminate Renode if we own it
+  if (pimpl_ && !pimpl_->tempCheckpoint.empty()) std::remove(pimpl_->tempCheckpoint.c_str());
 }
 
 void ExternalControlClient::disconnect() noexcept {
@@ -295,11 +659,16 @@ void ExternalControlClient::disconnect() noexcept {
   if (pimpl_->sock_fd >= 0) {
     close(pimpl_->sock_fd);
     pimpl_->sock_fd = -1;
-    std::cout << "disconnected cleanly." << '\n';
+    std::cerr << "disconnected cleanly." << '\n';
   }
   pimpl_->connected = false;
 }
 
+void ExternalControlClient::interrupt() noexcept {
+  if (monitor_) monitor_->interrupt();
+  if (pimpl_ && pimpl_->sock_fd >= 0) shutdown(pimpl_->sock_fd, SHUT_RDWR);
+}
+
 Monitor* ExternalControlClient::getMonitor() noexcept {
   return monitor_.get();
 }
@@ -310,9 +679,12 @@ bool ExternalControlClient::connectMonitor(const std::string &host, uint16_t por
   }
 
   try {
-    monitor_ = Monitor::connect(host, port);
+    // A launched Renode's monitor is already connected from the readiness probe
+    if (process_) monitor_ = process_->takeMonitor();
+    if (!monitor_) monitor_ = Monitor::connect(host, port);
     if (pimpl_ && monitor_) {
       pimpl_->monitor = monitor_.get();
+      monitor_->setRecorder(pimpl_->recorder);
     }
     return true;
   } catch (const std::exception &e) {
@@ -321,6 +693,121 @@ bool ExternalControlClient::connectMonitor(const std::string &host, uint16_t por
   }
 }
 
+void ExternalControlClient::resetSessionState() noexcept {
+  if (!pimpl_) return;
+  std::lock_guard<std::mutex> lk(pimpl_->mtx);
+  pimpl_->machines.clear();
+  ++pimpl_->generation;
+}
+
+void ExternalControlClient::setRecorder(std::shared_ptr<StimulusRecorder> recorder) noexcept {
+  if (!pimpl_) return;
+  pimpl_->recorder = recorder;
+  if (monitor_) {
+    monitor_->setRecorder(std::move(recorder));
+  }
+}
+
+Error ExternalControlClient::supervise(SupervisionConfig config) noexcept {
+  if (!pimpl_ || !pimpl_->launchConfig || !process_) {
+    return {1, "supervise: client does not own its Renode process"};
+  }
+  if (!monitor_) return {2, "supervise: monitor connection required"};
+  if (!pimpl_->tempCheckpoint.empty()) {
+    std::remove(pimpl_->tempCheckpoint.c_str());
+    pimpl_->tempCheckpoint.clear();
+  }
+  if (config.checkpoint_path.empty()) {
+    config.checkpoint_path = "/tmp/digitwin-" + std::to_string(getpid()) + "-" +
+                             std::to_string(pimpl_->port) + ".save";
+    pimpl_->tempCheckpoint = config.checkpoint_path;
+  }
+  supervision_ = std::move(config);
+  pimpl_->processAlive = [this] { return process_ && process_->isRunning(); };
+  pimpl_->recover = [this](const std::string &reason) { return recover(reason); };
+  return {0, ""};
+}
+
+Error ExternalControlClient::checkpoint() noexcept {
+  if (!supervision_) return {1, "checkpoint: client is not supervised"};
+  if (!monitor_) return {2, "checkpoint: no monitor connection"};
+  return monitor_->saveSnapshot(supervision_->checkpoint_path);
+}
+
+// Relaunch Renode and rebuild the session. Runs on the thread whose command
+// hit the failure, possibly with Impl::mtx held by getMachine().
+bool ExternalControlClient::recover(const std::string &reason) noexcept {
+  Impl &impl = *pimpl_;
+  if (restarts_ >= supervision_->max_restarts) {
+    std::cerr << "Renode failed (" << reason << "), restart limit reached\n";
+    return false;
+  }
+  ++restarts_;
+  std::cerr << "Renode failed (" << reason << "), relaunching (restart " << restarts_
+            << ")\n";
+  impl.recovering = true;
+  struct Reset {
+    std::atomic<bool> &flag;
+    ~Reset() { flag = false; }
+  } reset{impl.recovering};
+
+  // Tear down what is left of the old process. Its log stream carries over,
+  // so subscribers and read cursors keep following the relaunched Renode.
+  impl.monitor = nullptr;
+  monitor_.reset();
+  if (impl.sock_fd >= 0) close(impl.sock_fd);
+  impl.sock_fd = -1;
+  impl.connected = false;
+  std::shared_ptr<LogStream> log = process_ ? process_->log() : nullptr;
+  process_.reset();
+
+  const RenodeConfig &config = *impl.launchConfig;
+  process_ = RenodeProcess::launch(config, std::move(log));
+  if (!process_) return false;
+  impl.sock_fd = openControlSocket(*process_, config.host, config.port);
+  if (impl.sock_fd < 0) return false;
+  impl.connected = true;
+  try {
+    if (!performHandshake()) return false;
+  } catch (const std::exception &ex) {
+    std::cerr << "recover: handshake failed: " << ex.what() << "\n";
+    return false;
+  }
+  if (config.monitor_port == 0 || !connectMonitor(config.host, config.monitor_port)) {
+    return false;
+  }
+
+  // Rebuild the emulation: the checkpoint if one was taken, else from scratch
+  const SupervisionConfig &sup = *supervision_;
+  if (access(sup.checkpoint_path.c_str(), R_OK) == 0) {
+    if (Error err = monitor_->loadSnapshot(sup.checkpoint_path)) {
+      std::cerr << "recover: " << err.message << "\n";
+      return false;
+    }
+  } else if (!sup.setup_commands.empty()) {
+    for (const auto &result : monitor_->executeBatch(sup.setup_commands)) {
+      if (result.error || monitorReportedError(result.value)) {
+        std::cerr << "recover: setup failed: "
+                  << (result.error ? result.error.message : result.value) << "\n";
+        return false;
+      }
+    }
+  }
+
+  // Every descriptor and instance id is stale now. Not under mtx: the
+  // failed command may be getMachine() itself.
+  ++impl.generation;
+  for (const auto &refresh : impl.refreshers->snapshot()) refresh();
+
+  if (sup.on_restart) {
+    try {
+      sup.on_restart(restarts_);
+    } catch (...) {
+    }
+  }
+  return true;
+}
+
 bool ExternalControlClient::performHandshake() {
 
   if (command_versions.size() > UINT16_MAX)
@@ -370,7 +857,34 @@ std::vector<uint8_t> ExternalControlClient::recv_response(ApiCommand expected_co
 }
 
 // Impl method implementations
-std::vector<uint8_t> ExternalControlClient::Impl::send_command(ApiCommand commandId, const std::vector<uint8_t> &payload) {
+std::vector<uint8_t> ExternalControlClient::Impl::send_command(ApiCommand commandId, const std::vector<uint8_t> &payload,
+                                                              uint8_t *returnCode) {
+  if (!recover || recovering) return send_command_once(commandId, payload, returnCode);
+
+  std::string reason;
+  if (processAlive && !processAlive()) {
+    reason = "Renode process exited";
+  } else {
+    try {
+      return send_command_once(commandId, payload, returnCode);
+    } catch (const std::exception &ex) {
+      reason = ex.what();
+    }
+  }
+  if (!recover(reason)) {
+    throw std::runtime_error("Renode recovery failed after: " + reason);
+  }
+  // RUN_FOR and GET_TIME carry no machine or instance ids, so they mean the
+  // same thing to the new process. Anything else addresses ids from before
+  // the restart; its handle re-registers on the next call.
+  if (commandId == ApiCommand::RUN_FOR || commandId == ApiCommand::GET_TIME) {
+    return send_command_once(commandId, payload, returnCode);
+  }
+  throw std::runtime_error("Renode restarted (" + reason + "); command not applied");
+}
+
+std::vector<uint8_t> ExternalControlClient::Impl::send_command_once(ApiCommand commandId, const std::vector<uint8_t> &payload,
+                                                                   uint8_t *returnCode) {
   // Build 7-byte header: 'R','E', command, data_size (4 bytes LE)
   uint8_t header[7];
   header[0] = static_cast<uint8_t>('R');
@@ -382,13 +896,23 @@ std::vector<uint8_t> ExternalControlClient::Impl::send_command(ApiCommand comman
   header[5] = static_cast<uint8_t>((data_size >> 16) & 0xFF);
   header[6] = static_cast<uint8_t>((data_size >> 24) & 0xFF);
 
-  // Send header then payload
-  send_bytes(header, sizeof(header));
-  if (!payload.empty())
-    send_bytes(payload.data(), payload.size());
+  uint64_t startNs = Telemetry::nowNs();
+
+  // Header and payload in one write: a separate payload segment waits in
+  // Nagle's buffer for the server's delayed ACK of the header (~40 ms on
+  // Linux), which would dominate every small command
+  std::vector<uint8_t> frame;
+  frame.reserve(sizeof(header) + payload.size());
+  frame.insert(frame.end(), header, header + sizeof(header));
+  frame.insert(frame.end(), payload.begin(), payload.end());
+  send_bytes(frame.data(), frame.size());
 
   // Receive and return the response payload
-  return recv_response(commandId);
+  std::vector<uint8_t> response = recv_response(commandId, returnCode);
+
+  Telemetry::instance().recordCommand(commandId, Telemetry::nowNs() - startNs,
+                                      sizeof(header) + payload.size(), response.size());
+  return response;
 }
 
 void ExternalControlClient::Impl::send_bytes(const uint8_t *data, size_t len) {
@@ -399,7 +923,8 @@ void ExternalControlClient::Impl::send_bytes(const uint8_t *data, size_t len) {
   }
 }
 
-std::vector<uint8_t> ExternalControlClient::Impl::recv_response(ApiCommand expected_command) {
+std::vector<uint8_t> ExternalControlClient::Impl::recv_response(ApiCommand expected_command,
+                                                                uint8_t *returnCode) {
   if (sock_fd < 0)
     throw std::runtime_error("socket closed");
 
@@ -421,37 +946,12 @@ std::vector<uint8_t> ExternalControlClient::Impl::recv_response(ApiCommand expec
 
     // Handle ASYNC_EVENT: invoke callback and continue waiting for actual response
     if (return_code == ASYNC_EVENT) {
-      // Parse event: command(1B) + ed(4B) + size(4B) + data(size bytes)
-      uint8_t event_command = 0;
-      if (!read_all(sock_fd, &event_command, 1)) {
-        throw std::runtime_error("recv_response: failed to read event command");
-      }
-
-      uint32_t event_ed = 0;
-      if (!safe_read_size(event_ed)) {
-        throw std::runtime_error("recv_response: failed to read event descriptor");
-      }
-
-      uint32_t event_size = 0;
-      if (!safe_read_size(event_size)) {
-        throw std::runtime_error("recv_response: failed to read event size");
-      }
-
-      std::vector<uint8_t> event_data;
-      if (event_size > 0) {
-        event_data.resize(event_size);
-        if (!read_all(sock_fd, event_data.data(), event_size)) {
-          throw std::runtime_error("recv_response: failed to read event data");
-        }
-      }
-
-      // Invoke the registered callback
-      EventCallbackRegistry::instance().invokeCallback(event_ed, event_data.data(), event_data.size());
-
+      recv_event();
       // Continue loop to read the actual response
       continue;
     }
 
+    if (returnCode) *returnCode = return_code;
     uint8_t received_command = 0xFF;
     // For many codes we read the echoed command
     if (return_code == COMMAND_FAILED || return_code == INVALID_COMMAND ||
@@ -500,6 +1000,45 @@ std::vector<uint8_t> ExternalControlClient::Impl::recv_response(ApiCommand expec
   }
 }
 
+void ExternalControlClient::Impl::recv_event() {
+  auto read_u32 = [this](uint32_t &out) -> bool {
+    uint8_t buf[4];
+    if (!read_all(sock_fd, buf, 4)) return false;
+    out = read_u32_le(buf);
+    return true;
+  };
+
+  // Parse event: command(1B) + ed(4B) + size(4B) + data(size bytes)
+  uint8_t event_command = 0;
+  if (!read_all(sock_fd, &event_command, 1)) {
+    throw std::runtime_error("recv_response: failed to read event command");
+  }
+
+  uint32_t event_ed = 0;
+  if (!read_u32(event_ed)) {
+    throw std::runtime_error("recv_response: failed to read event descriptor");
+  }
+
+  uint32_t event_size = 0;
+  if (!read_u32(event_size)) {
+    throw std::runtime_error("recv_response: failed to read event size");
+  }
+
+  std::vector<uint8_t> event_data;
+  if (event_size > 0) {
+    event_data.resize(event_size);
+    if (!read_all(sock_fd, event_data.data(), event_size)) {
+      throw std::runtime_error("recv_response: failed to read event data");
+    }
+  }
+
+  // Invoke the registered callback
+  uint64_t cbStartNs = Telemetry::nowNs();
+  EventCallbackRegistry::instance().invokeCallback(event_ed, event_data.data(), event_data.size());
+  Telemetry::instance().record(TelemetryMetric::CallbackNs, Telemetry::nowNs() - cbStartNs);
+  ++eventsDispatched;
+}
+
 std::string ExternalControlClient::bytes_to_string(const std::vector<uint8_t> &v) {
   static const char *hex = "0123456789abcdef";
   std::string s;
@@ -519,75 +1058,333 @@ ExternalControlClient& ExternalControlClient::operator=(ExternalControlClient&&)
 // Monitor Implementation
 // ============================================================================
 
+// Only lines that start like one of Renode's error messages count, so output
+// such as "ErrorCount = 0" does not
+bool monitorReportedError(const std::string &output) noexcept {
+  static constexpr std::string_view kPrefixes[] = {
+      "There was an error",  // command threw
+      "Error ",              // "Error E05: ..." from the .repl parser
+      "Error:",
+      "Errors during",       // platform/script loading
+      "No such command",     // "No such command or device: ..."
+      "Could not find",
+      "Could not load",
+  };
+  size_t pos = 0;
+  while (pos < output.size()) {
+    size_t eol = output.find('\n', pos);
+    std::string_view line(output.data() + pos, (eol == std::string::npos ? output.size() : eol) - pos);
+    while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+    for (std::string_view prefix : kPrefixes) {
+      if (line.substr(0, prefix.size()) == prefix) return true;
+    }
+    if (eol == std::string::npos) break;
+    pos = eol + 1;
+  }
+  return false;
+}
+
+namespace {
+
+// Incremental scanner for monitor output. One pass over each received chunk
+// drops telnet IAC negotiation, ANSI escape sequences and CRs, appends the
+// remaining text to a reusable buffer and notes every line that starts with
+// a prompt ("(monitor) ", "(machine-0) "). Responses are parsed in time
+// linear in their size, whatever the chunking.
+class PromptScanner {
+public:
+  struct Prompt {
+    size_t lineStart;  // offset of the prompt line in text()
+    size_t end;        // offset just past "(name) "
+  };
+
+  void reset() noexcept {
+    text_.clear();
+    prompts_.clear();
+    esc_ = Esc::None;
+    line_ = Line::Start;
+    lineStart_ = 0;
+  }
+
+  void feed(const char *data, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+      auto c = static_cast<unsigned char>(data[i]);
+      bool literal = false;
+      switch (esc_) {
+        case Esc::None:
+          break;
+        case Esc::Esc:
+          // ESC [ starts CSI, ESC ] starts OSC; other two-byte escapes end here
+          esc_ = c == '[' ? Esc::Csi : c == ']' ? Esc::Osc : Esc::None;
+          continue;
+        case Esc::Csi:
+          if (c >= 0x40 && c <= 0x7E) esc_ = Esc::None;
+          continue;
+        case Esc::Osc:
+          if (c == 0x07) esc_ = Esc::None;
+          else if (c == 0x1B) esc_ = Esc::Esc;
+          continue;
+        case Esc::Iac:
+          // WILL/WONT/DO/DONT carry an option byte; IAC IAC is a literal 0xFF
+          if (c == 0xFF) { esc_ = Esc::None; literal = true; break; }
+          esc_ = (c >= 0xFB && c <= 0xFE) ? Esc::IacOption : c == 0xFA ? Esc::IacSub : Esc::None;
+          continue;
+        case Esc::IacOption:
+          esc_ = Esc::None;
+          continue;
+        case Esc::IacSub:
+          if (c == 0xF0) esc_ = Esc::None;  // IAC SE (a bare SE byte is good enough here)
+          continue;
+      }
+      if (!literal) {
+        if (c == 0x1B) { esc_ = Esc::Esc; continue; }
+        if (c == 0xFF) { esc_ = Esc::Iac; continue; }
+        if (c == '\r' || c == '\0') continue;
+      }
+      text_.push_back(static_cast<char>(c));
+      advanceLine(static_cast<char>(c));
+    }
+  }
+
+  std::string_view text() const noexcept { return text_; }
+  const std::vector<Prompt> &prompts() const noexcept { return prompts_; }
+
+  // True if the text ends with a prompt that nothing has been written after
+  bool endsWithPrompt() const noexcept { return line_ == Line::Prompt; }
+
+private:
+  enum class Esc : uint8_t { None, Esc, Csi, Osc, Iac, IacOption, IacSub };
+  enum class Line : uint8_t { Start, Name, Close, Prompt, Other };
+
+  void advanceLine(char c) {
+    if (c == '\n') {
+      line_ = Line::Start;
+      lineStart_ = text_.size();
+      return;
+    }
+    switch (line_) {
+      case Line::Start:
+        line_ = c == '(' ? Line::Name : Line::Other;
+        break;
+      case Line::Name:
+        if (c == ')') {
+          // Require a non-empty name
+          line_ = text_.size() - lineStart_ > 2 ? Line::Close : Line::Other;
+        } else if (c == '(' || c == ' ' || c == '\t') {
+          line_ = Line::Other;
+        }
+        break;
+      case Line::Close:
+        if (c == ' ') {
+          line_ = Line::Prompt;
+          prompts_.push_back({lineStart_, text_.size()});
+        } else {
+          line_ = Line::Other;
+        }
+        break;
+      case Line::Prompt:
+        line_ = Line::Other;  // e.g. the echo of the next pipelined command
+        break;
+      case Line::Other:
+        break;
+    }
+  }
+
+  std::string text_;
+  std::vector<Prompt> prompts_;
+  Esc esc_ = Esc::None;
+  Line line_ = Line::Start;
+  size_t lineStart_ = 0;
+};
+
+} // namespace
+
 struct Monitor::Impl {
   int sock_fd = -1;
   std::string host;
   uint16_t port;
+  std::shared_ptr<StimulusRecorder> recorder;
+  PromptScanner scanner;
+  std::vector<char> rxBuf = std::vector<char>(64 * 1024);
+  std::string lastPrompt;  // e.g. "(monitor) ", changes with "mach set"
+  mutable std::mutex promptMtx;  // guards selected
+  std::string selected;  // machine named by lastPrompt, "" for "(monitor)"
+
+  // Every command runs on ioThread; callers only enqueue. Jobs queued while
+  // a command is on the wire are pipelined together as one batch.
+  using Results = std::vector<Result<std::string>>;
+  struct Job {
+    std::vector<std::string> commands;
+    std::function<void(Results &&)> complete;
+  };
+  std::mutex queueMtx;  // guards queue, stopping and recorder
+  std::condition_variable queueCv;
+  std::deque<Job> queue;
+  bool stopping = false;
+  std::thread ioThread;
 
   Impl(const std::string &h, uint16_t p) : host(h), port(p) {}
 
   ~Impl() {
+    {
+      std::lock_guard<std::mutex> lock(queueMtx);
+      stopping = true;
+    }
+    queueCv.notify_all();
+    // Unblock a command still waiting for its prompt
+    if (sock_fd >= 0) shutdown(sock_fd, SHUT_RDWR);
+    if (ioThread.joinable()) ioThread.join();
     if (sock_fd >= 0) {
       close(sock_fd);
     }
   }
 
-  // Read until we get a monitor prompt like "(monitor) " or "(machine-name) "
-  std::string readUntilPrompt() {
-    std::string result;
-    char buf[256];
+  void enqueue(Job job) {
+    {
+      std::lock_guard<std::mutex> lock(queueMtx);
+      if (!stopping) {
+        queue.push_back(std::move(job));
+        queueCv.notify_one();
+        return;
+      }
+    }
+    finish(job, Results(job.commands.size(), {"", {1, "Monitor closed"}}));
+  }
+
+  bool onIoThread() const noexcept { return std::this_thread::get_id() == ioThread.get_id(); }
+
+  // Run commands on the calling (I/O) thread and record successful ones
+  Results run(const std::vector<std::string> &commands,
+              const std::shared_ptr<StimulusRecorder> &rec) {
+    Results results;
+    try {
+      if (commands.size() == 1) {
+        results.push_back(sendCommand(commands[0]));
+      } else {
+        results = sendBatch(commands);
+      }
+    } catch (const std::exception &e) {
+      results.assign(commands.size(), {"", {1, e.what()}});
+    }
+    if (rec) {
+      for (size_t i = 0; i < commands.size(); ++i) {
+        if (!results[i].error) rec->recordMonitorCommand(commands[i]);
+      }
+    }
+    return results;
+  }
+
+  void ioLoop() {
+    std::unique_lock<std::mutex> lock(queueMtx);
+    while (true) {
+      queueCv.wait(lock, [this]() { return stopping || !queue.empty(); });
+      if (stopping) break;
+
+      std::deque<Job> jobs;
+      jobs.swap(queue);
+      auto rec = recorder;
+      lock.unlock();
 
-    // std::cerr << "[Monitor] readUntilPrompt: waiting for data...\n";
+      std::vector<std::string> commands;
+      for (const auto &job : jobs) {
+        commands.insert(commands.end(), job.commands.begin(), job.commands.end());
+      }
+      Results results = run(commands, rec);
+
+      size_t offset = 0;
+      for (auto &job : jobs) {
+        Results mine(std::make_move_iterator(results.begin() + offset),
+                     std::make_move_iterator(results.begin() + offset + job.commands.size()));
+        offset += job.commands.size();
+        finish(job, std::move(mine));
+      }
+      lock.lock();
+    }
+
+    // Fail whatever is still queued
+    std::deque<Job> rest;
+    rest.swap(queue);
+    lock.unlock();
+    for (auto &job : rest) {
+      finish(job, Results(job.commands.size(), {"", {1, "Monitor closed"}}));
+    }
+  }
+
+  // A throwing completion callback must not kill the I/O thread or unwind
+  // into the caller that happened to run it
+  static void finish(Job &job, Results &&results) noexcept {
+    try {
+      job.complete(std::move(results));
+    } catch (const std::exception &e) {
+      std::cerr << "[Monitor] completion callback threw: " << e.what() << "\n";
+    } catch (...) {
+      std::cerr << "[Monitor] completion callback threw\n";
+    }
+  }
+
+  // Read until we get a monitor prompt like "(monitor) " or "(machine-name) ".
+  // Returns the output before the prompt line as a view into the scanner's
+  // buffer, valid until the next read; nullopt if the connection closed or
+  // failed first (the partial output is not a response).
+  std::optional<std::string_view> readUntilPrompt() {
+    scanner.reset();
     while (true) {
-      ssize_t n = recv(sock_fd, buf, sizeof(buf) - 1, 0);
+      ssize_t n = recv(sock_fd, rxBuf.data(), rxBuf.size(), 0);
       if (n <= 0) {
         std::cerr << "[Monitor] recv returned " << n << " (errno=" << errno << ")\n";
-        break;
+        return std::nullopt;
       }
-      buf[n] = '\0';
-      result += buf;
-      // std::cerr << "[Monitor] received " << n << " bytes, total=" << result.size()
-      //           << ", last chars: \"" << result.substr(result.size() > 20 ? result.size() - 20 : 0) << "\"\n";
-
-      // Check if we've received a prompt pattern: (something) followed by space
-      // The prompt often has trailing space and may have ANSI codes
-      // Look for ") " pattern near the end of the buffer
-      size_t promptMarker = result.rfind(") ");
-      if (promptMarker != std::string::npos) {
-        // Found ") ", now find the matching "("
-        size_t openPos = result.rfind('(', promptMarker);
-        if (openPos != std::string::npos && promptMarker > openPos) {
-          // std::cerr << "[Monitor] found prompt at pos " << openPos << " to " << promptMarker << "\n";
-          // Remove the prompt (and any ANSI codes before it) from output
-          // Find the start of the line containing the prompt
-          size_t lineStart = result.rfind('\n', openPos);
-          if (lineStart == std::string::npos) lineStart = 0;
-          else lineStart++; // Skip the newline itself
-          result = result.substr(0, lineStart);
-          break;
-        }
+      scanner.feed(rxBuf.data(), static_cast<size_t>(n));
+
+      // The prompt is the last thing Renode writes before waiting for input;
+      // anything still queued means the match was output text
+      if (scanner.endsWithPrompt() && !moreDataQueued()) {
+        const auto &prompt = scanner.prompts().back();
+        setPrompt(scanner.text().substr(prompt.lineStart, prompt.end - prompt.lineStart));
+        return scanner.text().substr(0, prompt.lineStart);
       }
     }
-    // std::cerr << "[Monitor] readUntilPrompt done, result length=" << result.size() << "\n";
-    return result;
   }
 
-  // Send command and read response
-  Result<std::string> sendCommand(const std::string &cmd) {
-    std::string cmdLine = cmd + "\n";
-    if (send(sock_fd, cmdLine.c_str(), cmdLine.size(), 0) < 0) {
-      return {"", {1, "Failed to send command"}};
-    }
+  void setPrompt(std::string_view prompt) {
+    if (prompt == lastPrompt) return;
+    lastPrompt.assign(prompt);
+    // "(machine-0) " -> "machine-0"; the bare monitor prompt selects nothing
+    std::string_view name = prompt;
+    while (!name.empty() && name.back() == ' ') name.remove_suffix(1);
+    if (name.size() >= 2 && name.front() == '(' && name.back() == ')')
+      name = name.substr(1, name.size() - 2);
+    std::lock_guard<std::mutex> lock(promptMtx);
+    selected.assign(name == "monitor" ? std::string_view{} : name);
+  }
 
-    std::string response = readUntilPrompt();
+  bool moreDataQueued() const {
+    char probe;
+    return recv(sock_fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT) > 0;
+  }
 
+  bool sendAll(const std::string &data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+      ssize_t n = send(sock_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        return false;
+      }
+      sent += static_cast<size_t>(n);
+    }
+    return true;
+  }
+
+  // Drop the echoed command line and surrounding whitespace
+  static std::string cleanResponse(std::string_view response) {
     // Strip leading newline and the echoed command if present
     size_t start = 0;
     if (!response.empty() && response[0] == '\n') start = 1;
 
     // Skip echoed command line
     size_t cmdEnd = response.find('\n', start);
-    if (cmdEnd != std::string::npos) {
+    if (cmdEnd != std::string_view::npos) {
       start = cmdEnd + 1;
     }
 
@@ -597,8 +1394,111 @@ struct Monitor::Impl {
                            response[end-1] == ' ')) {
       --end;
     }
+    return std::string(response.substr(start, end - start));
+  }
+
+  // Send command and read response
+  Result<std::string> sendCommand(const std::string &cmd) {
+    uint64_t startNs = Telemetry::nowNs();
+    if (!sendAll(cmd + "\n")) {
+      return {"", {ERR_NOT_CONNECTED, "Failed to send command"}};
+    }
 
-    return {response.substr(start, end - start), {0, ""}};
+    auto response = readUntilPrompt();
+    if (!response) return {"", {ERR_NOT_CONNECTED, "Monitor connection lost"}};
+    Telemetry::instance().record(TelemetryMetric::MonitorRttNs, Telemetry::nowNs() - startNs);
+    return {cleanResponse(*response), {0, ""}};
+  }
+
+  // Pipelined commands are sent in windows of at most this many bytes, so a
+  // window always fits the socket buffers and send() cannot stall while
+  // Renode is blocked writing output we have not read yet
+  static constexpr size_t kBatchWindowBytes = 16 * 1024;
+
+  // Write commands [first, last) in one send and split the prompt-delimited
+  // stream back into one output per command. Renode echoes each line after
+  // the prompt that precedes it, so a prompt is accepted mid-stream only when
+  // the rest of its line is the next command (output can contain lines that
+  // look like a prompt); the final one must end the stream, as for single
+  // commands.
+  bool readBatch(const std::vector<std::string> &cmds, size_t first, size_t last,
+                 std::vector<Result<std::string>> &out) {
+    const size_t count = last - first;
+    std::vector<PromptScanner::Prompt> confirmed;
+    size_t cursor = 0;
+    scanner.reset();
+
+    while (confirmed.size() < count) {
+      ssize_t n = recv(sock_fd, rxBuf.data(), rxBuf.size(), 0);
+      if (n <= 0) {
+        std::cerr << "[Monitor] recv returned " << n << " (errno=" << errno << ")\n";
+        return false;
+      }
+      scanner.feed(rxBuf.data(), static_cast<size_t>(n));
+
+      const auto &prompts = scanner.prompts();
+      std::string_view text = scanner.text();
+      while (cursor < prompts.size() && confirmed.size() < count) {
+        const auto &p = prompts[cursor];
+        size_t k = confirmed.size();
+        if (k + 1 == count) {
+          // Final prompt: must be the newest candidate with nothing after it
+          if (cursor + 1 < prompts.size()) { ++cursor; continue; }
+          if (!scanner.endsWithPrompt()) { ++cursor; continue; }
+          if (moreDataQueued()) break;
+          confirmed.push_back(p);
+          break;
+        }
+        std::string_view promptText = text.substr(p.lineStart, p.end - p.lineStart);
+        size_t eol = text.find('\n', p.end);
+        if (eol == std::string_view::npos) break;  // echo not complete yet
+        if (text.substr(p.end, eol - p.end) == cmds[first + k + 1]) {
+          setPrompt(promptText);
+          confirmed.push_back(p);
+        }
+        ++cursor;
+      }
+    }
+
+    std::string_view text = scanner.text();
+    size_t segStart = 0;
+    for (const auto &p : confirmed) {
+      out.push_back({cleanResponse(text.substr(segStart, p.lineStart - segStart)), {0, ""}});
+      segStart = p.end;
+    }
+    const auto &tail = confirmed.back();
+    setPrompt(text.substr(tail.lineStart, tail.end - tail.lineStart));
+    return true;
+  }
+
+  std::vector<Result<std::string>> sendBatch(const std::vector<std::string> &cmds) {
+    std::vector<Result<std::string>> results;
+    results.reserve(cmds.size());
+    size_t first = 0;
+    while (first < cmds.size()) {
+      std::string payload;
+      size_t last = first;
+      while (last < cmds.size() &&
+             (last == first || payload.size() + cmds[last].size() + 1 <= kBatchWindowBytes)) {
+        payload += cmds[last];
+        payload += '\n';
+        ++last;
+      }
+
+      uint64_t startNs = Telemetry::nowNs();
+      bool ok = sendAll(payload) && readBatch(cmds, first, last, results);
+      if (!ok) {
+        // Output of a partially read window cannot be attributed reliably
+        results.resize(first);
+        while (results.size() < cmds.size()) {
+          results.push_back({"", {ERR_NOT_CONNECTED, "Monitor connection lost during batch"}});
+        }
+        return results;
+      }
+      Telemetry::instance().record(TelemetryMetric::MonitorRttNs, Telemetry::nowNs() - startNs);
+      first = last;
+    }
+    return results;
   }
 };
 
@@ -609,8 +1509,6 @@ Monitor &Monitor::operator=(Monitor &&other) noexcept = default;
 Monitor::~Monitor() = default;
 
 std::unique_ptr<Monitor> Monitor::connect(const std::string &host, uint16_t port) {
-  auto impl = std::make_unique<Impl>(host, port);
-
   struct addrinfo hints{};
   struct addrinfo *res = nullptr;
 
@@ -623,30 +1521,139 @@ std::unique_ptr<Monitor> Monitor::connect(const std::string &host, uint16_t port
   }
 
   for (struct addrinfo *ai = res; ai != nullptr; ai = ai->ai_next) {
-    impl->sock_fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
-    if (impl->sock_fd < 0)
+    int fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0)
       continue;
-    if (::connect(impl->sock_fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
       freeaddrinfo(res);
-
-      // Read initial prompt
-      impl->readUntilPrompt();
-
-      return std::unique_ptr<Monitor>(new Monitor(std::move(impl)));
+      return adopt(fd, host, port);
     }
-    close(impl->sock_fd);
-    impl->sock_fd = -1;
+    close(fd);
   }
 
   freeaddrinfo(res);
   throw RenodeException("Monitor: unable to connect to " + host + ":" + std::to_string(port));
 }
 
+std::unique_ptr<Monitor> Monitor::adopt(int fd, const std::string &host, uint16_t port) {
+  auto impl = std::make_unique<Impl>(host, port);
+  impl->sock_fd = fd;
+
+  // Read initial prompt
+  if (!impl->readUntilPrompt()) {
+    throw RenodeException("Monitor: no prompt from " + host + ":" + std::to_string(port));
+  }
+
+  impl->ioThread = std::thread(&Impl::ioLoop, impl.get());
+  return std::unique_ptr<Monitor>(new Monitor(std::move(impl)));
+}
+
 Result<std::string> Monitor::execute(const std::string &command) noexcept {
+  try {
+    return executeAsync(command).get();
+  } catch (const std::exception &e) {
+    return {"", {1, e.what()}};
+  }
+}
+
+std::vector<Result<std::string>>
+Monitor::executeBatch(const std::vector<std::string> &commands) noexcept {
+  try {
+    return executeBatchAsync(commands).get();
+  } catch (const std::exception &e) {
+    return std::vector<Result<std::string>>(commands.size(), {"", {1, e.what()}});
+  }
+}
+
+std::future<Result<std::string>> Monitor::executeAsync(std::string command) {
+  auto promise = std::make_shared<std::promise<Result<std::string>>>();
+  auto future = promise->get_future();
+  executeAsync(std::move(command), [promise](Result<std::string> result) {
+    promise->set_value(std::move(result));
+  });
+  return future;
+}
+
+void Monitor::executeAsync(std::string command,
+                           std::function<void(Result<std::string>)> done) {
+  Impl::Job job;
+  job.complete = [done = std::move(done)](Impl::Results &&results) {
+    done(std::move(results[0]));
+  };
+  if (!pimpl_ || pimpl_->sock_fd < 0) {
+    Impl::finish(job, {{"", {1, "Not connected"}}});
+    return;
+  }
+  // Commands are pipelined, so an embedded newline would split into two
+  if (command.find('\n') != std::string::npos) {
+    Impl::finish(job, {{"", {2, "Batched commands must be single lines"}}});
+    return;
+  }
+  job.commands.push_back(std::move(command));
+  if (pimpl_->onIoThread()) {
+    // Called from a completion callback: queuing would wait on ourselves
+    std::shared_ptr<StimulusRecorder> rec;
+    {
+      std::lock_guard<std::mutex> lock(pimpl_->queueMtx);
+      rec = pimpl_->recorder;
+    }
+    Impl::finish(job, pimpl_->run(job.commands, rec));
+    return;
+  }
+  pimpl_->enqueue(std::move(job));
+}
+
+std::future<std::vector<Result<std::string>>>
+Monitor::executeBatchAsync(std::vector<std::string> commands) {
+  auto promise = std::make_shared<std::promise<std::vector<Result<std::string>>>>();
+  auto future = promise->get_future();
   if (!pimpl_ || pimpl_->sock_fd < 0) {
-    return {"", {1, "Not connected"}};
+    promise->set_value(std::vector<Result<std::string>>(commands.size(),
+                                                        {"", {1, "Not connected"}}));
+    return future;
+  }
+  for (const auto &cmd : commands) {
+    if (cmd.find('\n') != std::string::npos) {
+      promise->set_value(std::vector<Result<std::string>>(
+          commands.size(), {"", {2, "Batched commands must be single lines"}}));
+      return future;
+    }
   }
-  return pimpl_->sendCommand(command);
+  if (commands.empty()) {
+    promise->set_value({});
+    return future;
+  }
+
+  Impl::Job job;
+  job.commands = std::move(commands);
+  job.complete = [promise](Impl::Results &&results) { promise->set_value(std::move(results)); };
+  if (pimpl_->onIoThread()) {
+    std::shared_ptr<StimulusRecorder> rec;
+    {
+      std::lock_guard<std::mutex> lock(pimpl_->queueMtx);
+      rec = pimpl_->recorder;
+    }
+    Impl::finish(job, pimpl_->run(job.commands, rec));
+    return future;
+  }
+  pimpl_->enqueue(std::move(job));
+  return future;
+}
+
+std::string Monitor::selectedMachine() const {
+  if (!pimpl_) return {};
+  std::lock_guard<std::mutex> lock(pimpl_->promptMtx);
+  return pimpl_->selected;
+}
+
+void Monitor::interrupt() noexcept {
+  if (pimpl_ && pimpl_->sock_fd >= 0) shutdown(pimpl_->sock_fd, SHUT_RDWR);
+}
+
+void Monitor::setRecorder(std::shared_ptr<StimulusRecorder> recorder) noexcept {
+  if (!pimpl_) return;
+  std::lock_guard<std::mutex> lock(pimpl_->queueMtx);
+  pimpl_->recorder = std::move(recorder);
 }
 
 Error Monitor::loadPlatformDescription(const std::string &path) noexcept {
@@ -674,4 +1681,18 @@ Error Monitor::reset() noexcept {
   return result.error;
 }
 
+Error Monitor::saveSnapshot(const std::string &path) noexcept {
+  auto result = execute("Save @" + path);
+  if (result.error) return result.error;
+  if (monitorReportedError(result.value)) return {2, "Save failed: " + result.value};
+  return {0, ""};
+}
+
+Error Monitor::loadSnapshot(const std::string &path) noexcept {
+  auto result = execute("Load @" + path);
+  if (result.error) return result.error;
+  if (monitorReportedError(result.value)) return {2, "Load failed: " + result.value};
+  return {0, ""};
+}
+
 } // namespace renode
\ No newline at end of file
@@ -3,10 +3,15 @@
 #pragma once
 
 #include "renodeInterface.h"
+#include "renodeRecorder.h"
 #include "defs.h"
+#include <atomic>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <functional>
+#include <optional>
+#include <vector>
 
 namespace renode {
 
@@ -70,12 +75,69 @@ struct ExternalControlClient::Impl {
   // Pointer to Monitor (owned by ExternalControlClient, set after construction)
   Monitor* monitor = nullptr;
 
+  // Running count of ASYNC_EVENTs dispatched (telemetry: events per tick)
+  uint64_t eventsDispatched = 0;
+
+  // Optional stimulus recorder (set via ExternalControlClient::setRecorder)
+  std::shared_ptr<StimulusRecorder> recorder;
+
+  // Bumped whenever server-side state is replaced (snapshot restore). Machine
+  // and peripheral handles compare it against the generation they registered
+  // in and re-register lazily when it differs.
+  uint64_t generation = 0;
+
+  // Launch parameters of an owned process, kept so it can be relaunched
+  std::optional<RenodeConfig> launchConfig;
+
+  // Supervised mode hooks (ExternalControlClient::supervise). recover()
+  // relaunches Renode and rebuilds the session; false if it could not.
+  std::function<bool()> processAlive;
+  std::function<bool(const std::string &reason)> recover;
+  std::atomic<bool> recovering{false};
+  std::string tempCheckpoint;  // default checkpoint file, removed with the client
+
+  // Handles whose server-side state must be rebuilt right after a restart
+  // rather than on next use: GPIO event subscriptions fire without the
+  // handle being touched. Shared so a handle outliving the client can still
+  // unregister through a weak_ptr.
+  struct Refreshers {
+    std::mutex mtx;
+    std::map<uint64_t, std::function<void()>> fns;
+    uint64_t next = 1;
+
+    uint64_t add(std::function<void()> fn) {
+      std::lock_guard<std::mutex> lk(mtx);
+      uint64_t id = next++;
+      fns.emplace(id, std::move(fn));
+      return id;
+    }
+    void remove(uint64_t id) noexcept {
+      std::lock_guard<std::mutex> lk(mtx);
+      fns.erase(id);
+    }
+    std::vector<std::function<void()>> snapshot() {
+      std::lock_guard<std::mutex> lk(mtx);
+      std::vector<std::function<void()>> out;
+      for (const auto &kv : fns) out.push_back(kv.second);
+      return out;
+    }
+  };
+  std::shared_ptr<Refreshers> refreshers = std::make_shared<Refreshers>();
+
   Impl(const std::string &h, uint16_t p) : host(h), port(p) {}
 
   // Protocol methods for peripheral classes to use
+  // returnCode, if given, receives the renode_return_code of the reply
   void send_bytes(const uint8_t *data, size_t len);
-  std::vector<uint8_t> recv_response(ApiCommand expected_command);
-  std::vector<uint8_t> send_command(ApiCommand commandId, const std::vector<uint8_t> &payload);
+  std::vector<uint8_t> recv_response(ApiCommand expected_command, uint8_t *returnCode = nullptr);
+  std::vector<uint8_t> send_command(ApiCommand commandId, const std::vector<uint8_t> &payload,
+                                    uint8_t *returnCode = nullptr);
+  std::vector<uint8_t> send_command_once(ApiCommand commandId,
+                                         const std::vector<uint8_t> &payload,
+                                         uint8_t *returnCode = nullptr);
+  // Read and dispatch the rest of an ASYNC_EVENT frame whose code byte has
+  // already been consumed
+  void recv_event();
 };
 
 } // namespace renode
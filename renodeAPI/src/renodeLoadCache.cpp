@@ -0,0 +1,301 @@
+// renodeLoadCache.cpp
+#include "renodeLoadCache.h"
+#include "renodeMachine.h"
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace renode {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Minimal SHA-256 (FIPS 180-4); only used for cache keys
+class Sha256 {
+public:
+  Sha256() { reset(); }
+
+  void reset() {
+    h_ = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+          0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    len_ = 0;
+    used_ = 0;
+  }
+
+  void update(const void *data, size_t n) {
+    auto p = static_cast<const uint8_t *>(data);
+    len_ += n;
+    while (n > 0) {
+      size_t take = std::min(n, sizeof(buf_) - used_);
+      std::memcpy(buf_ + used_, p, take);
+      used_ += take;
+      p += take;
+      n -= take;
+      if (used_ == sizeof(buf_)) {
+        block(buf_);
+        used_ = 0;
+      }
+    }
+  }
+
+  void update(const std::string &s) { update(s.data(), s.size() + 1); }  // with terminator
+
+  std::string hex() {
+    uint64_t bits = len_ * 8;
+    uint8_t pad = 0x80;
+    update(&pad, 1);
+    uint8_t zero = 0;
+    while (used_ != 56) update(&zero, 1);
+    uint8_t lenBytes[8];
+    for (int i = 0; i < 8; ++i) lenBytes[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+    update(lenBytes, 8);
+
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (uint32_t word : h_) {
+      for (int shift = 28; shift >= 0; shift -= 4) out.push_back(digits[(word >> shift) & 0xF]);
+    }
+    return out;
+  }
+
+private:
+  static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+  void block(const uint8_t *p) {
+    static constexpr uint32_t k[64] = {
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+        0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+        0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+        0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+        0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+        0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+        0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+        0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+        0xc67178f2};
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+      w[i] = (uint32_t(p[4 * i]) << 24) | (uint32_t(p[4 * i + 1]) << 16) |
+             (uint32_t(p[4 * i + 2]) << 8) | uint32_t(p[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+      uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = h_[0], b = h_[1], c = h_[2], d = h_[3];
+    uint32_t e = h_[4], f = h_[5], g = h_[6], h = h_[7];
+    for (int i = 0; i < 64; ++i) {
+      uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+      uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+      h = g; g = f; f = e; e = d + t1;
+      d = c; c = b; b = a; a = t1 + t2;
+    }
+    h_[0] += a; h_[1] += b; h_[2] += c; h_[3] += d;
+    h_[4] += e; h_[5] += f; h_[6] += g; h_[7] += h;
+  }
+
+  std::array<uint32_t, 8> h_;
+  uint64_t len_ = 0;
+  uint8_t buf_[64];
+  size_t used_ = 0;
+};
+
+std::string defaultCacheDir() {
+  if (const char *xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+    return std::string(xdg) + "/digitwin";
+  }
+  if (const char *home = std::getenv("HOME"); home && *home) {
+    return std::string(home) + "/.cache/digitwin";
+  }
+  return "/tmp/digitwin-cache";
+}
+
+bool isRepl(const std::string &path) {
+  return path.size() >= 5 && path.compare(path.size() - 5, 5, ".repl") == 0;
+}
+
+// Hash a file's bytes; for .repl also every file it pulls in with `using "x"`
+bool hashFile(const fs::path &path, Sha256 &sha, std::set<fs::path> &visited, int depth) {
+  std::error_code ec;
+  fs::path canonical = fs::weakly_canonical(path, ec);
+  if (ec) canonical = path;
+  if (!visited.insert(canonical).second) return true;
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in) return false;
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  sha.update(content.size() ? content.data() : "", content.size());
+  uint8_t sep = 0;
+  sha.update(&sep, 1);
+
+  if (!isRepl(path.string()) || depth > 8) return true;
+  size_t pos = 0;
+  while ((pos = content.find("using \"", pos)) != std::string::npos) {
+    size_t start = pos + 7;
+    size_t end = content.find('"', start);
+    if (end == std::string::npos) break;
+    std::string include = content.substr(start, end - start);
+    pos = end;
+    fs::path candidate = path.parent_path() / include;
+    if (!fs::exists(candidate, ec)) candidate = include;
+    if (fs::exists(candidate, ec)) {
+      if (!hashFile(candidate, sha, visited, depth + 1)) return false;
+    } else {
+      // Resolved by Renode from its own tree: key on the name
+      sha.update(include);
+    }
+  }
+  return true;
+}
+
+// Temporary sibling of path, unique across processes (pid) and across
+// threads of this one (counter), renamed into place once complete
+std::string partName(const fs::path &path) {
+  static std::atomic<uint64_t> counter{0};
+  return path.string() + ".part" + std::to_string(getpid()) + "-" +
+         std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+}
+
+} // namespace
+
+LoadCache::LoadCache(LoadCacheConfig config)
+    : config_(std::move(config)),
+      dir_(config_.directory.empty() ? defaultCacheDir() : config_.directory) {}
+
+bool LoadCache::isRemote(const std::string &p) noexcept {
+  return p.rfind("http://", 0) == 0 || p.rfind("https://", 0) == 0;
+}
+
+LoadCache::Stats LoadCache::stats() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return stats_;
+}
+
+Result<std::string> LoadCache::resolve(const std::string &pathOrUrl) noexcept {
+  if (!isRemote(pathOrUrl)) return {pathOrUrl, {0, ""}};
+  if (!config_.mirror_remote) return {pathOrUrl, {0, ""}};
+
+  try {
+    Sha256 sha;
+    sha.update(pathOrUrl);
+    std::string name = pathOrUrl.substr(pathOrUrl.find_last_of('/') + 1);
+    if (name.empty() || name.size() > 64) name = "file";
+    fs::path mirrorDir = fs::path(dir_) / "mirror";
+    fs::path local = mirrorDir / (sha.hex().substr(0, 16) + "-" + name);
+    if (fs::exists(local)) return {local.string(), {0, ""}};
+    if (config_.offline) {
+      return {"", {ERR_COMMAND_FAILED, "Offline and not mirrored: " + pathOrUrl}};
+    }
+
+    fs::create_directories(mirrorDir);
+    std::string tmp = partName(local);
+    const char *argv[] = {"curl", "-fsSL", "--retry", "2", "-o", tmp.c_str(),
+                          pathOrUrl.c_str(), nullptr};
+    pid_t pid;
+    if (posix_spawnp(&pid, "curl", nullptr, nullptr, const_cast<char **>(argv), environ) != 0) {
+      return {"", {ERR_COMMAND_FAILED, "Cannot run curl to mirror " + pathOrUrl}};
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      std::remove(tmp.c_str());
+      return {"", {ERR_COMMAND_FAILED, "Download failed: " + pathOrUrl}};
+    }
+    fs::rename(tmp, local);
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++stats_.mirrored;
+    return {local.string(), {0, ""}};
+  } catch (const std::exception &e) {
+    return {"", {ERR_COMMAND_FAILED, std::string("Mirror failed: ") + e.what()}};
+  }
+}
+
+Result<std::string> LoadCache::key(const std::string &machineName,
+                                   const std::vector<std::string> &localFiles) noexcept {
+  try {
+    Sha256 sha;
+    sha.update(std::string("digitwin-load-cache-v1"));
+    sha.update(machineName);
+    for (const auto &file : localFiles) {
+      std::set<fs::path> visited;
+      sha.update(file.substr(file.find_last_of('.') + 1));  // load command depends on it
+      if (!hashFile(file, sha, visited, 0)) {
+        return {"", {ERR_COMMAND_FAILED, "Cannot read " + file}};
+      }
+    }
+    return {sha.hex(), {0, ""}};
+  } catch (const std::exception &e) {
+    return {"", {ERR_COMMAND_FAILED, e.what()}};
+  }
+}
+
+Result<bool> LoadCache::load(AMachine &machine, const std::vector<std::string> &files) noexcept {
+  std::vector<std::string> local;
+  bool cacheable = true;
+  for (const auto &file : files) {
+    auto resolved = resolve(file);
+    if (resolved.error) return {false, resolved.error};
+    cacheable = cacheable && !isRemote(resolved.value);
+    local.push_back(std::move(resolved.value));
+  }
+
+  if (!cacheable) {
+    // Contents of a non-mirrored URL are unknown: no key, plain load
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      ++stats_.uncacheable;
+    }
+    return {false, machine.loadConfiguration(local)};
+  }
+
+  auto k = key(machine.name(), local);
+  if (k.error) return {false, k.error};
+  std::error_code ec;
+  fs::path snapshots = fs::path(dir_) / "snapshots";
+  fs::path snapshot = snapshots / (k.value + ".save");
+
+  if (fs::exists(snapshot, ec)) {
+    if (!machine.restoreSnapshot(snapshot.string())) {
+      std::lock_guard<std::mutex> lock(mtx_);
+      ++stats_.hits;
+      return {true, {0, ""}};
+    }
+    // Stale or incompatible snapshot (e.g. other Renode version): rebuild it
+    std::cerr << "LoadCache: dropping unusable snapshot " << snapshot << "\n";
+    fs::remove(snapshot, ec);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    ++stats_.misses;
+  }
+  if (Error err = machine.loadConfiguration(local)) return {false, err};
+
+  // Write under a temporary name so concurrent runs never see a partial file
+  fs::create_directories(snapshots, ec);
+  std::string tmp = partName(snapshot);
+  if (Error err = machine.saveSnapshot(tmp)) {
+    std::cerr << "LoadCache: cannot save snapshot: " << err.message << "\n";
+    std::remove(tmp.c_str());
+    return {false, {0, ""}};  // loaded fine, just not cached
+  }
+  fs::rename(tmp, snapshot, ec);
+  if (ec) std::remove(tmp.c_str());
+  return {false, {0, ""}};
+}
+
+} // namespace renode
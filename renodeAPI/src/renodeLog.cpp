@@ -0,0 +1,235 @@
+// renodeLog.cpp
+#include "renodeLog.h"
+#include "renodeTelemetry.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace renode {
+
+// Fixed-size slot so pushing never allocates. version is even when stable
+// (2*seq + 2 once entry seq is complete) and odd while being written. The
+// payload fields are relaxed atomics: readers may race the producer and only
+// trust what they copied once the version check confirms it.
+struct LogStream::Slot {
+  static constexpr size_t kWords = (kMaxLineBytes + 7) / 8;
+
+  std::atomic<uint64_t> version{0};
+  std::atomic<uint64_t> wallNs{0};
+  std::atomic<LogLevel> level{LogLevel::Unknown};
+  std::atomic<bool> truncated{false};
+  std::atomic<uint8_t> sourceLen{0};
+  std::atomic<uint8_t> textLen{0};
+  std::atomic<uint64_t> words[kWords]{};  // source followed by text
+};
+
+bool LogFilter::matches(const LogEntry &entry) const noexcept {
+  if (entry.level != LogLevel::Unknown && entry.level < minLevel) return false;
+  if (!sourcePrefix.empty() && entry.source.compare(0, sourcePrefix.size(), sourcePrefix) != 0) {
+    return false;
+  }
+  if (!contains.empty() && entry.text.find(contains) == std::string::npos) return false;
+  return true;
+}
+
+LogStream::LogStream(size_t capacity) {
+  size_t n = 16;
+  while (n < capacity) n <<= 1;
+  slots_ = std::make_unique<Slot[]>(n);
+  mask_ = n - 1;
+}
+
+LogStream::~LogStream() = default;
+
+namespace {
+
+// Split "[LEVEL] source: text" (optionally after a timestamp) without copying
+void splitLine(std::string_view line, LogLevel &level, std::string_view &source,
+               std::string_view &text) noexcept {
+  static constexpr std::pair<std::string_view, LogLevel> levels[] = {
+      {"[NOISY]", LogLevel::Noisy},     {"[DEBUG]", LogLevel::Debug},
+      {"[INFO]", LogLevel::Info},       {"[WARNING]", LogLevel::Warning},
+      {"[ERROR]", LogLevel::Error},
+  };
+  level = LogLevel::Unknown;
+  source = {};
+  text = line;
+  for (const auto &[tag, lvl] : levels) {
+    size_t pos = line.find(tag);
+    if (pos != std::string_view::npos && pos < 32) {
+      level = lvl;
+      text = line.substr(pos + tag.size());
+      break;
+    }
+  }
+  while (!text.empty() && text.front() == ' ') text.remove_prefix(1);
+  if (level != LogLevel::Unknown) {
+    // "source: message" where source has no spaces
+    size_t colon = text.find(": ");
+    if (colon != std::string_view::npos &&
+        text.substr(0, colon).find(' ') == std::string_view::npos) {
+      source = text.substr(0, colon);
+      text.remove_prefix(colon + 2);
+    }
+  }
+}
+
+} // namespace
+
+LogEntry LogStream::parse(std::string_view line) {
+  LogEntry entry;
+  std::string_view source, text;
+  splitLine(line, entry.level, source, text);
+  entry.source.assign(source);
+  entry.text.assign(text);
+  return entry;
+}
+
+void LogStream::push(std::string_view line) noexcept {
+  LogLevel level;
+  std::string_view source, text;
+  splitLine(line, level, source, text);
+  uint64_t wallNs = Telemetry::nowNs();
+
+  uint64_t seq = head_.load(std::memory_order_relaxed);
+  Slot &slot = slots_[seq & mask_];
+  slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  size_t srcLen = std::min(source.size(), kMaxLineBytes / 2);
+  size_t txtLen = std::min(text.size(), kMaxLineBytes - srcLen);
+  char bytes[Slot::kWords * 8];
+  std::memcpy(bytes, source.data(), srcLen);
+  std::memcpy(bytes + srcLen, text.data(), txtLen);
+  for (size_t w = 0; w < (srcLen + txtLen + 7) / 8; ++w) {
+    uint64_t word;
+    std::memcpy(&word, bytes + 8 * w, sizeof(word));
+    slot.words[w].store(word, std::memory_order_relaxed);
+  }
+  bool truncated = srcLen < source.size() || txtLen < text.size();
+  slot.sourceLen.store(static_cast<uint8_t>(srcLen), std::memory_order_relaxed);
+  slot.textLen.store(static_cast<uint8_t>(txtLen), std::memory_order_relaxed);
+  slot.truncated.store(truncated, std::memory_order_relaxed);
+  slot.level.store(level, std::memory_order_relaxed);
+  slot.wallNs.store(wallNs, std::memory_order_relaxed);
+  if (truncated) truncated_.fetch_add(1, std::memory_order_relaxed);
+
+  slot.version.store(2 * seq + 2, std::memory_order_release);
+  head_.store(seq + 1, std::memory_order_release);
+
+  if (hasSubscribers_.load(std::memory_order_acquire)) {
+    try {
+      // Subscribers get the full line, not the slot's truncated copy
+      LogEntry entry;
+      entry.seq = seq;
+      entry.wallNs = wallNs;
+      entry.level = level;
+      entry.source.assign(source);
+      entry.text.assign(text);
+      std::shared_ptr<const std::vector<Subscription>> subscribers;
+      {
+        std::lock_guard<std::mutex> lock(subMtx_);
+        subscribers = subscribers_;
+      }
+      // Called without subMtx_ so a subscriber may (un)subscribe
+      for (const auto &sub : *subscribers) {
+        if (sub.filter.matches(entry)) sub.fn(entry);
+      }
+    } catch (...) {
+      // A throwing subscriber must not kill the output reader
+    }
+  }
+}
+
+bool LogStream::load(uint64_t seq, LogEntry &out) const noexcept {
+  const Slot &slot = slots_[seq & mask_];
+  uint64_t v1 = slot.version.load(std::memory_order_acquire);
+  if (v1 != 2 * seq + 2) return false;
+  // Copy the racy fields into locals first; they are validated below
+  char bytes[Slot::kWords * 8];
+  uint8_t srcLen = slot.sourceLen.load(std::memory_order_relaxed);
+  uint8_t txtLen = slot.textLen.load(std::memory_order_relaxed);
+  LogLevel level = slot.level.load(std::memory_order_relaxed);
+  bool truncated = slot.truncated.load(std::memory_order_relaxed);
+  uint64_t wallNs = slot.wallNs.load(std::memory_order_relaxed);
+  size_t used = std::min<size_t>(size_t(srcLen) + txtLen, kMaxLineBytes);
+  for (size_t w = 0; w < (used + 7) / 8; ++w) {
+    uint64_t word = slot.words[w].load(std::memory_order_relaxed);
+    std::memcpy(bytes + 8 * w, &word, sizeof(word));
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.version.load(std::memory_order_relaxed) != v1) return false;
+
+  out.seq = seq;
+  out.wallNs = wallNs;
+  out.level = level;
+  out.truncated = truncated;
+  out.source.assign(bytes, std::min<size_t>(srcLen, kMaxLineBytes));
+  out.text.assign(bytes + out.source.size(),
+                  std::min<size_t>(txtLen, kMaxLineBytes - out.source.size()));
+  return true;
+}
+
+std::vector<LogEntry> LogStream::read(Cursor &cursor, const LogFilter &filter,
+                                      size_t maxEntries) const {
+  std::vector<LogEntry> out;
+  uint64_t head = head_.load(std::memory_order_acquire);
+  LogEntry entry;
+  while (cursor.next < head && out.size() < maxEntries) {
+    // Anything older than one ring length is gone
+    uint64_t oldest = head > capacity() ? head - capacity() : 0;
+    if (cursor.next < oldest) {
+      cursor.dropped += oldest - cursor.next;
+      cursor.next = oldest;
+    }
+    if (!load(cursor.next, entry)) {
+      // Overwritten while we were reading: skip to the new oldest entry
+      head = head_.load(std::memory_order_acquire);
+      uint64_t newOldest = head > capacity() ? head - capacity() : 0;
+      uint64_t skipTo = std::max(newOldest, cursor.next + 1);
+      cursor.dropped += skipTo - cursor.next;
+      cursor.next = skipTo;
+      continue;
+    }
+    ++cursor.next;
+    if (filter.matches(entry)) out.push_back(entry);
+  }
+  return out;
+}
+
+LogStream::Cursor LogStream::oldest() const noexcept {
+  uint64_t head = head_.load(std::memory_order_acquire);
+  return {head > capacity() ? head - capacity() : 0, 0};
+}
+
+LogStream::Cursor LogStream::latest() const noexcept {
+  return {head_.load(std::memory_order_acquire), 0};
+}
+
+int LogStream::subscribe(LogFilter filter, Subscriber fn) {
+  std::lock_guard<std::mutex> lock(subMtx_);
+  int id = nextSubscriberId_++;
+  auto next = std::make_shared<std::vector<Subscription>>(*subscribers_);
+  next->push_back({id, std::move(filter), std::move(fn)});
+  subscribers_ = std::move(next);
+  hasSubscribers_.store(true, std::memory_order_release);
+  return id;
+}
+
+void LogStream::unsubscribe(int id) noexcept {
+  std::lock_guard<std::mutex> lock(subMtx_);
+  auto next = std::make_shared<std::vector<Subscription>>();
+  for (const auto &sub : *subscribers_) {
+    if (sub.id != id) next->push_back(sub);
+  }
+  hasSubscribers_.store(!next->empty(), std::memory_order_release);
+  subscribers_ = std::move(next);
+}
+
+LogStream::Stats LogStream::stats() const noexcept {
+  uint64_t produced = head_.load(std::memory_order_acquire);
+  return {produced, produced > capacity() ? produced - capacity() : 0,
+          truncated_.load(std::memory_order_relaxed)};
+}
+
+} // namespace renode
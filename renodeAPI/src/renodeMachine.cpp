@@ -1,9 +1,25 @@
 #include "renodeMachine.h"
+#include "renodePeripheralTree.h"
 #include "renodeInterface.h"
 #include "renodeInternal.h"
+#include "renodeTelemetry.h"
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <vector>
 
 namespace renode {
 
@@ -12,48 +28,282 @@ struct AMachine::Impl {
   std::string name;
   int32_t descriptor = -1;  // Server-side machine descriptor
   ExternalControlClient::Impl *renodeClient;
+  uint64_t generation = 0;  // Client generation the descriptor belongs to
+
+  // Cached virtual clock: refreshed by GET_TIME and advanced locally by
+  // RUN_FOR, so runUntil() can compute deltas without a round trip.
+  // Invalidated by anything that lets time move outside RUN_FOR.
+  uint64_t cachedTimeUs = 0;
+  bool clockValid = false;
+
+  std::map<std::string, std::string> metadata;
+
+  // UART path -> socket fd of the server-socket terminal tapping it
+  std::map<std::string, int> uartTaps;
+
+  // Parsed "peripherals" output; dropped when the platform may have changed
+  std::shared_ptr<const PeripheralTree> peripherals;
 
   Impl(const std::string &n, ExternalControlClient::Impl *c)
-      : name(n), renodeClient(c) {}
+      : name(n), renodeClient(c), generation(c ? c->generation : 0) {}
+
+  ~Impl() {
+    closeUartTaps();
+  }
+
+  void closeUartTaps() noexcept {
+    for (auto &kv : uartTaps) {
+      close(kv.second);
+    }
+    uartTaps.clear();
+  }
+
+  // Re-resolve the machine descriptor after the client generation changed
+  // (snapshot restore): server ids, virtual time and terminals are all stale.
+  Error sync() noexcept {
+    if (!renodeClient || generation == renodeClient->generation) return {0, ""};
+    clockValid = false;
+    closeUartTaps();
+    peripherals.reset();
+    try {
+      std::vector<uint8_t> payload;
+      write_string(payload, name);
+      auto reply = renodeClient->send_command(ApiCommand::GET_MACHINE, payload);
+      if (reply.size() != sizeof(int32_t)) {
+        return {3, "Unexpected reply size from GET_MACHINE"};
+      }
+      int32_t md = static_cast<int32_t>(read_u32_le(reply.data()));
+      if (md < 0) return {4, "Machine not found after restore: " + name};
+      descriptor = md;
+      generation = renodeClient->generation;
+      return {0, ""};
+    } catch (const std::exception &ex) {
+      return {2, std::string("Machine refresh failed: ") + ex.what()};
+    }
+  }
 
   // Accessor for peripheral classes to get machine descriptor
   int32_t getDescriptor() const noexcept { return descriptor; }
+
+  void advanceClock(uint64_t microseconds) noexcept {
+    if (clockValid) cachedTimeUs += microseconds;
+    if (clockValid && renodeClient && renodeClient->recorder) {
+      renodeClient->recorder->noteTime(name, cachedTimeUs);
+    }
+  }
+  void invalidateClock() noexcept { clockValid = false; }
+
+  // GET_TIME round trip; refreshes the cached clock
+  Result<uint64_t> queryTime() noexcept {
+    if (Error err = sync()) return {0, err};
+    try {
+      // GET_TIME expects an 8-byte payload (placeholder, value ignored by server)
+      std::vector<uint8_t> payload(8, 0);
+
+      uint64_t startNs = Telemetry::nowNs();
+      auto response = renodeClient->send_command(ApiCommand::GET_TIME, payload);
+      Telemetry::instance().record(TelemetryMetric::GetTimeWallNs, Telemetry::nowNs() - startNs);
+
+      if (response.size() != 8) {
+        return {0, {3, "Unexpected response size from GET_TIME"}};
+      }
+
+      // Parse 8-byte little-endian microseconds
+      cachedTimeUs = read_u64_le(response.data());
+      clockValid = true;
+      if (renodeClient->recorder) renodeClient->recorder->noteTime(name, cachedTimeUs);
+      return {cachedTimeUs, {0, ""}};
+
+    } catch (const std::exception &ex) {
+      return {0, {4, std::string("getTime failed: ") + ex.what()}};
+    }
+  }
+
+  // Virtual time in microseconds, from the cache when it is valid
+  Result<uint64_t> currentTimeUs() noexcept {
+    if (generation != renodeClient->generation) clockValid = false;
+    if (clockValid) return {cachedTimeUs, {0, ""}};
+    return queryTime();
+  }
 };
 
+// Re-register a peripheral path after a snapshot restore made instanceId
+// stale. No-op while the handle's generation is current.
+static Error refreshInstance(AMachine::Impl *machine, ApiCommand command,
+                             const std::string &path, int32_t &instanceId,
+                             uint64_t &generation) noexcept {
+  if (!machine || !machine->renodeClient) return {0, ""};
+  if (generation == machine->renodeClient->generation) return {0, ""};
+
+  if (Error err = machine->sync()) return err;
+  try {
+    // Same registration frame as getAdc/getGpio/getSysBus
+    std::vector<uint8_t> payload;
+    write_i32_le(payload, -1);
+    write_i32_le(payload, machine->descriptor);
+    write_string(payload, path);
+    auto response = machine->renodeClient->send_command(command, payload);
+    if (response.size() != sizeof(int32_t)) {
+      return {2, "Unexpected response size re-registering " + path};
+    }
+    int32_t id = static_cast<int32_t>(read_u32_le(response.data()));
+    if (id < 0) return {3, "Re-registration failed for " + path};
+    instanceId = id;
+    generation = machine->renodeClient->generation;
+    return {0, ""};
+  } catch (const std::exception &ex) {
+    return {4, "Re-registration failed for " + path + ": " + ex.what()};
+  }
+}
+
 // Peripheral Impl definitions
 struct Adc::Impl {
   std::string path;
   AMachine::Impl *machine;
   int32_t instanceId = -1;  // Server-assigned instance ID from registration
+  uint64_t generation = 0;  // Client generation instanceId belongs to
 
   Impl(const std::string &p, AMachine::Impl *m) : path(p), machine(m) {}
+
+  Error refresh() noexcept {
+    return refreshInstance(machine, ApiCommand::ADC, path, instanceId, generation);
+  }
 };
 
 struct Gpio::Impl {
   std::string path;
   AMachine::Impl *machine;
   int32_t instanceId = -1;  // Renode peripheral instance ID from registration
+  uint64_t generation = 0;  // Client generation instanceId belongs to
   int nextCbHandle = 1;
   std::map<int, GpioCallback> callbacks;
-  std::map<int, uint32_t> handleToServerEd;  // Maps local handle to server event descriptor
+
+  // One server-side event subscription per pin, shared by every callback on
+  // that pin. The protocol cannot cancel a subscription, so a tap stays
+  // registered for the Gpio's lifetime and later callbacks reuse it.
+  struct PinTap {
+    using Listeners = std::vector<std::pair<int, GpioEventCallback>>;
+    uint32_t serverEd = 0;
+    std::mutex mtx;
+    std::shared_ptr<const Listeners> listeners = std::make_shared<Listeners>();
+
+    void add(int handle, GpioEventCallback cb) {
+      std::lock_guard<std::mutex> lk(mtx);
+      auto next = std::make_shared<Listeners>(*listeners);
+      next->emplace_back(handle, std::move(cb));
+      listeners = std::move(next);
+    }
+    void remove(int handle) {
+      std::lock_guard<std::mutex> lk(mtx);
+      auto next = std::make_shared<Listeners>(*listeners);
+      std::erase_if(*next, [handle](const auto &l) { return l.first == handle; });
+      listeners = std::move(next);
+    }
+    // Called outside mtx so a listener may unregister itself
+    void dispatch(int pin, GpioState state, uint64_t timestampUs) {
+      std::shared_ptr<const Listeners> current;
+      {
+        std::lock_guard<std::mutex> lk(mtx);
+        current = listeners;
+      }
+      for (const auto &l : *current) l.second(pin, state, timestampUs);
+    }
+  };
+  std::map<int, std::shared_ptr<PinTap>> taps;  // pin -> subscription
+  std::map<int, int> handleToPin;               // Pin of each server-backed handle
+  // Eager re-registration after a supervised restart; weak so a Gpio
+  // outliving its client does not touch freed memory
+  std::weak_ptr<ExternalControlClient::Impl::Refreshers> refreshers;
+  uint64_t refresherId = 0;
+  // What the refresher reaches this Impl through. recover() runs copies of
+  // the refreshers, so removing ours does not stop one already under way;
+  // the destructor clears impl under mtx instead, waiting for it to finish.
+  struct Owner {
+    std::mutex mtx;
+    Impl *impl = nullptr;
+  };
+  std::shared_ptr<Owner> owner;
 
   Impl(const std::string &p, AMachine::Impl *m) : path(p), machine(m) {}
+
+  ~Impl() {
+    if (owner) {
+      std::lock_guard<std::mutex> lk(owner->mtx);
+      owner->impl = nullptr;
+    }
+    if (auto list = refreshers.lock()) list->remove(refresherId);
+    for (const auto &[pin, tap] : taps) EventCallbackRegistry::instance().unregisterCallback(tap->serverEd);
+  }
+
+  // Events arrive without the handle being used, so a supervised restart
+  // must re-subscribe right away instead of on next use. Only supervised
+  // clients restart, so nobody else pays for the registration.
+  void watchRestarts() {
+    ExternalControlClient::Impl *client = machine->renodeClient;
+    if (refresherId || !client->recover) return;
+    refreshers = client->refreshers;
+    owner = std::make_shared<Owner>();
+    owner->impl = this;
+    refresherId = client->refreshers->add([weak = std::weak_ptr<Owner>(owner)] {
+      auto held = weak.lock();
+      if (!held) return;
+      std::lock_guard<std::mutex> lk(held->mtx);
+      Impl *self = held->impl;
+      if (!self || self->taps.empty()) return;
+      if (Error err = self->refresh()) std::cerr << "GPIO " << self->path << ": " << err.message << "\n";
+    });
+  }
+
+  // Re-register after a restore, including server-side event subscriptions
+  // (the client-side EventCallbackRegistry entries stay valid)
+  Error refresh() noexcept {
+    uint64_t before = generation;
+    if (Error err = refreshInstance(machine, ApiCommand::GPIO, path, instanceId, generation)) {
+      return err;
+    }
+    if (generation == before) return {0, ""};
+    try {
+      for (const auto &[pin, tap] : taps) {
+        std::vector<uint8_t> payload;
+        write_i32_le(payload, instanceId);
+        payload.push_back(2);  // GPIO_REGISTER_EVENT
+        write_i32_le(payload, static_cast<int32_t>(pin));
+        write_u32_le(payload, tap->serverEd);
+        machine->renodeClient->send_command(ApiCommand::GPIO, payload);
+      }
+    } catch (const std::exception &ex) {
+      return {4, std::string("GPIO event re-registration failed: ") + ex.what()};
+    }
+    return {0, ""};
+  }
 };
 
 struct SysBus::Impl {
   std::string path;
   AMachine::Impl *machine;
   int32_t instanceId = -1;  // Server-assigned instance ID
+  uint64_t generation = 0;  // Client generation instanceId belongs to
 
   Impl(const std::string &p, AMachine::Impl *m) : path(p), machine(m) {}
+
+  Error refresh() noexcept {
+    return refreshInstance(machine, ApiCommand::SYSTEM_BUS, path, instanceId, generation);
+  }
 };
 
 struct BusContext::Impl {
   std::string nodePath;
+  std::string busPath;  // Path of the SysBus this context was created from
   AMachine::Impl *machine;
   int32_t instanceId = -1;  // Server-assigned bus context ID
+  uint64_t generation = 0;  // Client generation instanceId belongs to
 
   Impl(const std::string &n, AMachine::Impl *m) : nodePath(n), machine(m) {}
+
+  // Bus contexts share the SysBus instance id, so re-register the bus path
+  Error refresh() noexcept {
+    return refreshInstance(machine, ApiCommand::SYSTEM_BUS, busPath, instanceId, generation);
+  }
 };
 
 AMachine::AMachine(std::unique_ptr<Impl> impl) noexcept
@@ -74,32 +324,50 @@ std::string AMachine::name() const noexcept {
 }
 
 std::optional<std::string> AMachine::metadata(const std::string &key) const noexcept {
-  // TODO: Implement metadata storage and retrieval
-  return std::nullopt;
+  if (!pimpl_) return std::nullopt;
+  auto it = pimpl_->metadata.find(key);
+  if (it == pimpl_->metadata.end()) return std::nullopt;
+  return it->second;
 }
 
 Error AMachine::setMetadata(const std::string &key, const std::string &value) noexcept {
   if (!pimpl_) return {1, "Invalid machine"};
-  // TODO: Implement metadata storage
+  pimpl_->metadata[key] = value;
   return {0, ""};
 }
 
+std::string AMachine::loadCommand(const std::string &config) {
+  // Check if config looks like an ELF path or a .repl path
+  bool elf = config.find(".elf") != std::string::npos ||
+             config.find(".ELF") != std::string::npos;
+  return (elf ? "sysbus LoadELF @" : "machine LoadPlatformDescription @") + config;
+}
+
+// Same checks as a batch, including errors Renode only reports as text
 Error AMachine::loadConfiguration(const std::string &config) noexcept {
+  return loadConfiguration(std::vector<std::string>{config});
+}
+
+Error AMachine::loadConfiguration(const std::vector<std::string> &configs) noexcept {
   if (!pimpl_) return {1, "Invalid machine"};
   if (!pimpl_->renodeClient) return {2, "No client connection"};
 
-  // Use monitor to load platform description
   Monitor* monitor = pimpl_->renodeClient->monitor;
-  if (monitor) {
-    // Check if config looks like an ELF path or a .repl path
-    if (config.find(".elf") != std::string::npos ||
-        config.find(".ELF") != std::string::npos) {
-      return monitor->loadELF(config);
-    } else {
-      return monitor->loadPlatformDescription(config);
+  if (!monitor) return {3, "No monitor connection for loadConfiguration"};
+  pimpl_->invalidateClock();
+  pimpl_->peripherals.reset();
+
+  std::vector<std::string> commands;
+  commands.reserve(configs.size());
+  for (const auto &config : configs) commands.push_back(loadCommand(config));
+  auto results = monitor->executeBatch(commands);
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i].error) return results[i].error;
+    if (monitorReportedError(results[i].value)) {
+      return {4, "loadConfiguration " + configs[i] + ": " + results[i].value};
     }
   }
-  return {3, "No monitor connection for loadConfiguration"};
+  return {0, ""};
 }
 
 Error AMachine::reset() noexcept {
@@ -109,6 +377,7 @@ Error AMachine::reset() noexcept {
   // Use monitor if available
   Monitor* monitor = pimpl_->renodeClient->monitor;
   if (monitor) {
+    pimpl_->invalidateClock();
     return monitor->reset();
   }
   return {3, "No monitor connection for reset command"};
@@ -121,6 +390,7 @@ Error AMachine::pause() noexcept {
   // Use monitor if available
   Monitor* monitor = pimpl_->renodeClient->monitor;
   if (monitor) {
+    pimpl_->invalidateClock();
     return monitor->pause();
   }
   return {3, "No monitor connection for pause command"};
@@ -133,6 +403,7 @@ Error AMachine::resume() noexcept {
   // Use monitor if available
   Monitor* monitor = pimpl_->renodeClient->monitor;
   if (monitor) {
+    pimpl_->invalidateClock();
     return monitor->start();
   }
   return {3, "No monitor connection for resume command"};
@@ -157,62 +428,44 @@ Result<bool> AMachine::isRunning() const noexcept {
   return {true, {0, ""}};
 }
 
-Result<std::vector<PeripheralDescriptor>> AMachine::listPeripherals() noexcept {
-  if (!pimpl_) return {{}, {1, "Invalid machine"}};
-  if (!pimpl_->renodeClient) return {{}, {2, "No client connection"}};
+Result<std::shared_ptr<const PeripheralTree>> AMachine::peripheralTree(bool refresh) noexcept {
+  if (!pimpl_) return {nullptr, {1, "Invalid machine"}};
+  if (!pimpl_->renodeClient) return {nullptr, {2, "No client connection"}};
+  if (Error err = pimpl_->sync()) return {nullptr, err};
+  if (pimpl_->peripherals && !refresh) return {pimpl_->peripherals, {0, ""}};
 
-  // Use monitor to list peripherals
   Monitor* monitor = pimpl_->renodeClient->monitor;
   if (!monitor) {
-    return {{}, {3, "No monitor connection for listPeripherals"}};
-  }
-
-  auto result = monitor->execute("peripherals");
-  if (result.error) {
-    return {{}, result.error};
+    return {nullptr, {3, "No monitor connection for listPeripherals"}};
   }
 
-  // Parse output - format is typically:
-  // sysbus:
-  //   cpu (Cortex-M4)
-  //   uart0 (STM32_UART)
-  //   ...
-  std::vector<PeripheralDescriptor> peripherals;
-  std::istringstream stream(result.value);
-  std::string line;
-  std::string currentBus;
-
-  while (std::getline(stream, line)) {
-    // Skip empty lines
-    if (line.empty()) continue;
-
-    // Check for bus declaration (ends with ':')
-    if (!line.empty() && line.back() == ':') {
-      currentBus = line.substr(0, line.size() - 1);
-      continue;
-    }
-
-    // Parse peripheral line: "  name (Type)"
-    size_t start = line.find_first_not_of(" \t");
-    if (start == std::string::npos) continue;
-
-    size_t parenStart = line.find('(', start);
-    size_t parenEnd = line.find(')', parenStart);
+  // "peripherals" lists the currently selected machine; put the caller's
+  // selection back afterwards
+  std::string previous = monitor->selectedMachine();
+  std::vector<std::string> commands{"mach set \"" + pimpl_->name + "\"", "peripherals"};
+  if (previous != pimpl_->name)
+    commands.push_back(previous.empty() ? "mach clear" : "mach set \"" + previous + "\"");
+  auto result = monitor->executeBatch(commands);
+  if (result[0].error) return {nullptr, result[0].error};
+  if (result[1].error) return {nullptr, result[1].error};
 
-    if (parenStart != std::string::npos && parenEnd != std::string::npos) {
-      PeripheralDescriptor desc;
-      std::string name = line.substr(start, parenStart - start);
-      // Trim trailing spaces from name
-      while (!name.empty() && (name.back() == ' ' || name.back() == '\t')) {
-        name.pop_back();
-      }
-      desc.path = currentBus.empty() ? name : (currentBus + "." + name);
-      desc.type = line.substr(parenStart + 1, parenEnd - parenStart - 1);
-      peripherals.push_back(std::move(desc));
-    }
+  try {
+    pimpl_->peripherals =
+        std::make_shared<const PeripheralTree>(PeripheralTree::parse(result[1].value));
+  } catch (const std::exception &ex) {
+    return {nullptr, {4, std::string("Peripheral parse failed: ") + ex.what()}};
   }
+  return {pimpl_->peripherals, {0, ""}};
+}
 
-  return {peripherals, {0, ""}};
+Result<std::vector<PeripheralDescriptor>> AMachine::listPeripherals() noexcept {
+  auto tree = peripheralTree();
+  if (tree.error) return {{}, tree.error};
+  try {
+    return {tree.value->toDescriptors(), {0, ""}};
+  } catch (const std::exception &ex) {
+    return {{}, {4, ex.what()}};
+  }
 }
 
 Error AMachine::runFor(uint64_t duration, TimeUnit unit) noexcept {
@@ -222,15 +475,32 @@ Error AMachine::runFor(uint64_t duration, TimeUnit unit) noexcept {
   // Convert duration to microseconds
   uint64_t microseconds = duration * static_cast<uint64_t>(unit);
 
+  if (Error err = pimpl_->sync()) return err;
+
   // Build payload: 8-byte little-endian microseconds
   std::vector<uint8_t> payload;
   write_u64_le(payload, microseconds);
 
   try {
-    // Send RUN_FOR command
-    // Note: In the future, this should handle ASYNC_EVENT responses in a loop
-    // for GPIO callbacks during simulation run
+    uint64_t eventsBefore = pimpl_->renodeClient->eventsDispatched;
+    uint64_t startNs = Telemetry::nowNs();
+
+    // Send RUN_FOR command; ASYNC_EVENTs raised during the run are dispatched
+    // by recv_response before the final reply arrives
     pimpl_->renodeClient->send_command(ApiCommand::RUN_FOR, payload);
+
+    pimpl_->advanceClock(microseconds);
+
+    uint64_t wallNs = Telemetry::nowNs() - startNs;
+    Telemetry &telemetry = Telemetry::instance();
+    telemetry.record(TelemetryMetric::RunForWallNs, wallNs);
+    telemetry.record(TelemetryMetric::EventsPerTick,
+                     pimpl_->renodeClient->eventsDispatched - eventsBefore);
+    if (wallNs > 0) {
+      // virtual_ns * 1000 / wall_ns == real-time factor in permille
+      telemetry.record(TelemetryMetric::RealTimeFactorPermille,
+                       static_cast<uint64_t>(double(microseconds) * 1e6 / double(wallNs)));
+    }
     return {0, ""};
   } catch (const std::exception &ex) {
     return {3, std::string("runFor failed: ") + ex.what()};
@@ -246,40 +516,372 @@ std::future<Error> AMachine::asyncRunFor(uint64_t duration, TimeUnit unit) {
 
 Error AMachine::runUntil(uint64_t timestampMicroseconds) noexcept {
   if (!pimpl_) return {1, "Invalid machine"};
-  // TODO: Send RUN_UNTIL command to server
-  return {0, ""};
+  if (!pimpl_->renodeClient) return {2, "No client connection"};
+
+  auto current = pimpl_->currentTimeUs();
+  if (current.error) return current.error;
+
+  uint64_t now = current.value;
+  if (timestampMicroseconds < now) {
+    return {5, "runUntil: target time " + std::to_string(timestampMicroseconds) +
+                   " us is before current time " + std::to_string(now) + " us"};
+  }
+  if (timestampMicroseconds == now) return {0, ""};
+
+  return runFor(timestampMicroseconds - now, TimeUnit::TU_MICROSECONDS);
+}
+
+StopCondition StopCondition::onGpioEdge(std::shared_ptr<Gpio> gpio, int pin, GpioEdge edge) {
+  StopCondition c;
+  c.kind = Kind::GpioEdge;
+  c.gpio = std::move(gpio);
+  c.pin = pin;
+  c.edge = edge;
+  return c;
+}
+
+StopCondition StopCondition::onMemory(std::shared_ptr<BusContext> bus, uint64_t address,
+                                      AccessWidth width, std::optional<uint64_t> equals,
+                                      uint64_t mask) {
+  StopCondition c;
+  c.kind = Kind::MemoryWatch;
+  c.bus = std::move(bus);
+  c.address = address;
+  c.width = width;
+  c.equals = equals;
+  c.mask = mask;
+  return c;
+}
+
+StopCondition StopCondition::onUartPattern(const std::string &uartPath,
+                                           const std::string &pattern,
+                                           uint16_t terminalPort) {
+  StopCondition c;
+  c.kind = Kind::UartPattern;
+  c.uartPath = uartPath;
+  c.pattern = pattern;
+  c.terminalPort = terminalPort;
+  return c;
+}
+
+// Attach a server-socket terminal to a UART (once per path) and connect to it.
+// Returns the socket fd or -1 with err populated.
+static int openUartTap(AMachine::Impl &m, const std::string &uartPath, uint16_t port,
+                       Error &err) {
+  auto it = m.uartTaps.find(uartPath);
+  if (it != m.uartTaps.end()) return it->second;
+
+  Monitor *monitor = m.renodeClient->monitor;
+  if (!monitor) {
+    err = {3, "No monitor connection for UART stop condition"};
+    return -1;
+  }
+
+  std::string termName = "tap_" + uartPath;
+  std::replace(termName.begin(), termName.end(), '.', '_');
+
+  // emitConfigBytes=false: raw UART bytes, no telnet negotiation
+  auto created = monitor->execute("emulation CreateServerSocketTerminal " +
+                                  std::to_string(port) + " \"" + termName + "\" false");
+  if (created.error || monitorReportedError(created.value)) {
+    err = {6, "Failed to create UART terminal: " + created.error.message + created.value};
+    return -1;
+  }
+  auto connected = monitor->execute("connector Connect " + uartPath + " " + termName);
+  if (connected.error || monitorReportedError(connected.value)) {
+    err = {6, "Failed to connect UART terminal: " + connected.error.message + connected.value};
+    return -1;
+  }
+
+  struct addrinfo hints{};
+  struct addrinfo *res = nullptr;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_family = AF_UNSPEC;
+  int rc = getaddrinfo(m.renodeClient->host.c_str(), std::to_string(port).c_str(), &hints, &res);
+  if (rc != 0 || !res) {
+    err = {6, std::string("UART tap getaddrinfo: ") + gai_strerror(rc)};
+    return -1;
+  }
+  int fd = -1;
+  for (struct addrinfo *ai = res; ai != nullptr; ai = ai->ai_next) {
+    fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd < 0) continue;
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(res);
+  if (fd < 0) {
+    err = {6, "Unable to connect to UART terminal on port " + std::to_string(port)};
+    return -1;
+  }
+  m.uartTaps[uartPath] = fd;
+  return fd;
+}
+
+Result<StopInfo> AMachine::runUntil(const std::vector<StopCondition> &conditions,
+                                    uint64_t timeoutUs, uint64_t quantumUs) noexcept {
+  if (!pimpl_) return {{}, {1, "Invalid machine"}};
+  if (!pimpl_->renodeClient) return {{}, {2, "No client connection"}};
+  if (quantumUs == 0) {
+    // Edges are recorded as they happen, so polling them between quanta
+    // only adds round trips
+    bool eventDriven = std::all_of(conditions.begin(), conditions.end(), [](const StopCondition &c) {
+      return c.kind == StopCondition::Kind::GpioEdge;
+    });
+    quantumUs = eventDriven ? UINT64_MAX : kDefaultQuantumUs;
+  }
+
+  // Per-condition runtime state
+  struct Armed {
+    int gpioHandle = -1;
+    int uartFd = -1;
+    uint64_t lastValue = 0;
+    std::string uartWindow;  // tail kept across reads so patterns may span chunks
+  };
+  std::vector<Armed> armed(conditions.size());
+
+  // First GPIO edge observed during the current quantum
+  struct GpioHit {
+    bool fired = false;
+    size_t index = 0;
+    uint64_t timestampUs = 0;
+    GpioState state = GpioState::Low;
+  };
+  auto hit = std::make_shared<GpioHit>();
+
+  auto disarm = [&]() {
+    for (size_t i = 0; i < conditions.size(); ++i) {
+      if (armed[i].gpioHandle >= 0 && conditions[i].gpio) {
+        conditions[i].gpio->unregisterStateChangeCallback(armed[i].gpioHandle);
+      }
+    }
+  };
+
+  for (size_t i = 0; i < conditions.size(); ++i) {
+    const StopCondition &c = conditions[i];
+    Error err;
+    switch (c.kind) {
+    case StopCondition::Kind::GpioEdge: {
+      if (!c.gpio) { err = {5, "GPIO stop condition without a Gpio"}; break; }
+      GpioEdge edge = c.edge;
+      err = c.gpio->registerStateChangeCallback(
+          c.pin,
+          GpioEventCallback([hit, i, edge](int, GpioState state, uint64_t ts) {
+            if (hit->fired) return;
+            if (edge == GpioEdge::Rising && state != GpioState::High) return;
+            if (edge == GpioEdge::Falling && state != GpioState::Low) return;
+            *hit = {true, i, ts, state};
+          }),
+          armed[i].gpioHandle);
+      break;
+    }
+    case StopCondition::Kind::MemoryWatch:
+      if (!c.bus) { err = {5, "Memory stop condition without a BusContext"}; break; }
+      err = c.bus->read(c.address, c.width, armed[i].lastValue);
+      armed[i].lastValue &= c.mask;
+      break;
+    case StopCondition::Kind::UartPattern:
+      if (c.pattern.empty()) { err = {5, "UART stop condition with empty pattern"}; break; }
+      armed[i].uartFd = openUartTap(*pimpl_, c.uartPath, c.terminalPort, err);
+      if (armed[i].uartFd >= 0) {
+        // The tap outlives runUntil; output from before this call must not match
+        char buf[4096];
+        while (recv(armed[i].uartFd, buf, sizeof(buf), MSG_DONTWAIT) > 0) {}
+      }
+      break;
+    }
+    if (err) {
+      disarm();
+      return {{}, err};
+    }
+  }
+
+  auto now = pimpl_->currentTimeUs();
+  if (now.error) {
+    disarm();
+    return {{}, now.error};
+  }
+
+  StopInfo info;
+  uint64_t deadline = timeoutUs > UINT64_MAX - pimpl_->cachedTimeUs ? UINT64_MAX
+                                                                   : pimpl_->cachedTimeUs + timeoutUs;
+
+  while (pimpl_->cachedTimeUs < deadline) {
+    uint64_t step = std::min(quantumUs, deadline - pimpl_->cachedTimeUs);
+    Error err = runFor(step, TimeUnit::TU_MICROSECONDS);
+    if (err) {
+      disarm();
+      return {{}, err};
+    }
+
+    if (hit->fired) {
+      info = {true, hit->index, pimpl_->cachedTimeUs, hit->timestampUs,
+              static_cast<uint64_t>(hit->state)};
+      break;
+    }
+
+    bool met = false;
+    for (size_t i = 0; i < conditions.size() && !met; ++i) {
+      const StopCondition &c = conditions[i];
+      if (c.kind == StopCondition::Kind::MemoryWatch) {
+        uint64_t value = 0;
+        err = c.bus->read(c.address, c.width, value);
+        if (err) break;
+        value &= c.mask;
+        met = c.equals ? value == (*c.equals & c.mask) : value != armed[i].lastValue;
+        armed[i].lastValue = value;
+        if (met) info = {true, i, pimpl_->cachedTimeUs, pimpl_->cachedTimeUs, value};
+      } else if (c.kind == StopCondition::Kind::UartPattern) {
+        char buf[4096];
+        ssize_t n;
+        while ((n = recv(armed[i].uartFd, buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+          armed[i].uartWindow.append(buf, static_cast<size_t>(n));
+        }
+        if (armed[i].uartWindow.find(c.pattern) != std::string::npos) {
+          met = true;
+          info = {true, i, pimpl_->cachedTimeUs, pimpl_->cachedTimeUs, 0};
+        } else if (armed[i].uartWindow.size() >= c.pattern.size()) {
+          armed[i].uartWindow.erase(0, armed[i].uartWindow.size() - (c.pattern.size() - 1));
+        }
+      }
+    }
+    if (err) {
+      disarm();
+      return {{}, err};
+    }
+    if (met) break;
+  }
+
+  disarm();
+  if (!info.conditionMet) {
+    info.stopTimeUs = pimpl_->cachedTimeUs;
+    info.triggerTimeUs = pimpl_->cachedTimeUs;
+  }
+  return {info, {0, ""}};
 }
 
 Error AMachine::stepInstructions(uint64_t count) noexcept {
   if (!pimpl_) return {1, "Invalid machine"};
-  // TODO: Send STEP command to server
-  return {0, ""};
+  if (!pimpl_->renodeClient) return {2, "No client connection"};
+  if (count == 0) return {0, ""};
+
+  Monitor* monitor = pimpl_->renodeClient->monitor;
+  if (!monitor) {
+    return {3, "No monitor connection for stepInstructions"};
+  }
+
+  auto cpuIt = pimpl_->metadata.find("cpu");
+  std::string cpu = cpuIt != pimpl_->metadata.end() ? cpuIt->second : "sysbus.cpu";
+
+  // Stepping moves virtual time outside RUN_FOR
+  pimpl_->invalidateClock();
+
+  // Step requires the CPU in blocking single-step mode; restore continuous
+  // execution afterwards so RUN_FOR keeps working. The three commands are
+  // pipelined: if the mode switch fails, Step fails too and the restore is
+  // harmless.
+  auto results = monitor->executeBatch({cpu + " ExecutionMode SingleStepBlocking",
+                                        cpu + " Step " + std::to_string(count),
+                                        cpu + " ExecutionMode Continuous"});
+  const auto &mode = results[0];
+  const auto &step = results[1];
+  if (mode.error) return mode.error;
+  if (monitorReportedError(mode.value)) {
+    return {4, "stepInstructions: cannot enter single-step mode: " + mode.value};
+  }
+  if (step.error) return step.error;
+  if (monitorReportedError(step.value)) {
+    return {5, "stepInstructions: " + step.value};
+  }
+  return results[2].error;
 }
 
 Result<uint64_t> AMachine::getTime(TimeUnit unit) const noexcept {
   if (!pimpl_) return {0, {1, "Invalid machine"}};
   if (!pimpl_->renodeClient) return {0, {2, "No client connection"}};
 
-  try {
-    // GET_TIME expects an 8-byte payload (placeholder, value ignored by server)
-    std::vector<uint8_t> payload(8, 0);
+  auto now = pimpl_->queryTime();
+  if (now.error) return now;
 
-    auto response = pimpl_->renodeClient->send_command(ApiCommand::GET_TIME, payload);
+  // Convert to requested unit
+  uint64_t divider = static_cast<uint64_t>(unit);
+  return {now.value / divider, {0, ""}};
+}
 
-    if (response.size() != 8) {
-      return {0, {3, "Unexpected response size from GET_TIME"}};
-    }
+// Temporary snapshot file, on tmpfs when available so capture/restore of
+// in-memory snapshots never touches disk
+static std::string makeSnapshotTempPath() {
+  const char *dir = access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp";
+  std::string tmpl = std::string(dir) + "/renode-snapshot-XXXXXX.save";
+  std::vector<char> buf(tmpl.begin(), tmpl.end());
+  buf.push_back('\0');
+  int fd = mkstemps(buf.data(), 5);
+  if (fd < 0) return {};
+  close(fd);
+  return std::string(buf.data());
+}
 
-    // Parse 8-byte little-endian microseconds
-    uint64_t time_us = read_u64_le(response.data());
+Error AMachine::saveSnapshot(const std::string &path) noexcept {
+  if (!pimpl_) return {1, "Invalid machine"};
+  if (!pimpl_->renodeClient) return {2, "No client connection"};
+  Monitor* monitor = pimpl_->renodeClient->monitor;
+  if (!monitor) return {3, "No monitor connection for saveSnapshot"};
+  return monitor->saveSnapshot(path);
+}
 
-    // Convert to requested unit
-    uint64_t divider = static_cast<uint64_t>(unit);
-    return {time_us / divider, {0, ""}};
+Error AMachine::restoreSnapshot(const std::string &path) noexcept {
+  if (!pimpl_) return {1, "Invalid machine"};
+  if (!pimpl_->renodeClient) return {2, "No client connection"};
+  Monitor* monitor = pimpl_->renodeClient->monitor;
+  if (!monitor) return {3, "No monitor connection for restoreSnapshot"};
 
-  } catch (const std::exception &ex) {
-    return {0, {4, std::string("getTime failed: ") + ex.what()}};
+  Error err = monitor->loadSnapshot(path);
+  if (err) return err;
+
+  // Everything the server handed out before Load is gone
+  ++pimpl_->renodeClient->generation;
+
+  // Load replaces the emulation; re-select this machine for later commands
+  auto sel = monitor->execute("mach set \"" + pimpl_->name + "\"");
+  if (sel.error) return sel.error;
+  if (monitorReportedError(sel.value)) return {4, "restoreSnapshot: " + sel.value};
+
+  return pimpl_->sync();
+}
+
+Result<EmulationSnapshot> AMachine::captureSnapshot() noexcept {
+  std::string tmp = makeSnapshotTempPath();
+  if (tmp.empty()) return {{}, {5, "Cannot create snapshot temp file"}};
+
+  Error err = saveSnapshot(tmp);
+  EmulationSnapshot snapshot;
+  if (!err) {
+    std::ifstream in(tmp, std::ios::binary);
+    snapshot.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (snapshot.data.empty()) err = {5, "Snapshot file is empty"};
   }
+  std::remove(tmp.c_str());
+  return {std::move(snapshot), err};
+}
+
+Error AMachine::restoreSnapshot(const EmulationSnapshot &snapshot) noexcept {
+  if (!snapshot) return {5, "Empty snapshot"};
+  std::string tmp = makeSnapshotTempPath();
+  if (tmp.empty()) return {5, "Cannot create snapshot temp file"};
+
+  {
+    std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(snapshot.data.data()),
+              static_cast<std::streamsize>(snapshot.data.size()));
+    if (!out) {
+      std::remove(tmp.c_str());
+      return {5, "Cannot write snapshot temp file"};
+    }
+  }
+  Error err = restoreSnapshot(tmp);
+  std::remove(tmp.c_str());
+  return err;
 }
 
 AMachine::operator bool() const noexcept {
@@ -291,6 +893,10 @@ std::shared_ptr<Adc> AMachine::getAdc(const std::string &path, Error &err) noexc
     err = {1, "Invalid machine"};
     return nullptr;
   }
+  if (Error syncErr = pimpl_->sync()) {
+    err = syncErr;
+    return nullptr;
+  }
 
   // Register the ADC peripheral with Renode to get an instance ID
   // Protocol (from renode_get_instance_descriptor):
@@ -328,6 +934,7 @@ std::shared_ptr<Adc> AMachine::getAdc(const std::string &path, Error &err) noexc
 
     auto impl = std::make_unique<Adc::Impl>(path, pimpl_.get());
     impl->instanceId = instanceId;
+    impl->generation = pimpl_->generation;
     err = {0, ""};
     return std::shared_ptr<Adc>(new Adc(std::move(impl)));
 
@@ -342,6 +949,10 @@ std::shared_ptr<Gpio> AMachine::getGpio(const std::string &path, Error &err) noe
     err = {1, "Invalid machine"};
     return nullptr;
   }
+  if (Error syncErr = pimpl_->sync()) {
+    err = syncErr;
+    return nullptr;
+  }
 
   // Register the GPIO peripheral with Renode to get an instance ID
   // Protocol (from renode_get_instance_descriptor):
@@ -384,6 +995,7 @@ std::shared_ptr<Gpio> AMachine::getGpio(const std::string &path, Error &err) noe
 
     auto impl = std::make_unique<Gpio::Impl>(path, pimpl_.get());
     impl->instanceId = instanceId;
+    impl->generation = pimpl_->generation;
     err = {0, ""};
     return std::shared_ptr<Gpio>(new Gpio(std::move(impl)));
 
@@ -398,6 +1010,10 @@ std::shared_ptr<SysBus> AMachine::getSysBus(const std::string &path, Error &err)
     err = {1, "Invalid machine"};
     return nullptr;
   }
+  if (Error syncErr = pimpl_->sync()) {
+    err = syncErr;
+    return nullptr;
+  }
 
   // Register the SysBus peripheral with Renode to get an instance ID
   // Protocol (same as ADC/GPIO registration):
@@ -435,6 +1051,7 @@ std::shared_ptr<SysBus> AMachine::getSysBus(const std::string &path, Error &err)
 
     auto impl = std::make_unique<SysBus::Impl>(path, pimpl_.get());
     impl->instanceId = instanceId;
+    impl->generation = pimpl_->generation;
     err = {0, ""};
     return std::shared_ptr<SysBus>(new SysBus(std::move(impl)));
 
@@ -493,6 +1110,8 @@ std::shared_ptr<AMachine> ExternalControlClient::getMachine(const std::string &n
 
   // If already have a weak_ptr cached, return it
   if (auto existing = pimpl_->machines[name].lock()) {
+    existing->pimpl_->descriptor = descriptor;
+    existing->pimpl_->generation = pimpl_->generation;
     err = {0, ""};
     return existing;
   }
@@ -506,6 +1125,109 @@ std::shared_ptr<AMachine> ExternalControlClient::getMachine(const std::string &n
   return inst;
 }
 
+std::shared_ptr<AMachine>
+ExternalControlClient::createMachine(const std::string &name,
+                                     const std::vector<std::string> &setupCommands,
+                                     Error &err) noexcept {
+  if (!monitor_) {
+    err = {3, "No monitor connection for createMachine"};
+    return nullptr;
+  }
+  // "mach create" selects the new machine, so the setup commands apply to it
+  std::vector<std::string> commands;
+  commands.reserve(setupCommands.size() + 1);
+  commands.push_back("mach create \"" + name + "\"");
+  commands.insert(commands.end(), setupCommands.begin(), setupCommands.end());
+  auto results = monitor_->executeBatch(commands);
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i].error) {
+      err = results[i].error;
+      return nullptr;
+    }
+    if (monitorReportedError(results[i].value)) {
+      err = {5, "createMachine: '" + commands[i] + "' failed: " + results[i].value};
+      return nullptr;
+    }
+  }
+  return getMachine(name, err);
+}
+
+Error ExternalControlClient::removeMachine(const std::string &name) noexcept {
+  if (!monitor_) return {3, "No monitor connection for removeMachine"};
+  auto results = monitor_->executeBatch({"mach rem \"" + name + "\"", "mach clear"});
+  if (results[0].error) return results[0].error;
+
+  {
+    // Handles of the removed machine must not be reused; other machines'
+    // handles re-resolve lazily through the generation check
+    std::lock_guard<std::mutex> lk(pimpl_->mtx);
+    pimpl_->machines.erase(name);
+    ++pimpl_->generation;
+  }
+
+  // Verify teardown on the control connection: the name must be gone
+  Error lookup;
+  if (getMachine(name, lookup)) {
+    std::lock_guard<std::mutex> lk(pimpl_->mtx);
+    pimpl_->machines.erase(name);
+    return {6, "removeMachine: '" + name + "' still exists after mach rem: " + results[0].value};
+  }
+  if (lookup.code != 4) return lookup;  // transport failure, not "not found"
+  return {0, ""};
+}
+
+std::optional<uint64_t> ExternalControlClient::getCurrentTimeMicroseconds(Error &err) noexcept {
+  try {
+    // Same 8-byte placeholder payload as AMachine::getTime; the emulation has one clock
+    uint64_t startNs = Telemetry::nowNs();
+    auto response = send_command(ApiCommand::GET_TIME, std::vector<uint8_t>(8, 0));
+    Telemetry::instance().record(TelemetryMetric::GetTimeWallNs, Telemetry::nowNs() - startNs);
+    if (response.size() != 8) {
+      err = {3, "Unexpected response size from GET_TIME"};
+      return std::nullopt;
+    }
+    err = {0, ""};
+    return read_u64_le(response.data());
+  } catch (const std::exception &ex) {
+    err = {4, std::string("getTime failed: ") + ex.what()};
+    return std::nullopt;
+  }
+}
+
+Result<std::vector<std::string>> ExternalControlClient::listMachines() noexcept {
+  if (!monitor_) return {{}, {3, "No monitor connection for listMachines"}};
+  auto result = monitor_->execute("mach");
+  if (result.error) return {{}, result.error};
+
+  // Usage text, then "Available machines:" and one "\t0: name [platform]"
+  // line per machine
+  try {
+    std::vector<std::string> names;
+    size_t listStart = result.value.find("Available machines:");
+    std::istringstream in(listStart == std::string::npos ? std::string{} : result.value.substr(listStart));
+    std::string line;
+    while (std::getline(in, line)) {
+      size_t first = line.find_first_not_of(" \t");
+      size_t colon = line.find(':', first);
+      if (first == std::string::npos || colon == std::string::npos || colon == first) continue;
+      if (line.find_first_not_of("0123456789", first) != colon) continue;
+      std::string name = line.substr(colon + 1);
+      if (!name.empty() && name.back() == '\r') name.pop_back();
+      if (!name.empty() && name.back() == ']') {
+        size_t open = name.rfind('[');
+        if (open != std::string::npos) name.erase(open);
+      }
+      size_t begin = name.find_first_not_of(" \t");
+      size_t end = name.find_last_not_of(" \t");
+      if (begin == std::string::npos) continue;
+      names.push_back(name.substr(begin, end - begin + 1));
+    }
+    return {std::move(names), {0, ""}};
+  } catch (const std::exception &e) {
+    return {{}, {5, std::string("listMachines failed: ") + e.what()}};
+  }
+}
+
 std::shared_ptr<AMachine>
 ExternalControlClient::getMachineOrThrow(const std::string &name) {
   Error e;
@@ -534,6 +1256,7 @@ Error Adc::getChannelCount(int &outCount) noexcept {
   if (!pimpl_) return {1, "Invalid ADC"};
   if (pimpl_->instanceId < 0) return {2, "ADC not registered"};
   if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     std::vector<uint8_t> payload;
@@ -562,6 +1285,7 @@ Error Adc::getChannelValue(int channel, AdcValue &outValue) noexcept {
   if (!pimpl_) return {1, "Invalid ADC"};
   if (pimpl_->instanceId < 0) return {2, "ADC not registered"};
   if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     std::vector<uint8_t> payload;
@@ -595,6 +1319,7 @@ Error Adc::setChannelValue(int channel, AdcValue value) noexcept {
   if (!pimpl_) return {1, "Invalid ADC"};
   if (pimpl_->instanceId < 0) return {2, "ADC not registered"};
   if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     std::vector<uint8_t> payload;
@@ -614,6 +1339,12 @@ Error Adc::setChannelValue(int channel, AdcValue value) noexcept {
 
     // Expect SUCCESS_WITHOUT_DATA (empty response)
     pimpl_->machine->renodeClient->send_command(ApiCommand::ADC, payload);
+
+    if (auto &recorder = pimpl_->machine->renodeClient->recorder) {
+      // Without a time the stimulus cannot be placed; leave it out
+      auto now = pimpl_->machine->currentTimeUs();
+      if (!now.error) recorder->recordAdc(pimpl_->machine->name, pimpl_->path, channel, value, now.value);
+    }
     return {0, ""};
 
   } catch (const std::exception &ex) {
@@ -637,6 +1368,7 @@ Error Gpio::getState(int pin, GpioState &outState) noexcept {
   if (!pimpl_) return {1, "Invalid GPIO"};
   if (!pimpl_->machine) return {2, "Invalid machine reference"};
   if (pimpl_->instanceId < 0) return {2, "GPIO not registered"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     // Build payload per Renode protocol:
@@ -681,6 +1413,7 @@ Error Gpio::setState(int pin, GpioState state) noexcept {
   if (!pimpl_) return {1, "Invalid GPIO"};
   if (!pimpl_->machine) return {2, "Invalid machine reference"};
   if (pimpl_->instanceId < 0) return {2, "GPIO not registered"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     // Build payload per Renode protocol:
@@ -706,6 +1439,11 @@ Error Gpio::setState(int pin, GpioState state) noexcept {
     // Send command (expect SUCCESS_WITHOUT_DATA, empty response)
     pimpl_->machine->renodeClient->send_command(ApiCommand::GPIO, payload);
 
+    if (auto &recorder = pimpl_->machine->renodeClient->recorder) {
+      auto now = pimpl_->machine->currentTimeUs();
+      if (!now.error) recorder->recordGpio(pimpl_->machine->name, pimpl_->path, pin, state, now.value);
+    }
+
     // Trigger callbacks for state change (only after successful server update)
     for (auto &kv : pimpl_->callbacks) {
       kv.second(pin, state);
@@ -727,50 +1465,57 @@ enum GpioSubcommand : int8_t {
 };
 
 Error Gpio::registerStateChangeCallback(int pin, GpioCallback cb, int &outHandle) noexcept {
+  return registerStateChangeCallback(
+      pin,
+      GpioEventCallback([cb = std::move(cb)](int p, GpioState state, uint64_t) { cb(p, state); }),
+      outHandle);
+}
+
+Error Gpio::registerStateChangeCallback(int pin, GpioEventCallback cb, int &outHandle) noexcept {
   if (!pimpl_) return {1, "Invalid GPIO"};
   if (pimpl_->instanceId < 0) return {2, "GPIO not registered"};
   if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
-    // Allocate local handle first
-    int handle = pimpl_->nextCbHandle++;
-
-    // Create wrapper callback that converts server event data to GpioCallback format
-    // Server sends: timestamp_us (8B) + state (1B)
-    auto wrapperCb = [cb, pin](const uint8_t* data, size_t size) {
-      if (size >= 9) {  // 8 bytes timestamp + 1 byte state
-        // uint64_t timestamp_us = read_u64_le(data);  // Available if needed
-        uint8_t state_byte = data[8];
-        GpioState state = (state_byte != 0) ? GpioState::High : GpioState::Low;
-        cb(pin, state);
+    auto &tap = pimpl_->taps[pin];
+    if (!tap) {
+      auto fresh = std::make_shared<Impl::PinTap>();
+      // Server sends: timestamp_us (8B) + state (1B)
+      fresh->serverEd = EventCallbackRegistry::instance().registerCallback(
+          [fresh, pin](const uint8_t *data, size_t size) {
+            if (size < 9) return;
+            GpioState state = data[8] != 0 ? GpioState::High : GpioState::Low;
+            fresh->dispatch(pin, state, read_u64_le(data));
+          });
+
+      // REGISTER_EVENT frame (C reference event_gpio_frame):
+      // id (4B) + command (1B) + number (4B) + ed (4B)
+      std::vector<uint8_t> payload;
+      write_i32_le(payload, pimpl_->instanceId);
+      payload.push_back(GPIO_REGISTER_EVENT);
+      write_i32_le(payload, static_cast<int32_t>(pin));
+      write_u32_le(payload, fresh->serverEd);
+      try {
+        pimpl_->machine->renodeClient->send_command(ApiCommand::GPIO, payload);
+      } catch (...) {
+        EventCallbackRegistry::instance().unregisterCallback(fresh->serverEd);
+        pimpl_->taps.erase(pin);
+        throw;
       }
-    };
-
-    // Register with global event callback registry to get server event descriptor
-    uint32_t serverEd = EventCallbackRegistry::instance().registerCallback(wrapperCb);
-
-    // Build payload for REGISTER_EVENT command (from C reference event_gpio_frame)
-    // id (4B) + command (1B) + number (4B) + ed (4B)
-    std::vector<uint8_t> payload;
-
-    // Instance ID (4 bytes LE)
-    write_i32_le(payload, pimpl_->instanceId);
-
-    // Subcommand: REGISTER_EVENT = 2
-    payload.push_back(GPIO_REGISTER_EVENT);
-
-    // Pin number (4 bytes LE)
-    write_i32_le(payload, static_cast<int32_t>(pin));
-
-    // Server event descriptor (4 bytes LE)
-    write_u32_le(payload, serverEd);
-
-    // Send command to register with Renode server
-    pimpl_->machine->renodeClient->send_command(ApiCommand::GPIO, payload);
+      tap = std::move(fresh);
+      pimpl_->watchRestarts();
+    }
 
-    // Store mappings
-    pimpl_->callbacks.emplace(handle, std::move(cb));
-    pimpl_->handleToServerEd[handle] = serverEd;
+    int handle = pimpl_->nextCbHandle++;
+    tap->add(handle, cb);
+
+    // Store mappings; local setState() notifications use the cached clock
+    AMachine::Impl *machine = pimpl_->machine;
+    pimpl_->callbacks.emplace(handle, [cb = std::move(cb), machine](int p, GpioState state) {
+      cb(p, state, machine->clockValid ? machine->cachedTimeUs : 0);
+    });
+    pimpl_->handleToPin[handle] = pin;
     outHandle = handle;
 
     return {0, ""};
@@ -794,11 +1539,11 @@ Error Gpio::registerStateChangeCallback(GpioCallback cb, int &outHandle) noexcep
 Error Gpio::unregisterStateChangeCallback(int handle) noexcept {
   if (!pimpl_) return {1, "Invalid GPIO"};
 
-  // If this callback was registered with server, unregister from EventCallbackRegistry
-  auto edIt = pimpl_->handleToServerEd.find(handle);
-  if (edIt != pimpl_->handleToServerEd.end()) {
-    EventCallbackRegistry::instance().unregisterCallback(edIt->second);
-    pimpl_->handleToServerEd.erase(edIt);
+  // The pin's server subscription stays; only this listener goes
+  auto pinIt = pimpl_->handleToPin.find(handle);
+  if (pinIt != pimpl_->handleToPin.end()) {
+    pimpl_->taps.at(pinIt->second)->remove(handle);
+    pimpl_->handleToPin.erase(pinIt);
   }
 
   pimpl_->callbacks.erase(handle);
@@ -830,6 +1575,8 @@ std::shared_ptr<BusContext> SysBus::getBusContext(const std::string &nodePath, E
 
   auto impl = std::make_unique<BusContext::Impl>(nodePath, pimpl_->machine);
   impl->instanceId = pimpl_->instanceId;  // Pass SysBus instance ID to BusContext
+  impl->busPath = pimpl_->path;
+  impl->generation = pimpl_->generation;
   err = {0, ""};
   return std::shared_ptr<BusContext>(new BusContext(std::move(impl)));
 }
@@ -856,6 +1603,7 @@ Error BusContext::read(uint64_t address, AccessWidth width, uint64_t &outValue)
   if (!pimpl_) return {1, "Invalid BusContext"};
   if (pimpl_->instanceId < 0) return {2, "BusContext not initialized"};
   if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     // Build payload per C reference (sysbus_command_t):
@@ -907,10 +1655,45 @@ Error BusContext::read(uint64_t address, AccessWidth width, uint64_t &outValue)
   }
 }
 
+Error BusContext::readBlock(uint64_t address, size_t size, std::vector<uint8_t> &out) noexcept {
+  if (!pimpl_) return {1, "Invalid BusContext"};
+  if (pimpl_->instanceId < 0) return {2, "BusContext not initialized"};
+  if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
+
+  constexpr size_t kMaxTransfer = 64 * 1024;
+  try {
+    out.clear();
+    out.reserve(size);
+    while (out.size() < size) {
+      uint32_t count = static_cast<uint32_t>(std::min(size - out.size(), kMaxTransfer));
+      // Same frame as read(), with a multi-byte width: count is in bytes
+      std::vector<uint8_t> payload;
+      write_i32_le(payload, pimpl_->instanceId);
+      payload.push_back(SYSBUS_READ);
+      payload.push_back(static_cast<uint8_t>(AccessWidth::AW_MULTI_BYTE));
+      write_u64_le(payload, address + out.size());
+      write_u32_le(payload, count);
+
+      auto response = pimpl_->machine->renodeClient->send_command(ApiCommand::SYSTEM_BUS, payload);
+      if (response.size() != count) {
+        return {4, "Unexpected response size from SysBus block read: " +
+                       std::to_string(response.size()) + " of " + std::to_string(count)};
+      }
+      out.insert(out.end(), response.begin(), response.end());
+    }
+    return {0, ""};
+
+  } catch (const std::exception &ex) {
+    return {5, std::string("BusContext block read failed: ") + ex.what()};
+  }
+}
+
 Error BusContext::write(uint64_t address, AccessWidth width, uint64_t value) noexcept {
   if (!pimpl_) return {1, "Invalid BusContext"};
   if (pimpl_->instanceId < 0) return {2, "BusContext not initialized"};
   if (!pimpl_->machine) return {3, "Invalid machine reference"};
+  if (Error err = pimpl_->refresh()) return err;
 
   try {
     // Build payload per C reference (sysbus_command_t):
@@ -950,6 +1733,14 @@ Error BusContext::write(uint64_t address, AccessWidth width, uint64_t value) noe
 
     // Expect SUCCESS_WITHOUT_DATA (empty response)
     pimpl_->machine->renodeClient->send_command(ApiCommand::SYSTEM_BUS, payload);
+
+    if (auto &recorder = pimpl_->machine->renodeClient->recorder) {
+      auto now = pimpl_->machine->currentTimeUs();
+      if (!now.error) {
+        recorder->recordBusWrite(pimpl_->machine->name, pimpl_->busPath, pimpl_->nodePath,
+                                 address, width, value, now.value);
+      }
+    }
     return {0, ""};
 
   } catch (const std::exception &ex) {
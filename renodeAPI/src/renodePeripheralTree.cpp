@@ -0,0 +1,211 @@
+// renodePeripheralTree.cpp
+#include "renodePeripheralTree.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace renode {
+
+namespace {
+
+// Tree-drawing glyphs Renode prefixes peripheral lines with
+bool isTreeGlyph(std::string_view s, size_t pos, size_t &len) {
+  static constexpr std::string_view glyphs[] = {"│", "├", "└", "─"};
+  for (auto g : glyphs) {
+    if (s.compare(pos, g.size(), g) == 0) {
+      len = g.size();
+      return true;
+    }
+  }
+  return false;
+}
+
+// Skip indentation and glyphs; returns the content and its display column
+std::string_view stripPrefix(std::string_view line, size_t &column) {
+  size_t pos = 0;
+  column = 0;
+  while (pos < line.size()) {
+    size_t len = 1;
+    if (line[pos] == ' ' || line[pos] == '\t' || isTreeGlyph(line, pos, len)) {
+      pos += len;
+      ++column;
+    } else {
+      break;
+    }
+  }
+  std::string_view rest = line.substr(pos);
+  while (!rest.empty() && (rest.back() == ' ' || rest.back() == '\r')) rest.remove_suffix(1);
+  return rest;
+}
+
+bool parseRange(std::string_view s, uint64_t &start, uint64_t &end) {
+  // "<0x40020000, 0x400203FF>"
+  if (s.size() < 5 || s.front() != '<' || s.back() != '>') return false;
+  std::string inner(s.substr(1, s.size() - 2));
+  char *next = nullptr;
+  start = std::strtoull(inner.c_str(), &next, 0);
+  if (next == inner.c_str() || *next != ',') return false;
+  const char *second = next + 1;
+  end = std::strtoull(second, &next, 0);
+  return next != second && end >= start;
+}
+
+} // namespace
+
+uint32_t PeripheralTree::intern(std::string_view s,
+                                std::unordered_map<std::string, uint32_t> &ids) {
+  auto [it, inserted] = ids.try_emplace(std::string(s), static_cast<uint32_t>(strings_.size()));
+  if (inserted) {
+    strings_.push_back({static_cast<uint32_t>(arena_.size()), static_cast<uint32_t>(s.size())});
+    arena_.append(s);
+  }
+  return it->second;
+}
+
+PeripheralTree PeripheralTree::parse(std::string_view output) {
+  PeripheralTree tree;
+  std::unordered_map<std::string, uint32_t> ids;
+  std::vector<std::pair<size_t, NodeId>> stack;  // (column, node) of open ancestors
+  std::vector<NodeId> lastChild;                 // per node, for sibling links
+  NodeId lastRoot = kNone;
+  NodeId current = kNone;
+
+  while (!output.empty()) {
+    size_t eol = output.find('\n');
+    std::string_view line = output.substr(0, eol);
+    output = eol == std::string_view::npos ? std::string_view{} : output.substr(eol + 1);
+
+    size_t column;
+    std::string_view content = stripPrefix(line, column);
+    if (content.empty()) continue;
+
+    uint64_t start, end;
+    if (content.front() == '<') {
+      if (current != kNone && parseRange(content, start, end)) {
+        tree.byAddress_.push_back({start, end, current});
+      }
+      continue;
+    }
+
+    bool header = content.back() == ':';
+    size_t open = content.rfind(" (");
+    if (!header && (open == std::string_view::npos || content.back() != ')')) {
+      continue;  // "Slot: 0" and other detail lines
+    }
+    if (header && content.find(' ') != std::string_view::npos) {
+      continue;  // "Available peripherals:"
+    }
+
+    std::string_view name = header ? content.substr(0, content.size() - 1)
+                                   : content.substr(0, open);
+    std::string_view type = header ? std::string_view{}
+                                   : content.substr(open + 2, content.size() - open - 3);
+    // Flat-format bus headers are parents of everything indented below them
+    if (header) column = 0;
+
+    while (!stack.empty() && stack.back().first >= column) stack.pop_back();
+    NodeId parent = stack.empty() ? kNone : stack.back().second;
+
+    auto id = static_cast<NodeId>(tree.nodes_.size());
+    Node node;
+    node.name = tree.intern(name, ids);
+    node.type = tree.intern(type, ids);
+    node.parent = parent;
+    if (parent == kNone) {
+      node.path = node.name;
+    } else {
+      std::string path(tree.path(parent));
+      path += '.';
+      path += name;
+      node.path = tree.intern(path, ids);
+    }
+    tree.nodes_.push_back(node);
+    lastChild.push_back(kNone);
+
+    NodeId &prev = parent == kNone ? lastRoot : lastChild[parent];
+    if (prev == kNone) {
+      if (parent != kNone) tree.nodes_[parent].firstChild = id;
+    } else {
+      tree.nodes_[prev].nextSibling = id;
+    }
+    prev = id;
+
+    stack.emplace_back(column, id);
+    current = id;
+  }
+
+  tree.byPath_.resize(tree.nodes_.size());
+  for (NodeId i = 0; i < tree.byPath_.size(); ++i) tree.byPath_[i] = i;
+  std::sort(tree.byPath_.begin(), tree.byPath_.end(),
+            [&tree](NodeId a, NodeId b) { return tree.path(a) < tree.path(b); });
+  std::sort(tree.byAddress_.begin(), tree.byAddress_.end(),
+            [](const AddressRange &a, const AddressRange &b) {
+              return a.start != b.start ? a.start < b.start : a.end > b.end;
+            });
+  tree.maxEnd_.resize(tree.byAddress_.size());
+  uint64_t maxEnd = 0;
+  for (size_t i = 0; i < tree.byAddress_.size(); ++i) {
+    maxEnd = std::max(maxEnd, tree.byAddress_[i].end);
+    tree.maxEnd_[i] = maxEnd;
+  }
+  return tree;
+}
+
+std::vector<PeripheralTree::AddressRange> PeripheralTree::ranges(NodeId node) const {
+  std::vector<AddressRange> out;
+  for (const auto &r : byAddress_) {
+    if (r.node == node) out.push_back(r);
+  }
+  return out;
+}
+
+std::optional<PeripheralTree::NodeId>
+PeripheralTree::findByPath(std::string_view path) const noexcept {
+  auto it = std::lower_bound(byPath_.begin(), byPath_.end(), path,
+                             [this](NodeId n, std::string_view p) { return this->path(n) < p; });
+  if (it == byPath_.end() || this->path(*it) != path) return std::nullopt;
+  return *it;
+}
+
+std::optional<PeripheralTree::NodeId>
+PeripheralTree::findByAddress(uint64_t addr) const noexcept {
+  // Last range starting at or below addr; walk back only while an earlier
+  // range can still reach addr. The first hit has the highest start, i.e.
+  // the innermost of nested registrations.
+  auto it = std::upper_bound(byAddress_.begin(), byAddress_.end(), addr,
+                             [](uint64_t a, const AddressRange &r) { return a < r.start; });
+  for (size_t i = static_cast<size_t>(it - byAddress_.begin()); i-- > 0;) {
+    if (maxEnd_[i] < addr) break;
+    if (byAddress_[i].end >= addr) return byAddress_[i].node;
+  }
+  return std::nullopt;
+}
+
+std::vector<PeripheralDescriptor> PeripheralTree::toDescriptors() const {
+  // Header nodes ("sysbus" and other bare containers) have no type and are
+  // not peripherals; they stay in the tree only to give children a parent
+  constexpr size_t kSkipped = SIZE_MAX;
+  std::vector<size_t> slot(nodes_.size(), kSkipped);
+  std::vector<PeripheralDescriptor> out;
+  for (NodeId i = 0; i < nodes_.size(); ++i) {
+    if (type(i).empty()) continue;
+    slot[i] = out.size();
+    out.push_back({});
+    out.back().path = std::string(path(i));
+    out.back().type = std::string(type(i));
+  }
+  std::vector<unsigned> counts(nodes_.size(), 0);
+  for (const auto &r : byAddress_) {
+    if (slot[r.node] == kSkipped) continue;
+    char buf[48];
+    std::snprintf(buf, sizeof(buf), "0x%llx-0x%llx",
+                  static_cast<unsigned long long>(r.start), static_cast<unsigned long long>(r.end));
+    unsigned n = counts[r.node]++;
+    out[slot[r.node]].metadata[n == 0 ? "range" : "range" + std::to_string(n)] = buf;
+  }
+  return out;
+}
+
+} // namespace renode
@@ -0,0 +1,211 @@
+// renodePool.cpp
+#include "renodePool.h"
+#include "renodeInternal.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace renode {
+
+// ============================================================================
+// Lease
+// ============================================================================
+
+RenodePool::Lease::Lease(Lease &&other) noexcept
+    : pool_(other.pool_), slot_(other.slot_), client_(other.client_) {
+  other.pool_ = nullptr;
+  other.client_ = nullptr;
+}
+
+RenodePool::Lease &RenodePool::Lease::operator=(Lease &&other) noexcept {
+  if (this != &other) {
+    release();
+    pool_ = other.pool_;
+    slot_ = other.slot_;
+    client_ = other.client_;
+    other.pool_ = nullptr;
+    other.client_ = nullptr;
+  }
+  return *this;
+}
+
+RenodePool::Lease::~Lease() {
+  release();
+}
+
+void RenodePool::Lease::release() noexcept {
+  if (pool_ && client_) {
+    pool_->giveBack(slot_);
+  }
+  pool_ = nullptr;
+  client_ = nullptr;
+}
+
+uint16_t RenodePool::Lease::port() const noexcept {
+  return pool_ ? pool_->slots_[slot_].config.port : 0;
+}
+
+uint16_t RenodePool::Lease::monitorPort() const noexcept {
+  return pool_ ? pool_->slots_[slot_].config.monitor_port : 0;
+}
+
+// ============================================================================
+// RenodePool
+// ============================================================================
+
+RenodePool::RenodePool(const RenodePoolConfig &config)
+    : config_(config), slots_(config.size) {
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    RenodeConfig &c = slots_[i].config;
+    c = config.base;
+    c.port = static_cast<uint16_t>(config.base_port + 2 * i);
+    c.monitor_port = static_cast<uint16_t>(config.base_port + 2 * i + 1);
+    // Instances must not share the script's fixed server port
+    c.start_control_server = true;
+  }
+}
+
+std::unique_ptr<RenodePool> RenodePool::create(const RenodePoolConfig &config) {
+  std::unique_ptr<RenodePool> pool(new RenodePool(config));
+  for (size_t i = 0; i < pool->slots_.size(); ++i) {
+    pool->workers_.emplace_back(&RenodePool::slotLoop, pool.get(), i);
+  }
+  return pool;
+}
+
+// All leases must be released before the pool is destroyed
+RenodePool::~RenodePool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stopping_ = true;
+  }
+  cv_.notify_all();
+  readyCv_.notify_all();
+  for (auto &worker : workers_) worker.join();
+  // Slot clients (and the Renode processes they own) are destroyed here
+}
+
+RenodePool::Lease RenodePool::acquire(std::chrono::milliseconds timeout, Error &err) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  auto readySlot = [this]() {
+    return std::find_if(slots_.begin(), slots_.end(),
+                        [](const Slot &s) { return s.state == SlotState::Ready; });
+  };
+  if (!readyCv_.wait_for(lock, timeout,
+                         [&]() { return stopping_ || readySlot() != slots_.end(); }) ||
+      stopping_) {
+    err = {ERR_TIMEOUT, "RenodePool: no ready instance within timeout"};
+    return {};
+  }
+  auto it = readySlot();
+  it->state = SlotState::Leased;
+  err = {0, ""};
+  return Lease(this, static_cast<size_t>(it - slots_.begin()), it->client.get());
+}
+
+size_t RenodePool::readyCount() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return static_cast<size_t>(std::count_if(slots_.begin(), slots_.end(),
+      [](const Slot &s) { return s.state == SlotState::Ready; }));
+}
+
+bool RenodePool::waitUntilFull(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  return readyCv_.wait_for(lock, timeout, [this]() {
+    return std::all_of(slots_.begin(), slots_.end(),
+                       [](const Slot &s) { return s.state == SlotState::Ready; });
+  });
+}
+
+void RenodePool::giveBack(size_t slot) noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    slots_[slot].state = SlotState::Scrubbing;
+  }
+  cv_.notify_all();
+}
+
+bool RenodePool::runSetup(ExternalControlClient &client) {
+  Monitor *monitor = client.getMonitor();
+  if (!monitor) return config_.setup_commands.empty();
+  auto results = monitor->executeBatch(config_.setup_commands);
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i].error || monitorReportedError(results[i].value)) {
+      std::cerr << "RenodePool: setup command failed: " << config_.setup_commands[i] << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<ExternalControlClient> RenodePool::launchInstance(const RenodeConfig &config) {
+  try {
+    auto client = ExternalControlClient::launchAndConnect(config);
+    if (!client->performHandshake()) return nullptr;
+    if (!client->connectMonitor(config.host, config.monitor_port)) return nullptr;
+    if (!runSetup(*client)) return nullptr;
+    return client;
+  } catch (const std::exception &e) {
+    std::cerr << "RenodePool: launch on port " << config.port << " failed: " << e.what() << "\n";
+    return nullptr;
+  }
+}
+
+// Bring a returned instance back to a clean state; false means discard it
+bool RenodePool::scrubInstance(ExternalControlClient &client) {
+  Monitor *monitor = client.getMonitor();
+  if (!monitor) return false;
+  for (const auto &result : monitor->executeBatch(config_.scrub_commands)) {
+    if (result.error || monitorReportedError(result.value)) return false;
+  }
+  // Machines and peripheral handles from the previous lease are gone
+  client.resetSessionState();
+  client.setRecorder(nullptr);
+  return !config_.setup_after_scrub || runSetup(client);
+}
+
+// One worker per slot, so a slow relaunch never holds up the other slots
+void RenodePool::slotLoop(size_t index) {
+  Slot &s = slots_[index];
+  std::unique_lock<std::mutex> lock(mtx_);
+  while (true) {
+    // Failed launches back off (1 s per consecutive failure, up to 10 s)
+    cv_.wait(lock, [&]() {
+      return stopping_ || s.state == SlotState::Scrubbing || s.state == SlotState::Empty;
+    });
+    if (stopping_) break;
+    if (s.state == SlotState::Empty && s.retry_at > std::chrono::steady_clock::now()) {
+      cv_.wait_until(lock, s.retry_at, [this]() { return stopping_; });
+      continue;
+    }
+
+    bool scrub = s.state == SlotState::Scrubbing;
+    std::unique_ptr<ExternalControlClient> client = std::move(s.client);
+    if (!scrub) s.state = SlotState::Launching;
+    RenodeConfig cfg = s.config;
+    lock.unlock();
+
+    if (scrub) {
+      if (!scrubInstance(*client)) client.reset();
+    } else {
+      client = launchInstance(cfg);
+    }
+
+    lock.lock();
+    s.client = std::move(client);
+    if (s.client) {
+      s.state = SlotState::Ready;
+      s.failures = 0;
+    } else {
+      // Failed scrubs terminate the instance; the slot is relaunched
+      s.state = SlotState::Empty;
+      if (!scrub) {
+        ++s.failures;
+        s.retry_at = std::chrono::steady_clock::now() + std::chrono::seconds(std::min(s.failures, 10u));
+      }
+    }
+    readyCv_.notify_all();
+  }
+}
+
+} // namespace renode
@@ -0,0 +1,472 @@
+// renodeRecorder.cpp
+#include "renodeRecorder.h"
+#include "renodeInterface.h"
+#include "renodeMachine.h"
+#include "renodeTelemetry.h"
+
+#include <cstring>
+#include <optional>
+#include <sstream>
+#include <tuple>
+
+namespace renode {
+
+namespace {
+
+constexpr char kMagic[4] = {'R', 'N', 'S', 'L'};
+constexpr uint8_t kVersion = 1;
+
+// Record tags
+enum : uint8_t {
+  TAG_DEFINE_STRING = 0x01,
+  TAG_GPIO_SET      = 0x10,
+  TAG_ADC_SET       = 0x11,
+  TAG_BUS_WRITE     = 0x12,
+  TAG_MONITOR       = 0x13,
+  TAG_END           = 0x7F,
+};
+
+// LEB128 unsigned varint
+void write_varint(std::vector<uint8_t> &buf, uint64_t v) {
+  while (v >= 0x80) {
+    buf.push_back(static_cast<uint8_t>(v | 0x80));
+    v >>= 7;
+  }
+  buf.push_back(static_cast<uint8_t>(v));
+}
+
+struct Reader {
+  const uint8_t *p;
+  const uint8_t *end;
+
+  bool u8(uint8_t &out) {
+    if (p >= end) return false;
+    out = *p++;
+    return true;
+  }
+  bool varint(uint64_t &out) {
+    out = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      uint8_t b;
+      if (!u8(b)) return false;
+      out |= uint64_t(b & 0x7F) << shift;
+      if (!(b & 0x80)) return true;
+    }
+    return false;
+  }
+  bool bytes(std::string &out, size_t n) {
+    if (size_t(end - p) < n) return false;
+    out.assign(reinterpret_cast<const char *>(p), n);
+    p += n;
+    return true;
+  }
+  bool u64(uint64_t &out) {
+    if (size_t(end - p) < 8) return false;
+    out = read_u64_le(p);
+    p += 8;
+    return true;
+  }
+};
+
+} // namespace
+
+// ============================================================================
+// StimulusRecorder
+// ============================================================================
+
+StimulusRecorder::~StimulusRecorder() {
+  close();
+}
+
+std::shared_ptr<StimulusRecorder> StimulusRecorder::create(const std::string &path,
+                                                           Error &err) noexcept {
+  std::FILE *f = std::fopen(path.c_str(), "wb");
+  if (!f) {
+    err = {1, "Cannot open stimulus log " + path + ": " + std::strerror(errno)};
+    return nullptr;
+  }
+  std::shared_ptr<StimulusRecorder> rec(new StimulusRecorder());
+  rec->file_ = f;
+  rec->buf_.insert(rec->buf_.end(), kMagic, kMagic + sizeof(kMagic));
+  rec->buf_.push_back(kVersion);
+  err = {0, ""};
+  return rec;
+}
+
+uint32_t StimulusRecorder::intern(const std::string &s) {
+  auto it = strings_.find(s);
+  if (it != strings_.end()) return it->second;
+  uint32_t id = static_cast<uint32_t>(strings_.size());
+  strings_.emplace(s, id);
+  buf_.push_back(TAG_DEFINE_STRING);
+  write_varint(buf_, id);
+  write_varint(buf_, s.size());
+  buf_.insert(buf_.end(), s.begin(), s.end());
+  return id;
+}
+
+// Times are kept monotonic so deltas stay unsigned
+void StimulusRecorder::beginRecord(uint8_t tag, uint64_t timeUs) {
+  if (timeUs < lastRecordTimeUs_) timeUs = lastRecordTimeUs_;
+  buf_.push_back(tag);
+  write_varint(buf_, timeUs - lastRecordTimeUs_);
+  lastRecordTimeUs_ = timeUs;
+  if (timeUs > lastNotedTimeUs_) lastNotedTimeUs_ = timeUs;
+}
+
+// Hand complete records to stdio in batches; the FILE buffer does the rest
+void StimulusRecorder::commit() {
+  ++records_;
+  if (buf_.size() >= 4096 && file_) {
+    std::fwrite(buf_.data(), 1, buf_.size(), file_);
+    buf_.clear();
+  }
+}
+
+void StimulusRecorder::noteTime(const std::string &machine, uint64_t timeUs) noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  lastMachine_ = machine;
+  if (timeUs > lastNotedTimeUs_) lastNotedTimeUs_ = timeUs;
+}
+
+void StimulusRecorder::recordGpio(const std::string &machine, const std::string &path, int pin,
+                                  GpioState state, uint64_t timeUs) noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!file_) return;
+  lastMachine_ = machine;
+  uint32_t m = intern(machine);
+  uint32_t p = intern(path);
+  beginRecord(TAG_GPIO_SET, timeUs);
+  write_varint(buf_, m);
+  write_varint(buf_, p);
+  write_varint(buf_, static_cast<uint32_t>(pin));
+  buf_.push_back(static_cast<uint8_t>(state));
+  commit();
+}
+
+void StimulusRecorder::recordAdc(const std::string &machine, const std::string &path, int channel,
+                                 AdcValue value, uint64_t timeUs) noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!file_) return;
+  lastMachine_ = machine;
+  uint32_t m = intern(machine);
+  uint32_t p = intern(path);
+  beginRecord(TAG_ADC_SET, timeUs);
+  write_varint(buf_, m);
+  write_varint(buf_, p);
+  write_varint(buf_, static_cast<uint32_t>(channel));
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  write_u64_le(buf_, bits);
+  commit();
+}
+
+void StimulusRecorder::recordBusWrite(const std::string &machine, const std::string &busPath,
+                                      const std::string &node, uint64_t address,
+                                      AccessWidth width, uint64_t value,
+                                      uint64_t timeUs) noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!file_) return;
+  lastMachine_ = machine;
+  uint32_t m = intern(machine);
+  uint32_t b = intern(busPath);
+  uint32_t n = intern(node);
+  beginRecord(TAG_BUS_WRITE, timeUs);
+  write_varint(buf_, m);
+  write_varint(buf_, b);
+  write_varint(buf_, n);
+  buf_.push_back(static_cast<uint8_t>(width));
+  write_varint(buf_, address);
+  write_varint(buf_, value);
+  commit();
+}
+
+// Selected machine of a "mach set" command, if it is one
+static std::optional<std::string> selectedMachine(const std::string &command) {
+  std::istringstream in(command);
+  std::string verb, sub, name;
+  in >> verb >> sub;
+  if (verb != "mach" || sub != "set") return std::nullopt;
+  std::getline(in >> std::ws, name);
+  if (name.size() >= 2 && name.front() == '"' && name.back() == '"') name = name.substr(1, name.size() - 2);
+  return name;
+}
+
+// Only commands that change emulation state are worth replaying. Queries and
+// the library's own plumbing (snapshot files, UART terminal taps) are not:
+// replaying a snapshot Load would even rewind the run.
+static bool changesState(const std::string &command) {
+  std::istringstream in(command);
+  std::string verb, method;
+  in >> verb >> method;
+  if (verb == "mach") return !method.empty() && method != "ls";  // bare "mach" lists
+  if (verb == "emulation") return method != "IsStarted" && method != "CreateServerSocketTerminal";
+  static const char *const kSkipped[] = {"peripherals", "help", "version", "lastLog", "Save", "Load", "connector"};
+  for (const char *skipped : kSkipped) {
+    if (verb == skipped) return false;
+  }
+  // "<peripheral> ReadDoubleWord 0x...", "<peripheral> GetState 3", ...
+  static const char *const kReaders[] = {"Read", "Get", "Is", "Has"};
+  for (const char *prefix : kReaders) {
+    if (method.rfind(prefix, 0) == 0) return false;
+  }
+  // A peripheral name alone just describes it
+  return !method.empty();
+}
+
+void StimulusRecorder::recordMonitorCommand(const std::string &command) noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!file_) return;
+  // Selection is kept as the record's machine; replay re-selects it
+  if (auto name = selectedMachine(command)) {
+    lastMachine_ = *name;
+    return;
+  }
+  if (!changesState(command)) return;
+  uint32_t m = intern(lastMachine_);
+  beginRecord(TAG_MONITOR, lastNotedTimeUs_);
+  write_varint(buf_, m);
+  write_varint(buf_, command.size());
+  buf_.insert(buf_.end(), command.begin(), command.end());
+  commit();
+}
+
+Error StimulusRecorder::flush() noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  if (!file_) return {1, "Stimulus log closed"};
+  if (!buf_.empty()) {
+    if (std::fwrite(buf_.data(), 1, buf_.size(), file_) != buf_.size()) {
+      return {2, "Stimulus log write failed"};
+    }
+    buf_.clear();
+  }
+  if (std::fflush(file_) != 0) return {2, "Stimulus log flush failed"};
+  return {0, ""};
+}
+
+Error StimulusRecorder::close() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (!file_) return {0, ""};
+    beginRecord(TAG_END, lastNotedTimeUs_);
+  }
+  Error err = flush();
+  std::lock_guard<std::mutex> lock(mtx_);
+  std::fclose(file_);
+  file_ = nullptr;
+  return err;
+}
+
+size_t StimulusRecorder::recordCount() const noexcept {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return records_;
+}
+
+// ============================================================================
+// StimulusReplayer
+// ============================================================================
+
+Result<std::vector<StimulusRecord>> StimulusReplayer::load(const std::string &path) noexcept {
+  std::FILE *f = std::fopen(path.c_str(), "rb");
+  if (!f) return {{}, {1, "Cannot open stimulus log " + path + ": " + std::strerror(errno)}};
+
+  std::vector<uint8_t> data;
+  uint8_t chunk[65536];
+  size_t n;
+  while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+    data.insert(data.end(), chunk, chunk + n);
+  }
+  std::fclose(f);
+
+  if (data.size() < 5 || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+    return {{}, {2, "Not a stimulus log: " + path}};
+  }
+  if (data[4] != kVersion) {
+    return {{}, {2, "Unsupported stimulus log version " + std::to_string(data[4])}};
+  }
+
+  Reader r{data.data() + 5, data.data() + data.size()};
+  std::vector<std::string> strings;
+  std::vector<StimulusRecord> records;
+  uint64_t timeUs = 0;
+
+  auto str = [&strings](uint64_t id, std::string &out) {
+    if (id >= strings.size()) return false;
+    out = strings[id];
+    return true;
+  };
+
+  uint8_t tag;
+  while (r.u8(tag)) {
+    if (tag == TAG_DEFINE_STRING) {
+      uint64_t id, len;
+      std::string s;
+      if (!r.varint(id) || !r.varint(len) || !r.bytes(s, len) || id != strings.size()) {
+        return {{}, {3, "Corrupt string definition in stimulus log"}};
+      }
+      strings.push_back(std::move(s));
+      continue;
+    }
+
+    uint64_t delta;
+    if (!r.varint(delta)) return {{}, {3, "Truncated stimulus record"}};
+    timeUs += delta;
+
+    StimulusRecord rec;
+    rec.timeUs = timeUs;
+    uint64_t m = 0, p = 0, idx = 0, nd = 0, len = 0;
+    uint8_t b = 0;
+    bool ok = true;
+    switch (tag) {
+    case TAG_GPIO_SET:
+      rec.kind = StimulusRecord::Kind::GpioSet;
+      ok = r.varint(m) && r.varint(p) && r.varint(idx) && r.u8(b) &&
+           str(m, rec.machine) && str(p, rec.path) && b <= 2;
+      rec.index = static_cast<int>(idx);
+      rec.state = static_cast<GpioState>(b);
+      break;
+    case TAG_ADC_SET: {
+      rec.kind = StimulusRecord::Kind::AdcSet;
+      uint64_t bits = 0;
+      ok = r.varint(m) && r.varint(p) && r.varint(idx) && r.u64(bits) &&
+           str(m, rec.machine) && str(p, rec.path);
+      rec.index = static_cast<int>(idx);
+      std::memcpy(&rec.adcValue, &bits, sizeof(bits));
+      break;
+    }
+    case TAG_BUS_WRITE:
+      rec.kind = StimulusRecord::Kind::BusWrite;
+      ok = r.varint(m) && r.varint(p) && r.varint(nd) && r.u8(b) &&
+           r.varint(rec.address) && r.varint(rec.value) &&
+           str(m, rec.machine) && str(p, rec.path) && str(nd, rec.node);
+      rec.width = static_cast<AccessWidth>(b);
+      break;
+    case TAG_MONITOR:
+      rec.kind = StimulusRecord::Kind::MonitorCommand;
+      ok = r.varint(m) && r.varint(len) && r.bytes(rec.command, len) && str(m, rec.machine);
+      break;
+    case TAG_END:
+      rec.kind = StimulusRecord::Kind::End;
+      break;
+    default:
+      return {{}, {3, "Unknown stimulus record tag " + std::to_string(tag)}};
+    }
+    if (!ok) return {{}, {3, "Corrupt stimulus record"}};
+    records.push_back(std::move(rec));
+  }
+
+  return {std::move(records), {0, ""}};
+}
+
+Result<StimulusReplayer::Stats> StimulusReplayer::replay(ExternalControlClient &client,
+                                                         const std::vector<StimulusRecord> &records,
+                                                         bool rebaseToNow) noexcept {
+  Stats stats;
+  if (records.empty()) return {stats, {0, ""}};
+
+  uint64_t startNs = Telemetry::nowNs();
+
+  std::map<std::string, std::shared_ptr<AMachine>> machines;
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<Gpio>> gpios;
+  std::map<std::pair<std::string, std::string>, std::shared_ptr<Adc>> adcs;
+  std::map<std::tuple<std::string, std::string, std::string>, std::shared_ptr<BusContext>> buses;
+
+  auto machineFor = [&](const std::string &name, Error &err) -> std::shared_ptr<AMachine> {
+    auto it = machines.find(name);
+    if (it != machines.end()) return it->second;
+    auto m = client.getMachine(name, err);
+    if (m) machines.emplace(name, m);
+    return m;
+  };
+
+  // Monitor commands issued before any peripheral stimulus carry no machine;
+  // drive time on the first machine that appears in the log.
+  std::string defaultMachine;
+  for (const auto &rec : records) {
+    if (!rec.machine.empty()) {
+      defaultMachine = rec.machine;
+      break;
+    }
+  }
+  if (defaultMachine.empty()) return {stats, {4, "Stimulus log names no machine"}};
+
+  Error err;
+  auto first = machineFor(defaultMachine, err);
+  if (!first) return {stats, err};
+
+  auto now = first->getTime(TimeUnit::TU_MICROSECONDS);
+  if (now.error) return {stats, now.error};
+  uint64_t startUs = now.value;
+  uint64_t virtualNow = startUs;
+  // Shift recorded times so the first record lands on the current time
+  int64_t offset = rebaseToNow ? int64_t(startUs) - int64_t(records.front().timeUs) : 0;
+  std::string selected;  // monitor's machine, once replay has set it
+
+  for (const auto &rec : records) {
+    const std::string &mname = rec.machine.empty() ? defaultMachine : rec.machine;
+    auto machine = machineFor(mname, err);
+    if (!machine) return {stats, err};
+
+    // Advance in one RUN_FOR to the stimulus time: the largest quantum that
+    // cannot skip past it
+    uint64_t target = uint64_t(int64_t(rec.timeUs) + offset);
+    if (target > virtualNow) {
+      err = machine->runUntil(target);
+      if (err) return {stats, err};
+      virtualNow = target;
+      ++stats.runCalls;
+    }
+
+    switch (rec.kind) {
+    case StimulusRecord::Kind::GpioSet: {
+      auto &gpio = gpios[{mname, rec.path}];
+      if (!gpio) gpio = machine->getGpio(rec.path, err);
+      if (!gpio) return {stats, err};
+      err = gpio->setState(rec.index, rec.state);
+      break;
+    }
+    case StimulusRecord::Kind::AdcSet: {
+      auto &adc = adcs[{mname, rec.path}];
+      if (!adc) adc = machine->getAdc(rec.path, err);
+      if (!adc) return {stats, err};
+      err = adc->setChannelValue(rec.index, rec.adcValue);
+      break;
+    }
+    case StimulusRecord::Kind::BusWrite: {
+      auto &bus = buses[{mname, rec.path, rec.node}];
+      if (!bus) {
+        auto sysbus = machine->getSysBus(rec.path, err);
+        if (!sysbus) return {stats, err};
+        bus = sysbus->getBusContext(rec.node, err);
+        if (!bus) return {stats, err};
+      }
+      err = bus->write(rec.address, rec.width, rec.value);
+      break;
+    }
+    case StimulusRecord::Kind::MonitorCommand: {
+      if (rec.command == "start" || rec.command == "pause") continue;
+      Monitor *monitor = client.getMonitor();
+      if (!monitor) return {stats, {3, "Replay needs a monitor connection"}};
+      // Machine-relative commands apply to the machine selected when recorded
+      if (mname != selected) {
+        auto sel = monitor->execute("mach set \"" + mname + "\"");
+        if (sel.error) return {stats, sel.error};
+        selected = mname;
+      }
+      auto result = monitor->execute(rec.command);
+      err = result.error;
+      break;
+    }
+    case StimulusRecord::Kind::End:
+      continue;
+    }
+    if (err) return {stats, err};
+    ++stats.applied;
+  }
+
+  stats.virtualUs = virtualNow - startUs;
+  stats.wallNs = Telemetry::nowNs() - startNs;
+  return {stats, {0, ""}};
+}
+
+} // namespace renode
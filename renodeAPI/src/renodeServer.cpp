@@ -0,0 +1,142 @@
+// renodeServer.cpp
+#include "renodeServer.h"
+#include "renodeMachine.h"
+#include "renodeTelemetry.h"
+
+#include <iostream>
+
+namespace renode {
+
+// ============================================================================
+// Session
+// ============================================================================
+
+RenodeServer::Session::Session(Session &&other) noexcept
+    : server_(other.server_), name_(std::move(other.name_)),
+      machine_(std::move(other.machine_)) {
+  other.server_ = nullptr;
+}
+
+RenodeServer::Session &RenodeServer::Session::operator=(Session &&other) noexcept {
+  if (this != &other) {
+    end();
+    server_ = other.server_;
+    name_ = std::move(other.name_);
+    machine_ = std::move(other.machine_);
+    other.server_ = nullptr;
+  }
+  return *this;
+}
+
+RenodeServer::Session::~Session() {
+  end();
+}
+
+ExternalControlClient *RenodeServer::Session::client() const noexcept {
+  return server_ ? server_->client() : nullptr;
+}
+
+Error RenodeServer::Session::end() noexcept {
+  if (!server_) return {0, ""};
+  RenodeServer *server = server_;
+  server_ = nullptr;
+  machine_.reset();
+  return server->endSession(name_);
+}
+
+// ============================================================================
+// RenodeServer
+// ============================================================================
+
+std::unique_ptr<RenodeServer> RenodeServer::start(const RenodeServerConfig &config,
+                                                  Error &err) noexcept {
+  std::unique_ptr<RenodeServer> server(new RenodeServer(config));
+  err = server->connect();
+  if (err) return nullptr;
+  return server;
+}
+
+// Sessions must have ended before the server is destroyed
+RenodeServer::~RenodeServer() = default;
+
+// Failing to reach Renode leaves the server without a client, so report it
+// as ERR_NOT_CONNECTED like the calls made afterwards (ERR_CONNECTION_FAILED
+// is 0, which Error treats as success)
+Error RenodeServer::connect() noexcept {
+  client_.reset();  // terminates an owned process
+  const RenodeConfig &c = config_.renode;
+  try {
+    client_ = config_.attach ? ExternalControlClient::connect(c.host, c.port)
+                             : ExternalControlClient::launchAndConnect(c);
+  } catch (const std::exception &e) {
+    return {ERR_NOT_CONNECTED, std::string("RenodeServer: ") + e.what()};
+  }
+  if (!client_->performHandshake()) {
+    client_.reset();
+    return {ERR_NOT_CONNECTED, "RenodeServer: handshake failed"};
+  }
+  if (c.monitor_port == 0 || !client_->connectMonitor(c.host, c.monitor_port)) {
+    client_.reset();
+    return {ERR_NOT_CONNECTED, "RenodeServer: monitor connection required"};
+  }
+  sessionsSinceLaunch_ = 0;
+  return {0, ""};
+}
+
+RenodeServer::Session RenodeServer::beginSession(const std::string &machineName,
+                                                 Error &err) noexcept {
+  return beginSession(machineName, config_.session_setup, err);
+}
+
+RenodeServer::Session RenodeServer::beginSession(const std::string &machineName,
+                                                 const std::vector<std::string> &setupCommands,
+                                                 Error &err) noexcept {
+  if (sessionActive_) {
+    err = {1, "RenodeServer: previous session still active"};
+    return {};
+  }
+  uint64_t startNs = Telemetry::nowNs();
+
+  bool recycle = !config_.attach && config_.recycle_after_sessions > 0 &&
+                 sessionsSinceLaunch_ >= config_.recycle_after_sessions;
+  if (!client_ || recycle) {
+    if ((err = connect())) return {};
+    ++stats_.relaunches;
+  }
+
+  auto machine = client_->createMachine(machineName, setupCommands, err);
+  if (!machine) {
+    // Do not leave a half-built machine behind for the next session
+    client_->removeMachine(machineName);
+    return {};
+  }
+
+  sessionActive_ = true;
+  ++sessionsSinceLaunch_;
+  ++stats_.sessions;
+  stats_.last_setup_ns = Telemetry::nowNs() - startNs;
+  err = {0, ""};
+  return Session(this, machineName, std::move(machine));
+}
+
+Error RenodeServer::endSession(const std::string &name) noexcept {
+  sessionActive_ = false;
+  if (!client_) return {ERR_NOT_CONNECTED, "RenodeServer: not connected"};
+  uint64_t startNs = Telemetry::nowNs();
+
+  client_->setRecorder(nullptr);
+  if (Monitor *monitor = client_->getMonitor()) monitor->pause();
+  Error err = client_->removeMachine(name);
+  stats_.last_teardown_ns = Telemetry::nowNs() - startNs;
+  if (!err) return err;
+
+  ++stats_.teardown_failures;
+  std::cerr << "RenodeServer: teardown of '" << name << "' failed: " << err.message << "\n";
+  if (!config_.attach) {
+    // A leaked machine would leak into every later session: start over
+    if (!connect()) ++stats_.relaunches;
+  }
+  return err;
+}
+
+} // namespace renode
@@ -0,0 +1,350 @@
+// renodeTelemetry.cpp
+#include "renodeTelemetry.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace renode {
+
+// ============================================================================
+// HdrHistogram
+// ============================================================================
+
+size_t HdrHistogram::indexOf(uint64_t value) noexcept {
+  constexpr uint64_t maxValue = (uint64_t(1) << kMaxValueBits) - 1;
+  if (value > maxValue) value = maxValue;
+  // Position of the highest set bit, never below the sub-bucket range
+  unsigned msb = 63u - unsigned(std::countl_zero(value | ((uint64_t(1) << kSubBucketBits) - 1)));
+  unsigned shift = msb - (kSubBucketBits - 1);
+  return size_t(shift) * kHalfSubBuckets + size_t(value >> shift);
+}
+
+uint64_t HdrHistogram::lowestEquivalent(size_t index) noexcept {
+  if (index < 2 * kHalfSubBuckets) return index;
+  size_t shift = index / kHalfSubBuckets - 1;
+  uint64_t sub = index - shift * kHalfSubBuckets;
+  return sub << shift;
+}
+
+uint64_t HdrHistogram::highestEquivalent(size_t index) noexcept {
+  if (index < 2 * kHalfSubBuckets) return index;
+  size_t shift = index / kHalfSubBuckets - 1;
+  return lowestEquivalent(index) + (uint64_t(1) << shift) - 1;
+}
+
+void HdrHistogram::record(uint64_t value) noexcept {
+  counts_[indexOf(value)].fetch_add(1, std::memory_order_relaxed);
+  total_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t cur = min_.load(std::memory_order_relaxed);
+  while (value < cur && !min_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+  cur = max_.load(std::memory_order_relaxed);
+  while (value > cur && !max_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+void HdrHistogram::reset() noexcept {
+  for (auto &c : counts_) c.store(0, std::memory_order_relaxed);
+  total_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(UINT64_MAX, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+void HdrHistogram::mergeFrom(const HdrHistogram &other) noexcept {
+  uint64_t n = other.total_.load(std::memory_order_relaxed);
+  if (n == 0) return;
+  for (size_t i = 0; i < kBucketCount; ++i) {
+    uint64_t c = other.counts_[i].load(std::memory_order_relaxed);
+    if (c) counts_[i].fetch_add(c, std::memory_order_relaxed);
+  }
+  total_.fetch_add(n, std::memory_order_relaxed);
+  sum_.fetch_add(other.sum_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+  uint64_t value = other.min_.load(std::memory_order_relaxed);
+  uint64_t cur = min_.load(std::memory_order_relaxed);
+  while (value < cur && !min_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+  value = other.max_.load(std::memory_order_relaxed);
+  cur = max_.load(std::memory_order_relaxed);
+  while (value > cur && !max_.compare_exchange_weak(cur, value, std::memory_order_relaxed)) {}
+}
+
+uint64_t HistogramSnapshot::percentile(double p) const noexcept {
+  if (count == 0) return 0;
+  p = std::clamp(p, 0.0, 100.0);
+  uint64_t rank = static_cast<uint64_t>(p / 100.0 * double(count) + 0.5);
+  if (rank == 0) rank = 1;
+  uint64_t seen = 0;
+  for (const auto &b : buckets) {
+    seen += b.second;
+    if (seen >= rank) return std::min(b.first, max);
+  }
+  return max;
+}
+
+// ============================================================================
+// Telemetry
+// ============================================================================
+
+struct Telemetry::Shard {
+  std::array<HdrHistogram, kTelemetryCommandSlots> commandRtt;
+  std::array<std::atomic<uint64_t>, kTelemetryCommandSlots> bytesSent{};
+  std::array<std::atomic<uint64_t>, kTelemetryCommandSlots> bytesReceived{};
+  std::array<HdrHistogram, size_t(TelemetryMetric::Count_)> metrics;
+};
+
+// Shards live as long as the registry. shards[0] is the retired total: an
+// exiting thread adds its counts there and parks its shard on the free list.
+struct Telemetry::Registry {
+  mutable std::mutex mtx;
+  std::vector<std::unique_ptr<Shard>> shards;
+  std::vector<Shard *> free;
+  Shard *retired = nullptr;
+};
+
+Telemetry::Telemetry() : registry_(new Registry) {
+  registry_->shards.push_back(std::make_unique<Shard>());
+  registry_->retired = registry_->shards.back().get();
+}
+Telemetry::~Telemetry() { delete registry_; }
+
+Telemetry &Telemetry::instance() {
+  static Telemetry telemetry;
+  return telemetry;
+}
+
+Telemetry::Shard &Telemetry::localShard() {
+  // Hands the shard back when the thread exits
+  struct Lease {
+    Telemetry *owner = nullptr;
+    Shard *shard = nullptr;
+    ~Lease() {
+      if (shard) owner->retireShard(shard);
+    }
+  };
+  thread_local Lease lease;
+  if (!lease.shard) {
+    std::lock_guard<std::mutex> lock(registry_->mtx);
+    if (!registry_->free.empty()) {
+      lease.shard = registry_->free.back();
+      registry_->free.pop_back();
+    } else {
+      registry_->shards.push_back(std::make_unique<Shard>());
+      lease.shard = registry_->shards.back().get();
+    }
+    lease.owner = this;
+  }
+  return *lease.shard;
+}
+
+void Telemetry::retireShard(Shard *shard) noexcept {
+  std::lock_guard<std::mutex> lock(registry_->mtx);
+  Shard &retired = *registry_->retired;
+  for (size_t c = 0; c < kTelemetryCommandSlots; ++c) {
+    retired.commandRtt[c].mergeFrom(shard->commandRtt[c]);
+    retired.bytesSent[c].fetch_add(shard->bytesSent[c].exchange(0, std::memory_order_relaxed),
+                                   std::memory_order_relaxed);
+    retired.bytesReceived[c].fetch_add(shard->bytesReceived[c].exchange(0, std::memory_order_relaxed),
+                                       std::memory_order_relaxed);
+    shard->commandRtt[c].reset();
+  }
+  for (size_t m = 0; m < size_t(TelemetryMetric::Count_); ++m) {
+    retired.metrics[m].mergeFrom(shard->metrics[m]);
+    shard->metrics[m].reset();
+  }
+  registry_->free.push_back(shard);
+}
+
+static size_t commandSlot(ApiCommand command) noexcept {
+  int v = static_cast<int>(command);
+  return (v >= 0 && size_t(v) < kTelemetryCommandSlots) ? size_t(v) : 0;
+}
+
+void Telemetry::recordCommand(ApiCommand command, uint64_t rttNs, size_t bytesSent,
+                              size_t bytesReceived) noexcept {
+  if (!enabled()) return;
+  Shard &s = localShard();
+  size_t slot = commandSlot(command);
+  s.commandRtt[slot].record(rttNs);
+  s.bytesSent[slot].fetch_add(bytesSent, std::memory_order_relaxed);
+  s.bytesReceived[slot].fetch_add(bytesReceived, std::memory_order_relaxed);
+}
+
+void Telemetry::record(TelemetryMetric metric, uint64_t value) noexcept {
+  if (!enabled() || metric >= TelemetryMetric::Count_) return;
+  localShard().metrics[size_t(metric)].record(value);
+}
+
+TelemetrySnapshot Telemetry::snapshot() const {
+  TelemetrySnapshot snap;
+
+  std::lock_guard<std::mutex> lock(registry_->mtx);
+
+  // Merge one histogram across all shards into a dense count array
+  auto merge = [this](auto select, HistogramSnapshot &out) {
+    std::vector<uint64_t> counts(HdrHistogram::kBucketCount, 0);
+    out.min = UINT64_MAX;
+    for (const auto &shard : registry_->shards) {
+      const HdrHistogram &h = select(*shard);
+      uint64_t n = h.total_.load(std::memory_order_relaxed);
+      if (n == 0) continue;
+      out.count += n;
+      out.sum += h.sum_.load(std::memory_order_relaxed);
+      out.min = std::min(out.min, h.min_.load(std::memory_order_relaxed));
+      out.max = std::max(out.max, h.max_.load(std::memory_order_relaxed));
+      for (size_t i = 0; i < HdrHistogram::kBucketCount; ++i) {
+        counts[i] += h.counts_[i].load(std::memory_order_relaxed);
+      }
+    }
+    if (out.count == 0) out.min = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+      if (counts[i]) out.buckets.emplace_back(HdrHistogram::highestEquivalent(i), counts[i]);
+    }
+  };
+
+  for (size_t c = 0; c < kTelemetryCommandSlots; ++c) {
+    merge([c](const Shard &s) -> const HdrHistogram & { return s.commandRtt[c]; },
+          snap.commandRttNs[c]);
+    for (const auto &shard : registry_->shards) {
+      snap.bytesSent[c] += shard->bytesSent[c].load(std::memory_order_relaxed);
+      snap.bytesReceived[c] += shard->bytesReceived[c].load(std::memory_order_relaxed);
+    }
+  }
+  for (size_t m = 0; m < size_t(TelemetryMetric::Count_); ++m) {
+    merge([m](const Shard &s) -> const HdrHistogram & { return s.metrics[m]; },
+          snap.metrics[m]);
+  }
+  return snap;
+}
+
+void Telemetry::reset() noexcept {
+  std::lock_guard<std::mutex> lock(registry_->mtx);
+  for (auto &shard : registry_->shards) {
+    for (auto &h : shard->commandRtt) h.reset();
+    for (auto &b : shard->bytesSent) b.store(0, std::memory_order_relaxed);
+    for (auto &b : shard->bytesReceived) b.store(0, std::memory_order_relaxed);
+    for (auto &h : shard->metrics) h.reset();
+  }
+}
+
+const char *Telemetry::commandName(ApiCommand command) noexcept {
+  switch (command) {
+    case ANY_COMMAND: return "ANY_COMMAND";
+    case RUN_FOR:     return "RUN_FOR";
+    case GET_TIME:    return "GET_TIME";
+    case GET_MACHINE: return "GET_MACHINE";
+    case ADC:         return "ADC";
+    case GPIO:        return "GPIO";
+    case SYSTEM_BUS:  return "SYSTEM_BUS";
+    case EVENT:       return "EVENT";
+  }
+  return "UNKNOWN";
+}
+
+const char *Telemetry::metricName(TelemetryMetric metric) noexcept {
+  switch (metric) {
+    case TelemetryMetric::RunForWallNs:           return "run_for_wall_ns";
+    case TelemetryMetric::GetTimeWallNs:          return "get_time_wall_ns";
+    case TelemetryMetric::EventsPerTick:          return "events_per_tick";
+    case TelemetryMetric::RealTimeFactorPermille: return "real_time_factor_permille";
+    case TelemetryMetric::CallbackNs:             return "callback_ns";
+    case TelemetryMetric::MonitorRttNs:           return "monitor_rtt_ns";
+    case TelemetryMetric::Count_:                 break;
+  }
+  return "unknown";
+}
+
+// ============================================================================
+// Export
+// ============================================================================
+
+static constexpr double kExportQuantiles[] = {50.0, 90.0, 99.0, 99.9};
+
+static void writeJsonHistogram(std::ostringstream &os, const HistogramSnapshot &h) {
+  os << "{\"count\":" << h.count << ",\"sum\":" << h.sum << ",\"min\":" << h.min
+     << ",\"max\":" << h.max << ",\"mean\":" << h.mean()
+     << ",\"p50\":" << h.percentile(50.0) << ",\"p90\":" << h.percentile(90.0)
+     << ",\"p99\":" << h.percentile(99.0) << ",\"p999\":" << h.percentile(99.9) << "}";
+}
+
+std::string TelemetrySnapshot::toJson() const {
+  std::ostringstream os;
+  os << "{\"commands\":{";
+  bool first = true;
+  for (size_t c = 0; c < kTelemetryCommandSlots; ++c) {
+    if (commandRttNs[c].count == 0 && bytesSent[c] == 0 && bytesReceived[c] == 0) continue;
+    if (!first) os << ",";
+    first = false;
+    os << "\"" << Telemetry::commandName(static_cast<ApiCommand>(c)) << "\":{\"rtt_ns\":";
+    writeJsonHistogram(os, commandRttNs[c]);
+    os << ",\"bytes_sent\":" << bytesSent[c] << ",\"bytes_received\":" << bytesReceived[c] << "}";
+  }
+  os << "},\"metrics\":{";
+  for (size_t m = 0; m < metrics.size(); ++m) {
+    if (m) os << ",";
+    os << "\"" << Telemetry::metricName(static_cast<TelemetryMetric>(m)) << "\":";
+    writeJsonHistogram(os, metrics[m]);
+  }
+  os << "}}";
+  return os.str();
+}
+
+// Emit one histogram as a Prometheus summary; `scale` converts the recorded
+// unit into the exported base unit (e.g. ns -> seconds).
+static void writePromSummary(std::ostringstream &os, const std::string &name,
+                             const std::string &labels, const HistogramSnapshot &h,
+                             double scale) {
+  std::string sep = labels.empty() ? "" : ",";
+  for (double q : kExportQuantiles) {
+    os << name << "{" << labels << sep << "quantile=\"" << q / 100.0 << "\"} "
+       << double(h.percentile(q)) * scale << "\n";
+  }
+  std::string braced = labels.empty() ? "" : "{" + labels + "}";
+  os << name << "_sum" << braced << " " << double(h.sum) * scale << "\n";
+  os << name << "_count" << braced << " " << h.count << "\n";
+}
+
+std::string TelemetrySnapshot::toPrometheus() const {
+  std::ostringstream os;
+
+  os << "# HELP renode_command_rtt_seconds External-control command round trip time.\n"
+     << "# TYPE renode_command_rtt_seconds summary\n";
+  for (size_t c = 0; c < kTelemetryCommandSlots; ++c) {
+    if (commandRttNs[c].count == 0) continue;
+    std::string labels = std::string("command=\"") +
+                         Telemetry::commandName(static_cast<ApiCommand>(c)) + "\"";
+    writePromSummary(os, "renode_command_rtt_seconds", labels, commandRttNs[c], 1e-9);
+  }
+
+  os << "# HELP renode_command_bytes_total Bytes transferred per command type.\n"
+     << "# TYPE renode_command_bytes_total counter\n";
+  for (size_t c = 0; c < kTelemetryCommandSlots; ++c) {
+    if (bytesSent[c] == 0 && bytesReceived[c] == 0) continue;
+    const char *cmd = Telemetry::commandName(static_cast<ApiCommand>(c));
+    os << "renode_command_bytes_total{command=\"" << cmd << "\",direction=\"sent\"} "
+       << bytesSent[c] << "\n";
+    os << "renode_command_bytes_total{command=\"" << cmd << "\",direction=\"received\"} "
+       << bytesReceived[c] << "\n";
+  }
+
+  struct PromMetric { TelemetryMetric metric; const char *name; const char *help; double scale; };
+  static const PromMetric promMetrics[] = {
+    {TelemetryMetric::RunForWallNs, "renode_run_for_seconds", "Wall time spent in runFor.", 1e-9},
+    {TelemetryMetric::GetTimeWallNs, "renode_get_time_seconds", "Wall time spent in getTime.", 1e-9},
+    {TelemetryMetric::EventsPerTick, "renode_events_per_tick", "Async events dispatched per runFor.", 1.0},
+    {TelemetryMetric::RealTimeFactorPermille, "renode_real_time_factor", "Virtual time over wall time per runFor.", 1e-3},
+    {TelemetryMetric::CallbackNs, "renode_callback_seconds", "Time spent in user event callbacks.", 1e-9},
+    {TelemetryMetric::MonitorRttNs, "renode_monitor_rtt_seconds", "Monitor command round trip time.", 1e-9},
+  };
+  for (const auto &pm : promMetrics) {
+    os << "# HELP " << pm.name << " " << pm.help << "\n"
+       << "# TYPE " << pm.name << " summary\n";
+    writePromSummary(os, pm.name, "", metric(pm.metric), pm.scale);
+  }
+  return os.str();
+}
+
+} // namespace renode
@@ -0,0 +1,13 @@
+// check.hpp
+// Minimal assertion for the test executables: report and fail the test.
+#pragma once
+
+#include <cstdio>
+
+#define CHECK(cond)                                                              \
+  do {                                                                           \
+    if (!(cond)) {                                                               \
+      std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+      return 1;                                                                  \
+    }                                                                            \
+  } while (0)
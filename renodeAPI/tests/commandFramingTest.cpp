@@ -0,0 +1,37 @@
+// commandFramingTest.cpp
+// Every control command must reach the server as one segment. A payload
+// written separately from its header sits in Nagle's buffer until the
+// server's delayed ACK (~40 ms on Linux), which stalls each small command.
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "check.hpp"
+#include "fakeRenode.hpp"
+#include "renodeInterface.h"
+#include "renodeMachine.h"
+
+using namespace renode;
+
+int main() {
+  FakeRenode renode;
+  auto client = ExternalControlClient::connect("127.0.0.1", renode.controlPort());
+  CHECK(client && client->performHandshake());
+
+  constexpr int kCommands = 50;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCommands; ++i) {
+    // GET_MACHINE carries the name as payload; the fake knows no machines
+    Error err;
+    CHECK(!client->getMachine("machine-" + std::to_string(i), err));
+    CHECK(err.message == "Machine not found");
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  CHECK(renode.splitFrames() == 0);
+  // One delayed ACK per command would take kCommands * 40 ms
+  CHECK(elapsed < std::chrono::milliseconds(kCommands * 10));
+  std::printf("%d GET_MACHINE round trips in %lld us\n", kCommands,
+              static_cast<long long>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+  return 0;
+}
@@ -0,0 +1,249 @@
+// fakeRenode.cpp
+#include "fakeRenode.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+bool readAll(int fd, void *data, size_t len) {
+  auto *p = static_cast<uint8_t *>(data);
+  while (len > 0) {
+    ssize_t n = ::recv(fd, p, len, 0);
+    if (n <= 0) return false;
+    p += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+bool writeAll(int fd, const void *data, size_t len) {
+  const auto *p = static_cast<const uint8_t *>(data);
+  while (len > 0) {
+    ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+    if (n <= 0) return false;
+    p += n;
+    len -= static_cast<size_t>(n);
+  }
+  return true;
+}
+
+void putU32(std::vector<uint8_t> &out, uint32_t v) {
+  for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void putU64(std::vector<uint8_t> &out, uint64_t v) {
+  for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+// Argument of "mach create name" / mach create "name"
+std::string machineArgument(const std::string &line, size_t prefixLength) {
+  std::string name = line.substr(prefixLength);
+  size_t begin = name.find_first_not_of(" \t\"");
+  size_t end = name.find_last_not_of(" \t\"\r");
+  return begin == std::string::npos ? std::string{} : name.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+FakeRenode::FakeRenode() {
+  m_controlFd = listen(m_controlPort);
+  m_monitorFd = listen(m_monitorPort);
+  m_threads.emplace_back([this] { accept(m_controlFd, false); });
+  m_threads.emplace_back([this] { accept(m_monitorFd, true); });
+}
+
+FakeRenode::~FakeRenode() {
+  m_stopping = true;
+  ::shutdown(m_controlFd, SHUT_RDWR);
+  ::shutdown(m_monitorFd, SHUT_RDWR);
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lk(m_mtx);
+    for (int fd : m_clients) ::shutdown(fd, SHUT_RDWR);
+    threads = std::move(m_threads);
+  }
+  // Acceptors see m_stopping under the lock, so no client joins after this
+  for (std::thread &t : threads) t.join();
+  for (int fd : m_clients) ::close(fd);
+  ::close(m_controlFd);
+  ::close(m_monitorFd);
+}
+
+void FakeRenode::reply(std::string prefix, std::string output) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  m_replies.emplace_back(std::move(prefix), std::move(output));
+}
+
+void FakeRenode::hangUp(std::string prefix, std::string partial) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  m_hangUps.emplace_back(std::move(prefix), std::move(partial));
+}
+
+void FakeRenode::stall(std::string prefix) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  m_stalls.push_back(std::move(prefix));
+}
+
+int FakeRenode::listen(uint16_t &port) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), len) != 0 || ::listen(fd, 8) != 0 ||
+      ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) != 0) {
+    throw std::runtime_error(std::string("FakeRenode: ") + std::strerror(errno));
+  }
+  port = ntohs(addr.sin_port);
+  return fd;
+}
+
+void FakeRenode::accept(int listenFd, bool monitor) {
+  while (!m_stopping) {
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return;
+    std::lock_guard<std::mutex> lk(m_mtx);
+    if (m_stopping) {
+      ::close(fd);
+      return;
+    }
+    m_clients.push_back(fd);
+    ++(monitor ? m_monitorConnections : m_controlConnections);
+    m_threads.emplace_back([this, fd, monitor] { monitor ? serveMonitor(fd) : serveControl(fd); });
+  }
+}
+
+void FakeRenode::serveControl(int fd) {
+  uint8_t count[2];
+  if (!readAll(fd, count, 2)) return;
+  std::vector<uint8_t> versions(2 * (count[0] | (count[1] << 8)));
+  if (!readAll(fd, versions.data(), versions.size())) return;
+  const uint8_t ok = 5;  // OK_HANDSHAKE
+  if (!writeAll(fd, &ok, 1)) return;
+
+  while (true) {
+    uint8_t header[7];
+    if (!readAll(fd, header, sizeof(header)) || header[0] != 'R' || header[1] != 'E') return;
+    uint8_t command = header[2];
+    uint32_t size = header[3] | (header[4] << 8) | (header[5] << 16) | (uint32_t(header[6]) << 24);
+    int available = 0;
+    if (size > 0 && ::ioctl(fd, FIONREAD, &available) == 0 && static_cast<uint32_t>(available) < size) {
+      ++m_splitFrames;
+    }
+    std::vector<uint8_t> payload(size);
+    if (size > 0 && !readAll(fd, payload.data(), size)) return;
+
+    std::vector<uint8_t> out;
+    std::lock_guard<std::mutex> lk(m_mtx);
+    switch (command) {
+    case 1: {  // RUN_FOR
+      uint64_t us = 0;
+      if (size >= 8) std::memcpy(&us, payload.data(), 8);
+      m_timeUs += us;
+      out = {4, command};
+      break;
+    }
+    case 2:  // GET_TIME
+      out = {3, command};
+      putU32(out, 8);
+      putU64(out, m_timeUs);
+      break;
+    case 3: {  // GET_MACHINE: u32 length, name
+      std::string name(payload.begin() + std::min<size_t>(4, size), payload.end());
+      auto it = m_machines.find(name);
+      int32_t id = it == m_machines.end() ? -1 : static_cast<int32_t>(std::distance(m_machines.begin(), it));
+      out = {3, command};
+      putU32(out, 4);
+      putU32(out, static_cast<uint32_t>(id));
+      break;
+    }
+    default: {
+      static const std::string message = "unsupported by FakeRenode";
+      out = {0, command};  // COMMAND_FAILED
+      putU32(out, static_cast<uint32_t>(message.size()));
+      out.insert(out.end(), message.begin(), message.end());
+    }
+    }
+    if (!writeAll(fd, out.data(), out.size())) return;
+  }
+}
+
+void FakeRenode::serveMonitor(int fd) {
+  std::string prompt = "(monitor) ";
+  if (!writeAll(fd, prompt.data(), prompt.size())) return;
+  std::string buffer;
+  char chunk[4096];
+  while (true) {
+    ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+    if (n <= 0) return;
+    buffer.append(chunk, static_cast<size_t>(n));
+    for (size_t eol; (eol = buffer.find('\n')) != std::string::npos;) {
+      std::string line = buffer.substr(0, eol);
+      buffer.erase(0, eol + 1);
+      while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+      if (auto action = special(line)) {
+        if (action->first) continue;  // stalled: wait for the next command or shutdown
+        std::string out = line + "\r\n" + action->second;
+        writeAll(fd, out.data(), out.size());
+        ::shutdown(fd, SHUT_RDWR);
+        return;
+      }
+      std::string out = line + "\r\n" + monitorCommand(line, prompt) + prompt;
+      if (!writeAll(fd, out.data(), out.size())) return;
+    }
+  }
+}
+
+// Scripted misbehaviour for line: {true, _} to stall, {false, partial} to hang up
+std::optional<std::pair<bool, std::string>> FakeRenode::special(const std::string &line) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  for (const std::string &prefix : m_stalls) {
+    if (line.compare(0, prefix.size(), prefix) == 0) return std::make_pair(true, std::string{});
+  }
+  for (const auto &[prefix, partial] : m_hangUps) {
+    if (line.compare(0, prefix.size(), prefix) == 0) return std::make_pair(false, partial);
+  }
+  return std::nullopt;
+}
+
+// Output of one monitor command; updates the prompt like Renode does
+std::string FakeRenode::monitorCommand(const std::string &line, std::string &prompt) {
+  std::lock_guard<std::mutex> lk(m_mtx);
+  for (const auto &[prefix, output] : m_replies) {
+    if (line.compare(0, prefix.size(), prefix) == 0) return output;
+  }
+  if (line.rfind("mach create", 0) == 0) {
+    std::string name = machineArgument(line, 11);
+    m_machines.insert(name);
+    prompt = "(" + name + ") ";
+  } else if (line.rfind("mach rem", 0) == 0) {
+    std::string name = machineArgument(line, 8);
+    m_machines.erase(name);
+    if (prompt == "(" + name + ") ") prompt = "(monitor) ";
+  } else if (line.rfind("mach set", 0) == 0) {
+    std::string name = machineArgument(line, 8);
+    if (!m_machines.count(name)) return "Could not find machine " + name + "\r\n";
+    prompt = "(" + name + ") ";
+  } else if (line == "mach clear") {
+    prompt = "(monitor) ";
+  } else if (line == "mach") {
+    std::string out = "Available machines:\r\n";
+    int i = 0;
+    for (const std::string &name : m_machines) out += "\t" + std::to_string(i++) + ": " + name + "\r\n";
+    return out;
+  }
+  return {};
+}
@@ -0,0 +1,67 @@
+// fakeRenode.hpp
+// In-process stand-in for a Renode instance, for tests: the external control
+// server (handshake, RUN_FOR, GET_TIME, GET_MACHINE) and the telnet monitor
+// ("mach create/rem/set/clear", echo and prompt) on ephemeral loopback ports.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class FakeRenode {
+public:
+  FakeRenode();
+  ~FakeRenode();
+  FakeRenode(const FakeRenode &) = delete;
+  FakeRenode &operator=(const FakeRenode &) = delete;
+
+  uint16_t controlPort() const { return m_controlPort; }
+  uint16_t monitorPort() const { return m_monitorPort; }
+
+  // Monitor output for commands starting with prefix (first match wins)
+  void reply(std::string prefix, std::string output);
+  // Close the monitor connection on a command starting with prefix, after
+  // echoing it and writing partial (no prompt follows)
+  void hangUp(std::string prefix, std::string partial = {});
+  // Never answer commands starting with prefix
+  void stall(std::string prefix);
+
+  // Control commands whose payload had not fully arrived together with
+  // their header, i.e. frames the client sent in more than one segment
+  int splitFrames() const { return m_splitFrames; }
+  // Connections accepted so far on each port
+  int monitorConnections() const { return m_monitorConnections; }
+  int controlConnections() const { return m_controlConnections; }
+
+private:
+  int listen(uint16_t &port);
+  void accept(int listenFd, bool monitor);
+  void serveControl(int fd);
+  void serveMonitor(int fd);
+  std::optional<std::pair<bool, std::string>> special(const std::string &line);
+  std::string monitorCommand(const std::string &line, std::string &prompt);
+
+  std::atomic<bool> m_stopping{false};
+  std::atomic<int> m_splitFrames{0};
+  std::atomic<int> m_monitorConnections{0};
+  std::atomic<int> m_controlConnections{0};
+  uint16_t m_controlPort = 0;
+  uint16_t m_monitorPort = 0;
+  int m_controlFd = -1;
+  int m_monitorFd = -1;
+
+  std::mutex m_mtx;  // guards everything below
+  std::vector<std::pair<std::string, std::string>> m_replies;
+  std::vector<std::pair<std::string, std::string>> m_hangUps;
+  std::vector<std::string> m_stalls;
+  std::set<std::string> m_machines;
+  uint64_t m_timeUs = 0;
+  std::vector<int> m_clients;
+  std::vector<std::thread> m_threads;
+};
@@ -0,0 +1,42 @@
+// launchProbeTest.cpp
+// RenodeProcess::launch against FakeRenode, with a stand-in executable that
+// only sleeps: the host is resolved by name ("localhost"), and the monitor
+// connection that probed readiness (and started the control server) is the
+// one the client ends up using.
+#include <sys/stat.h>
+
+#include <fstream>
+#include <string>
+
+#include "check.hpp"
+#include "fakeRenode.hpp"
+#include "renodeInterface.h"
+
+using namespace renode;
+
+int main(int argc, char **argv) {
+  CHECK(argc == 2);
+  const std::string stub = std::string(argv[1]) + "/renode-stub.sh";
+  std::ofstream(stub) << "#!/bin/sh\nexec sleep 30\n";
+  CHECK(chmod(stub.c_str(), 0755) == 0);
+
+  for (bool startServer : {false, true}) {
+    FakeRenode renode;
+    RenodeConfig config;
+    config.renode_path = stub;
+    config.host = "localhost";
+    config.port = renode.controlPort();
+    config.monitor_port = renode.monitorPort();
+    config.start_control_server = startServer;
+    config.startup_timeout_ms = 5000;
+
+    auto client = ExternalControlClient::launchAndConnect(config);
+    CHECK(client);
+    CHECK(client->performHandshake());
+    CHECK(client->connectMonitor(config.host, config.monitor_port));
+    CHECK(client->getMonitor() && !client->getMonitor()->execute("mach").error);
+    CHECK(renode.monitorConnections() == 1);
+    CHECK(renode.controlConnections() == 1);
+  }
+  return 0;
+}
@@ -0,0 +1,24 @@
+// monitorBatchTest.cpp
+// Pipelined monitor commands are split back at the prompts Renode prints
+// before echoing the next command, not at output lines that merely look
+// like the current prompt.
+#include "check.hpp"
+#include "fakeRenode.hpp"
+#include "renodeInterface.h"
+
+using namespace renode;
+
+int main() {
+  FakeRenode renode;
+  renode.reply("show", "(monitor) \r\nstill show output\r\n");
+  renode.reply("peripherals", "uart0\r\n");
+
+  auto monitor = Monitor::connect("127.0.0.1", renode.monitorPort());
+  auto batch = monitor->executeBatch({"show", "peripherals", "show"});
+  CHECK(batch.size() == 3);
+  for (const auto &result : batch) CHECK(!result.error);
+  CHECK(batch[0].value.find("still show output") != std::string::npos);
+  CHECK(batch[1].value == "uart0");
+  CHECK(batch[2].value.find("still show output") != std::string::npos);
+  return 0;
+}
@@ -0,0 +1,44 @@
+// monitorDisconnectTest.cpp
+// A monitor command whose connection dies before the prompt fails with
+// ERR_NOT_CONNECTED instead of returning the partial output as a response.
+#include <chrono>
+#include <thread>
+
+#include "check.hpp"
+#include "fakeRenode.hpp"
+#include "renodeInterface.h"
+
+using namespace renode;
+
+int main() {
+  FakeRenode renode;
+  renode.hangUp("crash", "half of a respo");
+  renode.stall("sleep");
+
+  auto monitor = Monitor::connect("127.0.0.1", renode.monitorPort());
+  CHECK(monitor);
+  CHECK(!monitor->execute("help").error);
+
+  auto lost = monitor->execute("crash");
+  CHECK(lost.error.code == ERR_NOT_CONNECTED);
+  CHECK(lost.value.empty());
+  CHECK(monitor->execute("help").error.code == ERR_NOT_CONNECTED);
+
+  // Batches report the same code
+  monitor = Monitor::connect("127.0.0.1", renode.monitorPort());
+  auto batch = monitor->executeBatch({"help", "crash"});
+  CHECK(batch.size() == 2 && batch[1].error.code == ERR_NOT_CONNECTED);
+
+  // interrupt() fails a command blocked on an unresponsive instance
+  monitor = Monitor::connect("127.0.0.1", renode.monitorPort());
+  std::thread interrupter([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    monitor->interrupt();
+  });
+  auto start = std::chrono::steady_clock::now();
+  auto stalled = monitor->execute("sleep");
+  interrupter.join();
+  CHECK(stalled.error.code == ERR_NOT_CONNECTED);
+  CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(2));
+  return 0;
+}